@@ -8,12 +8,29 @@ declare module 'baja-lite-xlsx' {
    * 图片数据对象（在单元格值中返回）
    */
   export interface ImageDataObject {
-    /** Image data as Buffer */
-    data: Buffer;
+    /** Image data as Buffer (null when the hash is in `knownHashes`) */
+    data: Buffer | null;
     /** Image filename */
     name: string;
-    /** MIME type (e.g., 'image/png', 'image/jpeg') */
+    /**
+     * MIME type identified from the image header bytes (e.g., 'image/png', 'image/jpeg').
+     * Falls back to the file extension for unrecognized formats.
+     * 根据图片文件头识别的 MIME 类型，无法识别时按扩展名判断
+     */
     type: string;
+    /** Width in pixels read from the image header (0 if unknown). 图片宽度（像素），未知时为 0 */
+    width: number;
+    /** Height in pixels read from the image header (0 if unknown). 图片高度（像素），未知时为 0 */
+    height: number;
+    /** XXH64 digest of the image bytes (16 hex digits), computed natively. 图片数据的 XXH64 哈希 */
+    hash: string;
+    /** SHA-256 digest (64 hex digits), only when `sha256: true`. 仅在开启 sha256 选项时返回 */
+    sha256?: string;
+    /**
+     * True when `hash` was listed in `knownHashes`; `data` is null in that case
+     * 哈希在 knownHashes 中时为 true，此时 data 为 null
+     */
+    known?: boolean;
   }
 
   /**
@@ -44,8 +61,318 @@ declare module 'baja-lite-xlsx' {
      * @example { '名称': 'name', '年龄': 'age' }
      */
     headerMap?: Record<string, string>;
+
+    /**
+     * Also compute a SHA-256 digest for every image (XXH64 is always computed). Default: false
+     * 是否为每张图片额外计算 SHA-256（XXH64 始终计算），默认 false
+     */
+    sha256?: boolean;
+
+    /**
+     * XXH64 digests of images the caller already has; matching images are returned without bytes
+     * 调用方已有图片的 XXH64 哈希，命中的图片不返回数据，可用于去重存储
+     */
+    knownHashes?: string[];
+
+    /**
+     * Resource limits; the read fails with "Read limit exceeded: ..." as soon as one is hit
+     * 资源限制，超出任一限制时立即失败，用于拒绝解压炸弹等恶意文件
+     */
+    limits?: ReadLimits;
+
+    /**
+     * Read cell values only, skipping styles, themes, comments and other metadata. Default: false
+     * 仅读取单元格值，跳过样式、主题、批注等元数据，速度更快、内存更少，默认 false
+     */
+    valuesOnly?: boolean;
+
+    /**
+     * Threads used to parse one large sheet in values-only mode; the sheet XML is cut at
+     * row boundaries and the pieces parsed concurrently. 0 = one per core, 1 = no splitting. Default: 0
+     * valuesOnly 模式下解析单个大 Sheet 的线程数（按行切分并行解析），0 表示按 CPU 核数，默认 0
+     */
+    parseThreads?: number;
+
+    /**
+     * How date-formatted cells are returned: Excel serial number text, or ISO 8601 ("2024-01-31",
+     * "2024-01-31T08:30:00", "08:30:00"). Default: 'serial'
+     * 日期单元格的输出格式：'serial' 为序列号，'iso' 为 ISO 8601 字符串，默认 'serial'
+     */
+    dates?: 'serial' | 'iso';
+
+    /**
+     * Row filter evaluated natively while decoding; rows that fail it never become JS values.
+     * All conditions must hold. The header row is always kept and skipRows still refers to file rows.
+     * 行过滤条件，在原生层执行，被过滤的行不会创建 JS 对象；所有条件需同时满足
+     */
+    filter?: RowFilterCondition[];
+
+    /**
+     * Directory for the parse cache. Entries are keyed by a hash of the file content plus the
+     * options that change the parsed result; a hit skips inflating and parsing entirely.
+     * filter and knownHashes apply after loading, so they share entries.
+     * 解析缓存目录，以文件内容哈希为键；命中时跳过解压和 XML 解析
+     */
+    cacheDir?: string;
+
+    /**
+     * Sample this many rows below the header to infer each column's type; every row is then
+     * decoded with one routine per column, falling back per cell when a value does not fit.
+     * The result array then carries a non-enumerable `schema`.
+     * 取表头下方 N 行推断列类型，之后按列专用解码；结果数组附加不可枚举的 schema 属性
+     */
+    schemaRows?: number;
   }
 
+  /**
+   * Inferred type of a column; 'date' is only told apart from 'number' with `dates: 'iso'`
+   * 推断的列类型
+   */
+  export type ColumnType = 'empty' | 'number' | 'date' | 'boolean' | 'string' | 'formula' | 'mixed';
+
+  export interface ColumnSchema {
+    type: ColumnType;
+    /** Non-empty cells the type was inferred from */
+    samples: number;
+    /** Cells below the header that did not fit the column decoder */
+    fallbacks: number;
+  }
+
+  /**
+   * Rows of readTableAsJSON; `schema` is present (non-enumerable) when `schemaRows` was given
+   * readTableAsJSON 的结果，使用 schemaRows 时带有 schema
+   */
+  export type TableRows = Array<Record<string, string | ImageDataObject>> & {
+    readonly schema?: Array<ColumnSchema & { key: string }>;
+    /** Anchors of the sheet that was read (non-enumerable) */
+    readonly imagePositions: ImagePosition[];
+    /**
+     * Anchors overlapping a block of file rows / columns, in imagePositions order;
+     * same index as PackedWorkbook.imagesInRange, built on first use
+     * 与单元格范围重叠的图片位置（原表行号），首次调用时建立区间索引
+     */
+    imagesInRange(range: { firstRow: number; lastRow?: number; firstCol?: number; lastCol?: number }): ImagePosition[];
+    /** Cells an anchor covers; a `to` edge with zero offset does not count */
+    imageCells(position: ImagePosition): CellRange;
+  };
+
+  /**
+   * One filter entry; every key present besides `column` adds a condition.
+   * An entry with an unknown key, an invalid column or value, or no condition throws a TypeError
+   * 过滤条件：除 column 外每个出现的键都是一个条件；键名、列或值不合法以及没有条件时抛出 TypeError
+   */
+  export interface RowFilterCondition {
+    /** Header name (as in the file, or its headerMap name) or 0-based column index */
+    column: string | number;
+    /** Cell equals the value; numbers compare numerically */
+    eq?: string | number | boolean;
+    /** Cell equals one of the values */
+    in?: Array<string | number | boolean>;
+    /** Inclusive lower bound; numbers compare numerically, strings as text (e.g. ISO dates) */
+    min?: string | number;
+    /** Inclusive upper bound */
+    max?: string | number;
+    /** Cell is not empty */
+    nonEmpty?: boolean;
+  }
+
+  /**
+   * Limits checked while reading. Omitted or 0 means unlimited.
+   * 读取限制，不传或为 0 表示不限制
+   *
+   * Archive sizes are checked against the ZIP central directory before anything is
+   * inflated; the cell count is checked before each sheet's grid is allocated.
+   */
+  export interface ReadLimits {
+    /** Total uncompressed size of all entries (bytes) / 解压后总大小 */
+    maxUncompressedSize?: number;
+    /** Uncompressed size of any single entry (bytes) / 单个文件解压后大小 */
+    maxEntrySize?: number;
+    /** Uncompressed / compressed ratio of any entry of 1 MB or more / 压缩比 */
+    maxCompressionRatio?: number;
+    /** Cells (rows x columns of the used range) across all sheets / 单元格总数 */
+    maxCells?: number;
+    /** Number of media files / 图片数量 */
+    maxImages?: number;
+  }
+
+
+  /**
+   * Options for readMany
+   */
+  export interface ReadManyOptions extends ReadTableOptions {
+    /**
+     * Number of native worker threads. Default: number of CPU cores
+     * 原生工作线程数，默认为 CPU 核数
+     */
+    concurrency?: number;
+
+    /**
+     * Called as each file completes (completion order). When set, readMany returns a Promise
+     * 每个文件完成时调用（按完成顺序）。传入后 readMany 返回 Promise
+     */
+    onResult?: (error: Error | null, data: Array<Record<string, string | ImageDataObject>> | null, index: number) => void;
+
+    /**
+     * Stops handing out files and aborts the reads in progress; those report an AbortError
+     * 取消信号：停止分配新文件，正在读取的文件以 AbortError 返回
+     */
+    signal?: AbortSignal;
+  }
+
+  /**
+   * Progress reported by readTableAsJSONAsync()
+   * readTableAsJSONAsync() 的进度信息
+   */
+  export interface ReadProgress {
+    /** 'load': parsing the package, 'sheets': converting rows, 'images': inflating media */
+    phase: 'load' | 'sheets' | 'images';
+    /** Package bytes consumed while loading */
+    bytesRead: number;
+    sheetsDone: number;
+    sheetCount: number;
+    /** Rows converted across all sheets */
+    rowsDone: number;
+    /** Media bytes inflated */
+    bytesInflated: number;
+  }
+
+  /**
+   * Options for readTableAsJSONAsync
+   */
+  export interface ReadTableAsyncOptions extends ReadTableOptions {
+    /**
+     * Cancels the read within milliseconds; the promise rejects with an AbortError
+     * 取消信号，取消后 Promise 以 AbortError 拒绝，原生内存立即释放
+     */
+    signal?: AbortSignal;
+
+    /**
+     * Progress callback, called at most every 100 ms
+     * 进度回调，最多每 100ms 调用一次
+     */
+    onProgress?: (progress: ReadProgress) => void;
+  }
+
+  /**
+   * One file result yielded by readMany
+   * readMany 返回的单个文件结果
+   */
+  export interface ReadManyResult {
+    /** Position of the file in the inputs array */
+    index: number;
+    /** The original input */
+    input: string | Buffer;
+    /** Rows, as returned by readTableAsJSON (null on error) */
+    data: TableRows | null;
+    /** Error for this file, if any. Other files are not affected */
+    error: Error | null;
+  }
+
+  /**
+   * Sheet summary returned by probe()
+   * probe() 返回的 Sheet 概要
+   */
+  export interface SheetProbe {
+    /** Sheet name */
+    name: string;
+    /** Visibility: 'visible' | 'hidden' | 'veryHidden' */
+    state: 'visible' | 'hidden' | 'veryHidden';
+    /** Declared used range (<dimension ref>), e.g. 'A1:D120'. Empty if not declared */
+    dimension: string;
+    /** Rows the dimension spans, last - first + 1 ('C5:F9' gives 5; 0 if unknown) */
+    rowCount: number;
+    /** Columns the dimension spans ('C5:F9' gives 4; 0 if unknown) */
+    columnCount: number;
+    /** Number of pictures in the sheet's drawings */
+    imageCount: number;
+    /** Worksheet part size inside the ZIP (bytes) */
+    compressedSize: number;
+    /** Worksheet part size once inflated (bytes) */
+    uncompressedSize: number;
+  }
+
+  /**
+   * Workbook summary returned by probe()
+   * probe() 返回的工作簿概要
+   */
+  export interface WorkbookProbe {
+    /** Sheets in workbook order */
+    sheets: SheetProbe[];
+    /** Number of media files (xl/media/*) */
+    imageCount: number;
+    /** Number of WPS Excel cell images (DISPIMG) */
+    cellImageCount: number;
+    /** Number of ZIP entries */
+    entryCount: number;
+    /** Total compressed size of all entries (bytes) */
+    compressedSize: number;
+    /** Total uncompressed size of all entries, as declared by the archive (bytes) */
+    uncompressedSize: number;
+    /** Total uncompressed size of media files (bytes) */
+    mediaSize: number;
+  }
+
+  /**
+   * Options for toCSV() / toNDJSON()
+   * toCSV() / toNDJSON() 的配置选项
+   */
+  export interface ExportTableOptions extends ReadTableOptions {
+    /**
+     * How image cells are written: 'ref' writes the image name (CSV) or the image
+     * object without data (NDJSON); 'base64' writes a data: URI (CSV) or adds a
+     * base64 `data` field (NDJSON)
+     * @default 'ref'
+     */
+    images?: 'ref' | 'base64';
+    /** Write to this file descriptor instead of returning a Buffer */
+    fd?: number;
+  }
+
+  export interface ExportCsvOptions extends ExportTableOptions {
+    /** Single-character field delimiter @default ',' */
+    delimiter?: string;
+    /** Write the header line @default true */
+    header?: boolean;
+  }
+
+  /**
+   * A cell value accepted by XlsxWriter.writeRow()
+   * writeRow() 接受的单元格值：字符串、数字、布尔值、空值，或图片（Buffer / { data: Buffer }）
+   */
+  export type WriteCellValue = string | number | boolean | null | undefined | Buffer | { data: Buffer };
+
+  /**
+   * Picture placement for XlsxWriter.addImage(), 0-based cell coordinates
+   * 图片位置（从0开始的单元格坐标），不传 toCol/toRow 时图片占满起始单元格
+   */
+  export interface WriteImageAnchor {
+    col: number;
+    row: number;
+    /** Bottom-right cell (exclusive). Defaults to col + 1 */
+    toCol?: number;
+    /** Bottom-right cell (exclusive). Defaults to row + 1 */
+    toRow?: number;
+  }
+
+  /**
+   * Streaming XLSX writer returned by createWriter()
+   * createWriter() 返回的流式写入器
+   */
+  export interface XlsxWriter {
+    /** Start a new sheet; rows written before the first addSheet() go to "Sheet1" */
+    addSheet(name: string): void;
+    /**
+     * Append one row to the current sheet. Image values are placed in their cell.
+     * Throws (and writes nothing) for NaN / Infinity, more than 16384 cells, or a
+     * sheet that already has 1048576 rows
+     */
+    writeRow(values: WriteCellValue[]): void;
+    /** Place a picture (PNG, JPEG, GIF, BMP, WebP, EMF, WMF) on the current sheet */
+    addImage(image: Buffer, anchor: WriteImageAnchor): void;
+    /** Write the .xlsx file and release temporary files */
+    close(): void;
+  }
 
   /**
    * Read Excel table and return as JSON array
@@ -58,7 +385,7 @@ declare module 'baja-lite-xlsx' {
    * - Embedded images (WPS Excel): Images using DISPIMG formula with cellimages.xml
    * 
    * All image types are automatically converted to the same object format:
-   * { data: Buffer, name: string, type: string }
+   * { data: Buffer, name: string, type: string, width: number, height: number }
    * 
    * 图片会自动处理并附加到对应的单元格。支持标准 Excel 和 WPS Excel 格式：
    * - 浮动图片：跨越多个单元格的图片（twoCellAnchor）
@@ -66,7 +393,7 @@ declare module 'baja-lite-xlsx' {
    * - 嵌入式图片（WPS Excel）：使用 DISPIMG 公式和 cellimages.xml
    * 
    * 所有图片类型都会自动转换为统一的对象格式：
-   * { data: Buffer, name: string, type: string }
+   * { data: Buffer, name: string, type: string, width: number, height: number }
    * 
    * @param input - Excel file path (string), Buffer, or base64 string
    * @param options - Configuration options
@@ -124,6 +451,372 @@ declare module 'baja-lite-xlsx' {
   export function readTableAsJSON(
     input: string | Buffer,
     options?: ReadTableOptions
-  ): Array<Record<string, string | ImageDataObject>>;
+  ): TableRows;
+
+  /**
+   * Read Excel table as JSON on a native thread, with progress and cancellation
+   * 在原生线程中异步读取Excel表格，支持进度回调和取消
+   *
+   * @example
+   * ```javascript
+   * const controller = new AbortController();
+   * req.on('close', () => controller.abort());
+   *
+   * const rows = await readTableAsJSONAsync(file, {
+   *   signal: controller.signal,
+   *   onProgress: p => console.log(p.phase, p.rowsDone)
+   * });
+   * ```
+   */
+  export function readTableAsJSONAsync(
+    input: string | Buffer,
+    options?: ReadTableAsyncOptions
+  ): Promise<TableRows>;
+
+  /**
+   * Read many workbooks on a native worker pool
+   * 在原生线程池中批量读取多个 Excel 文件
+   *
+   * Files are inflated and parsed on native threads while results of finished
+   * files are converted on the JS thread, so all cores stay busy without one
+   * Node worker per file. Results are delivered in completion order.
+   *
+   * 文件在原生线程中解压和解析，已完成文件的结果在 JS 线程中转换，
+   * 无需为每个文件创建 Node worker 即可利用所有 CPU 核。结果按完成顺序返回。
+   *
+   * As an async iterator, native threads stop picking up new files while 16
+   * results are waiting to be consumed; `break` / `throw` in `for await`
+   * cancels the remaining files.
+   *
+   * 异步迭代器模式下，未消费的结果达到 16 个时原生线程暂停领取新文件；
+   * 在 `for await` 中 `break` / `throw` 会取消剩余文件。
+   *
+   * @param inputs - File paths, Buffers, or base64 strings
+   * @param options - readTableAsJSON options plus concurrency / onResult
+   *
+   * @example
+   * ```javascript
+   * const { readMany } = require('baja-lite-xlsx');
+   *
+   * for await (const { index, data, error } of readMany(files, { concurrency: 8 })) {
+   *   if (error) console.error(files[index], error.message);
+   *   else await save(data);
+   * }
+   * ```
+   */
+  export function readMany(
+    inputs: Array<string | Buffer>,
+    options?: Omit<ReadManyOptions, 'onResult'>
+  ): AsyncIterableIterator<ReadManyResult>;
+  export function readMany(
+    inputs: Array<string | Buffer>,
+    options: ReadManyOptions & { onResult: NonNullable<ReadManyOptions['onResult']> }
+  ): Promise<void>;
+
+  /**
+   * Probe a workbook without reading any cell data
+   * 快速探测工作簿，不读取单元格数据
+   *
+   * Only the ZIP central directory, workbook.xml, relationship parts and each
+   * worksheet up to <sheetData> are read, so this returns in milliseconds even
+   * for very large files. Use it to reject or route oversized uploads early.
+   *
+   * 只读取 ZIP 目录、workbook.xml、关系文件以及每个 Sheet 的头部，
+   * 即使是非常大的文件也能在毫秒级返回，可用于提前拒绝或分流过大的上传文件。
+   *
+   * @param input - Excel file path (string), Buffer, or base64 string
+   * @returns Workbook summary
+   *
+   * @example
+   * ```javascript
+   * const { probe } = require('baja-lite-xlsx');
+   *
+   * const info = probe('./upload.xlsx');
+   * // {
+   * //   sheets: [{ name: 'Sheet1', state: 'visible', dimension: 'A1:D120',
+   * //              rowCount: 120, columnCount: 4, imageCount: 3, ... }],
+   * //   imageCount: 3, uncompressedSize: 183204, ...
+   * // }
+   * ```
+   */
+  export function probe(input: string | Buffer): WorkbookProbe;
+
+  /**
+   * Export one sheet as CSV, serialized natively without creating JS row objects
+   * 将 Sheet 直接导出为 CSV（原生序列化，不创建 JS 行对象）
+   *
+   * Row and column selection matches readTableAsJSON (headerRow, skipRows, headerMap).
+   *
+   * @returns The CSV bytes, or the number of bytes written when `fd` is given
+   */
+  export function toCSV(input: string | Buffer, options: ExportCsvOptions & { fd: number }): number;
+  export function toCSV(input: string | Buffer, options?: ExportCsvOptions): Buffer;
+
+  /**
+   * Export one sheet as NDJSON, one object per line as readTableAsJSON would return it
+   * 将 Sheet 直接导出为 NDJSON，每行一个对象，内容与 readTableAsJSON 一致
+   *
+   * @returns The NDJSON bytes, or the number of bytes written when `fd` is given
+   */
+  export function toNDJSON(input: string | Buffer, options: ExportTableOptions & { fd: number }): number;
+  export function toNDJSON(input: string | Buffer, options?: ExportTableOptions): Buffer;
+
+  /**
+   * Create a streaming XLSX writer
+   * 创建流式 XLSX 写入器
+   *
+   * Rows are serialized to temporary files as they are written and compressed
+   * into the output on close(), so memory stays flat regardless of row count.
+   * Strings are stored in the shared string table; images are written as
+   * drawings that readTableAsJSON() attaches back to their cells.
+   *
+   * 行数据边写边落盘到临时文件，close() 时再压缩进输出文件，内存占用与行数无关。
+   * 图片以 drawing 形式写入，readTableAsJSON() 读取时会还原到对应单元格。
+   *
+   * @param filepath - Output .xlsx path
+   *
+   * @example
+   * ```javascript
+   * const { createWriter } = require('baja-lite-xlsx');
+   *
+   * const writer = createWriter('./out.xlsx');
+   * writer.addSheet('Users');
+   * writer.writeRow(['name', 'age', 'photo']);
+   * writer.writeRow(['张三', 25, fs.readFileSync('./a.png')]);
+   * writer.close();
+   * ```
+   */
+  export function createWriter(filepath: string): XlsxWriter;
+
+  /**
+   * Workbook handle returned by openWorkbook()
+   * openWorkbook() 返回的工作簿句柄
+   */
+  export interface WorkbookHandle {
+    /** Sheet names in workbook order */
+    sheetNames(): string[];
+    /** Highest row and column of a sheet (first sheet when omitted); builds the sheet's row index */
+    sheetSize(sheetName?: string | null): { rows: number; columns: number };
+    /**
+     * Rows [start, start + count) as arrays of cell text, 0-based like `headerRow`.
+     * Rows are padded to the sheet width; fewer rows are returned past the end.
+     */
+    readRows(sheetName: string | null, start: number, count: number): string[][];
+    /** Release the package, the row indexes and their temporary files */
+    close(): void;
+  }
+
+  /**
+   * Open a workbook for paging through large sheets.
+   *
+   * The first access to a sheet inflates it once, spools its XML to a temporary
+   * file and records the offset of every row; readRows() then seeks straight to
+   * the requested rows instead of decoding the sheet from the top. Values only
+   * (like `valuesOnly: true`); images are not returned.
+   *
+   * 打开工作簿用于分页读取大表：首次访问 Sheet 时建立行偏移索引，之后按行号直接定位读取。
+   *
+   * @param input - File path, Buffer, or base64 string
+   * @param options - `dates` and `limits` apply
+   *
+   * @example
+   * ```javascript
+   * const wb = openWorkbook('./big.xlsx');
+   * const page = wb.readRows('Sheet1', 200000, 100);
+   * wb.close();
+   * ```
+   */
+  export function openWorkbook(
+    input: string | Buffer,
+    options?: Pick<ReadTableOptions, 'dates' | 'limits'>
+  ): WorkbookHandle;
+
+  /**
+   * Read a workbook and pack the whole result (cell text, image bytes, anchors)
+   * into one ArrayBuffer.
+   *
+   * Meant for parsing in a worker thread: transfer the buffer with
+   * `postMessage(buffer, [buffer])` and wrap it in a PackedWorkbook on the other
+   * side, instead of structured-cloning nested arrays cell by cell.
+   *
+   * 读取并将完整结果打包为一个 ArrayBuffer，可在线程间零拷贝转移，用 PackedWorkbook 读取。
+   *
+   * @example
+   * ```javascript
+   * // worker
+   * const buffer = readPacked(file, { valuesOnly: true });
+   * parentPort.postMessage(buffer, [buffer]);
+   * // main thread
+   * const sheet = new PackedWorkbook(buffer).sheet();
+   * const firstRow = sheet.row(0);
+   * ```
+   */
+  export function readPacked(input: string | Buffer, options?: ReadTableOptions): ArrayBuffer;
+
+  /**
+   * Image anchor as returned by readExcel / PackedWorkbook, 0-based
+   * 图片锚点（行列号从0开始）
+   */
+  export interface ImagePosition {
+    image: string;
+    sheet: string;
+    /** colOff / rowOff: offset into the cell in EMU (914400 per inch) */
+    from: { col: number; row: number; colOff: number; rowOff: number };
+    to: { col: number; row: number; colOff: number; rowOff: number };
+  }
+
+  export type PackedImagePosition = ImagePosition;
+
+  /**
+   * Inclusive, 0-based block of cells
+   * 单元格范围（从0开始，包含两端）
+   */
+  export interface CellRange {
+    firstRow: number;
+    lastRow: number;
+    firstCol: number;
+    lastCol: number;
+  }
+
+  /**
+   * One sheet of a PackedWorkbook; cell text is decoded on access
+   * PackedWorkbook 中的一个 Sheet，单元格文本在访问时解码
+   */
+  export interface PackedSheet {
+    readonly name: string;
+    readonly rowCount: number;
+    readonly columnCount: number;
+    /** File row of each row when a `filter` was applied, otherwise null */
+    readonly rowIndex: number[] | null;
+    /** Inferred column types when `schemaRows` was given, otherwise null */
+    readonly schema: ColumnSchema[] | null;
+    /** Cell text ('' outside the sheet); image cells hold an `__IMAGE_CELL__` marker */
+    cell(row: number, col: number): string;
+    /** One row, padded to columnCount */
+    row(row: number): string[];
+    /** File row of a row */
+    originalRow(row: number): number;
+    /** Image embedded in a cell, matched like readTableAsJSON does; null for other cells */
+    image(row: number, col: number): ImageDataObject | null;
+  }
+
+  /**
+   * Read-only view over a readPacked() buffer. Nothing is copied: image `data`
+   * are Buffer views into the same memory.
+   * readPacked() 结果的只读视图，不复制数据
+   */
+  export class PackedWorkbook {
+    constructor(buffer: ArrayBuffer | SharedArrayBuffer | Uint8Array);
+    /** The buffer the view was built on, e.g. to transfer it again */
+    readonly buffer: ArrayBuffer | SharedArrayBuffer | Uint8Array;
+    readonly sheets: PackedSheet[];
+    readonly images: ImageDataObject[];
+    readonly imagePositions: PackedImagePosition[];
+    readonly cellImageMappings: Array<{ imageId: string; imageName: string }>;
+    sheetNames(): string[];
+    /** Sheet by name, or the first sheet when omitted */
+    sheet(sheetName?: string | null): PackedSheet;
+    /**
+     * Anchors overlapping a block of file rows / columns, in imagePositions order.
+     * Backed by a per-sheet interval index built on first use.
+     * 与单元格范围重叠的图片位置（原表行号），首次调用时建立区间索引
+     */
+    imagesInRange(
+      sheetName: string,
+      range: { firstRow: number; lastRow?: number; firstCol?: number; lastCol?: number }
+    ): PackedImagePosition[];
+    /**
+     * Cells an anchor covers; a `to` edge with zero offset does not count
+     * 图片锚点覆盖的单元格范围
+     */
+    imageCells(position: PackedImagePosition): CellRange;
+  }
+
+  /**
+   * Native memory held by the addon, in bytes
+   * 扩展模块持有的原生内存（字节）
+   */
+  export interface NativeMemoryUsage {
+    /** Bytes currently held: read arenas, image payloads, export buffers, writer state */
+    current: number;
+    /** Highest value of `current` seen in this process */
+    peak: number;
+    /** Bytes currently reported to V8 as external memory */
+    external: number;
+  }
+
+  /**
+   * Live gauge of native memory held by the addon.
+   *
+   * Read results, export Buffers and writer state live outside the V8 heap; the
+   * addon reports them to V8 as external memory so GC scheduling sees them, and
+   * this gauge shows how much is held right now.
+   *
+   * 原生内存用量。读取结果、导出 Buffer、写入器状态不在 V8 堆中，
+   * 扩展会将其作为 external memory 报告给 V8，此函数返回当前用量。
+   *
+   * @example
+   * ```javascript
+   * const { current, peak } = nativeMemoryUsage();
+   * ```
+   */
+  export function nativeMemoryUsage(): NativeMemoryUsage;
+
+  /**
+   * Process-wide read budget; 0 = unlimited (the default)
+   * 进程级读取预算，0 表示不限制（默认）
+   */
+  export interface ReadSchedulerOptions {
+    /** Reads parsing at the same time */
+    maxConcurrent?: number;
+    /**
+     * Upper bound for the summed memory estimates of running reads, in bytes. A read is
+     * estimated from the uncompressed package size (about 4x, 2x with valuesOnly).
+     */
+    memoryBudget?: number;
+  }
+
+  /**
+   * Scheduler state and counters since process start
+   * 调度器状态与累计计数
+   */
+  export interface ReadSchedulerStats {
+    maxConcurrent: number;
+    memoryBudget: number;
+    /** Reads parsing now */
+    running: number;
+    /** Reads waiting for admission */
+    queued: number;
+    /** Memory estimates of the running reads */
+    reservedBytes: number;
+    /** Reads started */
+    admitted: number;
+    /** Reads that had to wait before starting */
+    waited: number;
+    totalWaitMs: number;
+    maxWaitMs: number;
+    peakQueued: number;
+  }
+
+  /**
+   * Configure the process-wide read scheduler.
+   *
+   * Every read (sync, async, readMany, readPacked) is admitted against the budget
+   * before parsing; the rest wait in arrival order, so a burst of uploads turns into a
+   * queue instead of one combined memory peak. A read whose estimate alone exceeds the
+   * budget runs once nothing else is running. Queued async reads can be aborted.
+   * Synchronous reads block their thread while queued.
+   *
+   * 配置进程级读取调度器：超出预算的读取按到达顺序排队，避免突发请求同时展开导致内存峰值。
+   *
+   * @returns The resulting state. Omitted keys keep their current value.
+   */
+  export function configureReadScheduler(options: ReadSchedulerOptions): ReadSchedulerStats;
+
+  /**
+   * Queue depth, wait times and reservations of the read scheduler
+   * 读取调度器的排队深度、等待时间与内存预留
+   */
+  export function readSchedulerStats(): ReadSchedulerStats;
 
 }
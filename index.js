@@ -99,7 +99,28 @@ function prepareFilePath(input) {
  * @param {number} [options.headerRow=0] - 表头所在行索引（从0开始）
  * @param {number[]} [options.skipRows=[]] - 需要跳过的行索引数组
  * @param {Object<string, string>} [options.headerMap={}] - 表头映射，将原表头映射为新的属性名
- * @returns {Array<Object>} JSON数组，每个元素代表一行数据
+ * @param {boolean} [options.sha256=false] - 是否为每张图片额外计算 SHA-256（XXH64 哈希始终计算）
+ * @param {string[]} [options.knownHashes=[]] - 已知图片的 XXH64 哈希，命中的图片不返回数据（data 为 null，known 为 true）
+ * @param {Object} [options.limits] - 资源限制（0 或不传表示不限制），超出时立即抛出 "Read limit exceeded" 错误：
+ *   maxUncompressedSize（解压后总字节数）、maxEntrySize（单个文件解压后字节数）、
+ *   maxCompressionRatio（单个文件压缩比）、maxCells（单元格总数）、maxImages（图片数量）
+ * @param {boolean} [options.valuesOnly=false] - 仅读取单元格值：跳过样式、主题、批注等元数据，直接解析工作表 XML，速度更快、内存更少
+ * @param {number} [options.parseThreads=0] - valuesOnly 模式下解析单个大 Sheet 的线程数（按行切分并行解析），0 表示按 CPU 核数，1 表示不并行
+ * @param {Array<Object>} [options.filter] - 行过滤条件，在原生层解析时执行，被过滤的行不会创建任何 JS 对象。
+ *   每项为 { column, eq?, in?, min?, max?, nonEmpty? }，所有条件需同时满足：
+ *   column 为表头名称（原表头或 headerMap 映射后的名称）或从0开始的列索引；
+ *   eq 等于、in 属于集合、min/max 闭区间（数字按数值比较，字符串按文本比较，可配合 dates: 'iso' 筛选日期）、nonEmpty 非空。
+ *   条件写错（未知的键、列或值不合法、没有任何条件）时抛出 TypeError，而不是忽略该条件
+ * @param {'serial'|'iso'} [options.dates='serial'] - 日期单元格的输出格式：'serial' 为 Excel 序列号，'iso' 为 ISO 8601 字符串（如 "2024-01-31"）
+ * @param {string} [options.cacheDir] - 解析缓存目录：以文件内容哈希和影响解析结果的选项为键保存解析结果，
+ *   再次读取相同内容的文件时直接加载缓存，跳过解压和 XML 解析；filter 与 knownHashes 在加载后执行，共享同一缓存
+ * @param {number} [options.schemaRows=0] - 列类型推断：取表头下方的前 N 行推断每列类型（number、date、boolean、string、formula、mixed），
+ *   所有行按列使用专用解码，不再逐个单元格判断类型，不符合的单元格回退到通用解码（表头之下的回退计入 fallbacks）。
+ *   结果数组上会附加不可枚举的 schema 属性：[{ key, type, samples, fallbacks }]，fallbacks 为回退解码的单元格数。
+ *   date 仅在 dates: 'iso' 时与 number 区分
+ * @returns {Array<Object>} JSON数组，每个元素代表一行数据。数组上另有不可枚举的属性：
+ *   imagePositions（目标 Sheet 的图片位置）、imagesInRange(range)（按原表行列号查询与范围重叠的图片，
+ *   首次调用时建立区间索引，与 PackedWorkbook.imagesInRange 相同）、imageCells(position)（图片覆盖的单元格范围）
  * 
  * @example
  * // 使用文件路径
@@ -113,6 +134,15 @@ function prepareFilePath(input) {
  *   }
  * });
  * 
+ * // 只保留状态为"启用"且日期在一月内的行
+ * const active = readTableAsJSON('./sample.xlsx', {
+ *   dates: 'iso',
+ *   filter: [
+ *     { column: '状态', eq: '启用' },
+ *     { column: '日期', min: '2024-01-01', max: '2024-01-31' }
+ *   ]
+ * });
+ * 
  * // 使用 Buffer
  * const buffer = fs.readFileSync('./sample.xlsx');
  * const data2 = readTableAsJSON(buffer, { headerRow: 0 });
@@ -129,16 +159,30 @@ function readTableAsJSON(input, options = {}) {
   const { filepath, cleanup } = prepareFilePath(input);
   
   try {
-    // 默认选项
-    const {
-      sheetName = null,
-      headerRow = 0,
-      skipRows = [],
-      headerMap = {}
-    } = options;
-    
     // 读取Excel数据
-    const excelData = addon.readExcel(filepath);
+    const excelData = addon.readExcel(filepath, options);
+    
+    return excelDataToTable(excelData, options);
+  } finally {
+    cleanup();
+  }
+}
+
+/**
+ * 将 addon.readExcel 的结果按 readTableAsJSON 的选项转换为 JSON 数组
+ * @param {Object} excelData - addon.readExcel 返回的数据
+ * @param {Object} options - 与 readTableAsJSON 相同的配置选项
+ * @returns {Array<Object>} JSON数组
+ * @private
+ */
+function excelDataToTable(excelData, options = {}) {
+  // 默认选项
+  const {
+    sheetName = null,
+    headerRow = 0,
+    skipRows = [],
+    headerMap = {}
+  } = options;
   
   // 选择目标Sheet
   let targetSheet;
@@ -156,13 +200,17 @@ function readTableAsJSON(input, options = {}) {
   
   const sheetData = targetSheet.data;
   
+  // 使用 filter 时被过滤掉的行不会返回，rowIndex 为每行在原表中的行号
+  const rowIndex = targetSheet.rowIndex;
+  const headerPos = rowIndex ? rowIndex.indexOf(headerRow) : headerRow;
+  
   // 检查数据是否足够
-  if (sheetData.length <= headerRow) {
+  if (headerPos < 0 || sheetData.length <= headerPos) {
     throw new Error(`表头行索引 ${headerRow} 超出数据范围（共 ${sheetData.length} 行）`);
   }
   
   // 获取表头
-  const headers = sheetData[headerRow];
+  const headers = sheetData[headerPos];
   
   // 应用表头映射
   const mappedHeaders = headers.map(header => {
@@ -175,13 +223,13 @@ function readTableAsJSON(input, options = {}) {
   // 构建JSON数组
   const result = [];
   
-  for (let rowIndex = 0; rowIndex < sheetData.length; rowIndex++) {
-    // 跳过指定的行
-    if (skipRowsSet.has(rowIndex)) {
+  for (let i = 0; i < sheetData.length; i++) {
+    // 跳过指定的行（按原表行号）
+    if (skipRowsSet.has(rowIndex ? rowIndex[i] : i)) {
       continue;
     }
     
-    const row = sheetData[rowIndex];
+    const row = sheetData[i];
     const rowObj = {};
     
     // 填充数据
@@ -199,13 +247,808 @@ function readTableAsJSON(input, options = {}) {
     result.push(rowObj);
   }
   
+  // 列类型推断结果，按输出的属性名对应；不可枚举，不影响遍历和 JSON.stringify
+  if (targetSheet.schema) {
+    const schema = [];
+    mappedHeaders.forEach((key, colIndex) => {
+      const column = targetSheet.schema[colIndex];
+      if (key && column) {
+        schema.push({ key, type: column.type, samples: column.samples, fallbacks: column.fallbacks });
+      }
+    });
+    Object.defineProperty(result, 'schema', { value: schema, enumerable: false });
+  }
+  
+  // 目标 Sheet 的图片位置及区间查询（与 PackedWorkbook 相同），同样不可枚举
+  const sheetPositions = (excelData.imagePositions || []).filter(position => position.sheet === targetSheet.name);
+  let anchors = null;
+  Object.defineProperties(result, {
+    imagePositions: { value: sheetPositions, enumerable: false },
+    imagesInRange: {
+      value: range => {
+        anchors = anchors || new AnchorIndex(sheetPositions);
+        return anchors.query(targetSheet.name, normalizeCellRange(range)).map(index => sheetPositions[index]);
+      },
+      enumerable: false
+    },
+    imageCells: { value: anchorCells, enumerable: false }
+  });
+  
   return result;
+}
+
+/**
+ * 异步读取Excel表格并返回JSON数组，在原生线程中解析，不阻塞事件循环
+ * 支持进度回调和 AbortSignal 取消（例如 HTTP 客户端断开时），取消后原生内存立即释放
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @param {Object} options - 与 readTableAsJSON 相同的配置选项，另外支持：
+ * @param {AbortSignal} [options.signal] - 取消信号，取消后 Promise 以 AbortError 拒绝
+ * @param {function(Object): void} [options.onProgress] - 进度回调（最多每 100ms 一次），参数为
+ *   { phase: 'load'|'sheets'|'images', bytesRead, sheetsDone, sheetCount, rowsDone, bytesInflated }
+ * @returns {Promise<Array<Object>>} JSON数组
+ *
+ * @example
+ * const controller = new AbortController();
+ * req.on('close', () => controller.abort());
+ * const rows = await readTableAsJSONAsync(file, {
+ *   signal: controller.signal,
+ *   onProgress: p => console.log(p.phase, p.rowsDone)
+ * });
+ */
+async function readTableAsJSONAsync(input, options = {}) {
+  if (!input) {
+    throw new Error('Input is required (filepath, Buffer, or base64 string)');
+  }
+  
+  const { signal = null, onProgress = null, ...tableOptions } = options;
+  throwIfAborted(signal);
+  
+  const { filepath, cleanup } = prepareFilePath(input);
+  
+  let job;
+  try {
+    job = addon.readExcelAsync(filepath, tableOptions, onProgress);
+  } catch (err) {
+    // 选项不合法（如 filter 条件写错）时同步抛出，临时文件同样需要删除
+    cleanup();
+    throw err;
+  }
+  const onAbort = () => job.cancel();
+  if (signal) {
+    signal.addEventListener('abort', onAbort, { once: true });
+  }
+  
+  try {
+    const excelData = await job.promise;
+    return excelDataToTable(excelData, tableOptions);
+  } finally {
+    if (signal) {
+      signal.removeEventListener('abort', onAbort);
+    }
+    cleanup();
+  }
+}
+
+/**
+ * 已取消的 signal 直接抛出 AbortError
+ * @private
+ */
+function throwIfAborted(signal) {
+  if (signal && signal.aborted) {
+    const err = new Error('Read aborted');
+    err.name = 'AbortError';
+    err.code = 'ABORT_ERR';
+    throw err;
+  }
+}
+
+// readMany 迭代器模式下未消费结果的上限：达到后原生线程暂停领取新文件
+const READ_MANY_HIGH_WATER_MARK = 16;
+
+/**
+ * 批量读取多个Excel文件，在原生线程池中并行解压、解析，每个文件完成后立即返回结果
+ * 结果按完成顺序返回（不保证与输入顺序一致），可通过 index 对应到输入
+ * @param {Array<string|Buffer>} inputs - Excel文件路径、Buffer 或 base64 字符串数组
+ * @param {Object} options - 与 readTableAsJSON 相同的配置选项，另外支持：
+ * @param {number} [options.concurrency] - 原生线程数，默认为 CPU 核数
+ * @param {AbortSignal} [options.signal] - 取消信号：停止分配新文件并中止正在读取的文件（以 AbortError 返回）
+ * @param {function(Error|null, Array<Object>|null, number): void} [options.onResult] - 每个文件完成时的回调
+ * @returns {AsyncIterableIterator<{index: number, input: string|Buffer, data: Array<Object>|null, error: Error|null}>|Promise<void>}
+ *   未传 onResult 时返回异步迭代器；传入 onResult 时返回全部完成后 resolve 的 Promise
+ *   迭代器模式下，未消费的结果达到上限时原生线程暂停领取新文件；在 for await 中 break / throw 会取消剩余文件
+ *
+ * @example
+ * // 异步迭代器
+ * for await (const { index, data, error } of readMany(files, { concurrency: 8 })) {
+ *   if (error) console.error(files[index], error.message);
+ *   else await save(data);
+ * }
+ *
+ * // 回调
+ * await readMany(files, {
+ *   onResult: (err, data, index) => { ... }
+ * });
+ */
+function readMany(inputs, options = {}) {
+  if (!Array.isArray(inputs)) {
+    throw new Error('Inputs must be an array of file paths, Buffers, or base64 strings');
+  }
+  
+  const { concurrency = 0, onResult = null, signal = null, ...tableOptions } = options;
+  throwIfAborted(signal);
+  
+  // 准备所有文件路径（Buffer / base64 会写入临时文件）
+  const prepared = [];
+  try {
+    for (const input of inputs) {
+      prepared.push(prepareFilePath(input));
+    }
+  } catch (err) {
+    prepared.forEach(p => p.cleanup());
+    throw err;
+  }
+  
+  // 已完成但尚未被消费的结果，以及等待结果的消费者
+  const pending = [];
+  const waiting = [];
+  let finished = false;
+  let closed = false;
+  let paused = false;
+  
+  const deliver = (item) => {
+    if (onResult) {
+      onResult(item.error, item.data, item.index);
+    } else if (waiting.length > 0) {
+      waiting.shift()({ value: item, done: false });
+    } else {
+      pending.push(item);
+      // 消费者跟不上时暂停原生线程领取新文件，已在读取的文件仍会送达
+      if (!paused && pending.length >= READ_MANY_HIGH_WATER_MARK) {
+        paused = true;
+        job.pause();
+      }
+    }
+  };
+  
+  let job;
+  try {
+    job = addon.readMany(prepared.map(p => p.filepath), concurrency, (err, index, excelData) => {
+      prepared[index].cleanup();
+    
+      if (closed) {
+        return;
+      }
+      const item = { index, input: inputs[index], data: null, error: err };
+      if (!err) {
+        try {
+          item.data = excelDataToTable(excelData, tableOptions);
+        } catch (convertErr) {
+          item.error = convertErr;
+        }
+      }
+      deliver(item);
+    }, tableOptions);
+  } catch (err) {
+    prepared.forEach(p => p.cleanup());
+    throw err;
+  }
+  
+  const onAbort = () => job.cancel();
+  if (signal) {
+    signal.addEventListener('abort', onAbort, { once: true });
+  }
+  
+  const done = job.promise.then(() => {
+    if (signal) {
+      signal.removeEventListener('abort', onAbort);
+    }
+    // Files never handed out (cancelled batch) still need their temp copies removed
+    prepared.forEach(p => p.cleanup());
+    finished = true;
+    while (waiting.length > 0) {
+      waiting.shift()({ value: undefined, done: true });
+    }
+  });
+  
+  if (onResult) {
+    return done;
+  }
+  
+  return {
+    next() {
+      if (pending.length > 0) {
+        const item = pending.shift();
+        if (paused && pending.length <= READ_MANY_HIGH_WATER_MARK / 2) {
+          paused = false;
+          job.resume();
+        }
+        return Promise.resolve({ value: item, done: false });
+      }
+      if (finished || closed) {
+        return Promise.resolve({ value: undefined, done: true });
+      }
+      return new Promise(resolve => waiting.push(resolve));
+    },
+    // for await 中 break / throw 时调用：取消剩余文件，等待原生线程退出并清理临时文件
+    return(value) {
+      if (!closed) {
+        closed = true;
+        pending.length = 0;
+        job.cancel();
+        if (paused) {
+          paused = false;
+          job.resume();
+        }
+      }
+      return done.then(() => ({ value, done: true }));
+    },
+    [Symbol.asyncIterator]() {
+      return this;
+    }
+  };
+}
+
+/**
+ * 快速探测工作簿：只读取 ZIP 目录、workbook.xml、关系文件和每个 Sheet 的头部，不读取单元格
+ * 适合在接收上传文件前根据 Sheet 尺寸、图片数量、解压后大小进行拒绝或分流
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @returns {Object} 工作簿概要信息（sheets、imageCount、uncompressedSize 等）
+ *
+ * @example
+ * const info = probe('./upload.xlsx');
+ * if (info.uncompressedSize > 200 * 1024 * 1024 || info.sheets.some(s => s.rowCount > 100000)) {
+ *   throw new Error('文件过大');
+ * }
+ */
+function probe(input) {
+  if (!input) {
+    throw new Error('Input is required (filepath, Buffer, or base64 string)');
+  }
+  
+  const { filepath, cleanup } = prepareFilePath(input);
+  
+  try {
+    return addon.probe(filepath);
   } finally {
     cleanup();
   }
 }
 
 
+/**
+ * 将 Sheet 直接导出为 CSV，在原生层完成序列化，不创建 JS 行对象
+ * 行列选择与 readTableAsJSON 一致（headerRow / skipRows / headerMap）
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @param {Object} options - 与 readTableAsJSON 相同的配置选项，另外支持：
+ * @param {'ref'|'base64'} [options.images='ref'] - 图片单元格输出图片名（ref）或 data URI（base64）
+ * @param {string} [options.delimiter=','] - 分隔符（单个字符）
+ * @param {boolean} [options.header=true] - 是否输出表头行
+ * @param {number} [options.fd] - 写入的文件描述符；传入时返回写入的字节数
+ * @returns {Buffer|number} CSV 内容，或传入 fd 时写入的字节数
+ *
+ * @example
+ * res.type('text/csv').send(toCSV('./sample.xlsx', { headerMap: { '名称': 'name' } }));
+ *
+ * const fd = fs.openSync('./out.csv', 'w');
+ * toCSV('./sample.xlsx', { fd });
+ * fs.closeSync(fd);
+ */
+function toCSV(input, options = {}) {
+  return exportTable(input, { ...options, format: 'csv' });
+}
+
+/**
+ * 将 Sheet 直接导出为 NDJSON（每行一个 JSON 对象），在原生层完成序列化，不创建 JS 行对象
+ * 每行内容与 readTableAsJSON 返回的对象一致；图片单元格输出图片信息对象，base64 模式下附带 data 字段
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @param {Object} options - 与 readTableAsJSON 相同的配置选项，另外支持：
+ * @param {'ref'|'base64'} [options.images='ref'] - 图片是否以 base64 输出数据
+ * @param {number} [options.fd] - 写入的文件描述符；传入时返回写入的字节数
+ * @returns {Buffer|number} NDJSON 内容，或传入 fd 时写入的字节数
+ */
+function toNDJSON(input, options = {}) {
+  return exportTable(input, { ...options, format: 'ndjson' });
+}
+
+/**
+ * toCSV / toNDJSON 的公共实现
+ * @private
+ */
+function exportTable(input, options) {
+  if (!input) {
+    throw new Error('Input is required (filepath, Buffer, or base64 string)');
+  }
+  
+  const { filepath, cleanup } = prepareFilePath(input);
+  
+  try {
+    return addon.exportTable(filepath, options);
+  } finally {
+    cleanup();
+  }
+}
+
+/**
+ * 创建流式 XLSX 写入器：行数据边写边落盘到临时文件，close() 时压缩为 .xlsx，内存占用与行数无关
+ * @param {string} filepath - 输出文件路径
+ * @returns {{addSheet: function(string): void, writeRow: function(Array): void, addImage: function(Buffer, Object): void, close: function(): void}}
+ *   writeRow 接受字符串、数字、布尔值、null，以及图片（Buffer 或 { data: Buffer }，放入所在单元格）；
+ *   数字为 NaN / Infinity、一行超过 16384 列或 Sheet 已有 1048576 行时抛出错误，该行不写入
+ *
+ * @example
+ * const writer = createWriter('./out.xlsx');
+ * writer.addSheet('Users');
+ * writer.writeRow(['name', 'age', 'photo']);
+ * for (const user of users) {
+ *   writer.writeRow([user.name, user.age, user.photo]);
+ * }
+ * writer.addImage(logo, { col: 4, row: 0, toCol: 6, toRow: 3 });
+ * writer.close();
+ */
+function createWriter(filepath) {
+  if (typeof filepath !== 'string' || !filepath) {
+    throw new Error('Output filepath is required');
+  }
+  
+  const absolutePath = path.isAbsolute(filepath) ? filepath : path.resolve(filepath);
+  return new addon.XlsxWriter(absolutePath);
+}
+
+/**
+ * 打开工作簿用于分页读取大表：首次访问某个 Sheet 时解压一次并建立行偏移索引（Sheet XML 暂存到临时文件），
+ * 之后的 readRows 直接定位到所需行解析，不再从头扫描。仅读取单元格值（与 valuesOnly 相同），不含图片
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @param {Object} [options] - 支持 dates、limits
+ * @returns {{sheetNames: function(): string[], sheetSize: function(string=): {rows: number, columns: number},
+ *   readRows: function(string|null, number, number): string[][], close: function(): void}}
+ *   readRows(sheetName, start, count) 的行号从0开始（与 readTableAsJSON 的 headerRow 一致），sheetName 为 null 时读取第一个Sheet
+ *
+ * @example
+ * const wb = openWorkbook('./big.xlsx');
+ * const { rows } = wb.sheetSize('Sheet1');
+ * const page = wb.readRows('Sheet1', 200000, 100);
+ * wb.close();
+ */
+function openWorkbook(input, options = {}) {
+  if (!input) {
+    throw new Error('Input is required (filepath, Buffer, or base64 string)');
+  }
+  
+  // 临时文件需保留到 close()，原生层按需从中读取
+  const { filepath, cleanup } = prepareFilePath(input);
+  
+  let handle;
+  try {
+    handle = new addon.Workbook(filepath, options);
+  } catch (err) {
+    cleanup();
+    throw err;
+  }
+  
+  let closed = false;
+  return {
+    sheetNames: () => handle.sheetNames(),
+    sheetSize: (sheetName) => handle.sheetSize(sheetName || ''),
+    readRows: (sheetName, start, count) => handle.readRows(sheetName || '', start, count),
+    close: () => {
+      if (closed) return;
+      closed = true;
+      handle.close();
+      cleanup();
+    }
+  };
+}
+
+/**
+ * 读取Excel并将完整结果（单元格文本、图片数据、图片位置）打包为一个 ArrayBuffer。
+ * 适合在 worker_threads 中解析：通过 postMessage(buffer, [buffer]) 转移所有权，零拷贝交给主线程，
+ * 避免嵌套数组的结构化克隆；主线程用 new PackedWorkbook(buffer) 按需读取单元格
+ * @param {string|Buffer} input - Excel文件路径、Buffer 或 base64 字符串
+ * @param {Object} [options] - 与 readTableAsJSON 相同的读取选项（valuesOnly、dates、filter、limits 等）
+ * @returns {ArrayBuffer} 打包后的结果
+ *
+ * @example
+ * // worker.js
+ * const buffer = readPacked(file, { valuesOnly: true });
+ * parentPort.postMessage(buffer, [buffer]);
+ *
+ * // main.js
+ * worker.on('message', buffer => {
+ *   const wb = new PackedWorkbook(buffer);
+ *   const sheet = wb.sheet('Sheet1');
+ *   for (let r = 0; r < sheet.rowCount; r++) console.log(sheet.row(r));
+ * });
+ */
+function readPacked(input, options = {}) {
+  if (!input) {
+    throw new Error('Input is required (filepath, Buffer, or base64 string)');
+  }
+  
+  const { filepath, cleanup } = prepareFilePath(input);
+  
+  try {
+    return addon.readPacked(filepath, options);
+  } finally {
+    cleanup();
+  }
+}
+
+/**
+ * 图片锚点覆盖的单元格范围（从0开始，包含两端）。
+ * to 的偏移为0时图片止于该行/列的起始边，不计入该行/列
+ * @param {Object} position - imagePositions 中的一项
+ * @returns {{firstRow: number, firstCol: number, lastRow: number, lastCol: number}}
+ */
+function anchorCells(position) {
+  const { from, to } = position;
+  let lastRow = to.row > from.row && !to.rowOff ? to.row - 1 : to.row;
+  let lastCol = to.col > from.col && !to.colOff ? to.col - 1 : to.col;
+  return {
+    firstRow: from.row,
+    firstCol: from.col,
+    lastRow: Math.max(lastRow, from.row),
+    lastCol: Math.max(lastCol, from.col)
+  };
+}
+
+/**
+ * imagesInRange 的查询范围：不传 lastRow 时只查 firstRow 一行，不传列时匹配所有列
+ * @private
+ */
+function normalizeCellRange(range) {
+  return {
+    firstRow: range.firstRow,
+    lastRow: range.lastRow === undefined ? range.firstRow : range.lastRow,
+    firstCol: range.firstCol === undefined ? 0 : range.firstCol,
+    lastCol: range.lastCol === undefined ? Infinity : range.lastCol
+  };
+}
+
+/**
+ * 按 Sheet 建立的图片锚点区间树（与原生 AnchorIndex 相同的隐式结构）：
+ * 锚点按起始行排序，每个节点记录子树中最大的结束行，区间查询为 O(log n + k)，命中后再按列过滤
+ */
+class AnchorIndex {
+  constructor(positions) {
+    this._positions = positions;
+    this._sheets = new Map();
+    positions.forEach((position, index) => {
+      const cells = anchorCells(position);
+      let entries = this._sheets.get(position.sheet);
+      if (!entries) {
+        entries = [];
+        this._sheets.set(position.sheet, entries);
+      }
+      entries.push({ firstRow: cells.firstRow, lastRow: cells.lastRow, maxLastRow: cells.lastRow, index });
+    });
+    for (const [sheet, entries] of this._sheets) {
+      entries.sort((a, b) => a.firstRow - b.firstRow || a.index - b.index);
+      this._sheets.set(sheet, { entries, levels: AnchorIndex._build(entries) });
+    }
+  }
+  
+  // 叶子位于偶数下标，第 k 层节点的子节点位于 ±2^(k-1)；越界下标视为空子树
+  static _build(a) {
+    const n = a.length;
+    if (n === 0) return 0;
+    let lastIndex = 0;
+    let last = 0;
+    for (let i = 0; i < n; i += 2) {
+      lastIndex = i;
+      last = a[i].maxLastRow = a[i].lastRow;
+    }
+    let k = 1;
+    for (; 2 ** k <= n; k++) {
+      const x = 2 ** (k - 1);
+      for (let i = 2 * x - 1; i < n; i += 4 * x) {
+        const left = a[i - x].maxLastRow;
+        const right = i + x < n ? a[i + x].maxLastRow : last;
+        a[i].maxLastRow = Math.max(a[i].lastRow, left, right);
+      }
+      lastIndex = Math.floor(lastIndex / 2 ** k) % 2 ? lastIndex - x : lastIndex + x;
+      if (lastIndex < n && a[lastIndex].maxLastRow > last) {
+        last = a[lastIndex].maxLastRow;
+      }
+    }
+    return k - 1;
+  }
+  
+  _collect(tree, firstRow, lastRow, out) {
+    const a = tree.entries;
+    const n = a.length;
+    const visit = (level, node) => {
+      if (level <= 3) {
+        const begin = node - (2 ** level - 1);
+        const end = Math.min(n, begin + 2 ** (level + 1) - 1);
+        for (let i = begin; i < end && a[i].firstRow <= lastRow; i++) {
+          if (a[i].lastRow >= firstRow) out.push(a[i].index);
+        }
+        return;
+      }
+      const half = 2 ** (level - 1);
+      const left = node - half;
+      if (left >= n || a[left].maxLastRow >= firstRow) visit(level - 1, left);
+      if (node < n && a[node].firstRow <= lastRow) {
+        if (a[node].lastRow >= firstRow) out.push(a[node].index);
+        visit(level - 1, node + half);
+      }
+    };
+    if (n > 0) visit(tree.levels, 2 ** tree.levels - 1);
+  }
+  
+  /** @returns {number[]} 与范围重叠的锚点在 positions 中的下标，升序 */
+  query(sheetName, range) {
+    const tree = this._sheets.get(sheetName);
+    if (!tree) return [];
+    const rows = [];
+    this._collect(tree, range.firstRow, range.lastRow, rows);
+    return rows
+      .filter(index => {
+        const cells = anchorCells(this._positions[index]);
+        return cells.lastCol >= range.firstCol && cells.firstCol <= range.lastCol;
+      })
+      .sort((a, b) => a - b);
+  }
+  
+  /** @returns {number} 左上角位于 (row, col) 的第一个锚点下标，没有时为 -1 */
+  findAt(sheetName, row, col) {
+    const found = this.query(sheetName, { firstRow: row, lastRow: row, firstCol: col, lastCol: col })
+      .find(index => this._positions[index].from.row === row && this._positions[index].from.col === col);
+    return found === undefined ? -1 : found;
+  }
+}
+
+const PACKED_MAGIC = 0x4B505842; // "BXPK"
+const PACKED_VERSION = 1;
+
+/**
+ * readPacked 结果的只读视图：直接在 ArrayBuffer 上读取，不复制单元格数据。
+ * 单元格文本在访问时才解码，图片数据为指向同一内存的 Buffer 视图
+ * @param {ArrayBuffer|SharedArrayBuffer|Uint8Array} buffer - readPacked 返回的数据
+ */
+class PackedWorkbook {
+  constructor(buffer) {
+    const arrayBuffer = ArrayBuffer.isView(buffer) ? buffer.buffer : buffer;
+    const base = ArrayBuffer.isView(buffer) ? buffer.byteOffset : 0;
+    const header = new DataView(arrayBuffer, base, 32);
+    const field = index => header.getUint32(index * 4, true);
+    if (field(0) !== PACKED_MAGIC || field(1) !== PACKED_VERSION) {
+      throw new Error('Not a packed Excel result (or written by another version)');
+    }
+    
+    const [metaOffset, metaLength, cellsOffset, textOffset, mediaOffset, totalLength] =
+      [field(2), field(3), field(4), field(5), field(6), field(7)];
+    const bytes = Buffer.from(arrayBuffer, base, totalLength);
+    const meta = JSON.parse(bytes.toString('utf8', metaOffset, metaOffset + metaLength));
+    
+    // 单元格偏移表需要 4 字节对齐，从非对齐的视图构造时复制一份
+    const cellCount = (textOffset - cellsOffset) / 4;
+    const cells = (base + cellsOffset) % 4 === 0
+      ? new Uint32Array(arrayBuffer, base + cellsOffset, cellCount)
+      : new Uint32Array(arrayBuffer.slice(base + cellsOffset, base + textOffset));
+    
+    /** 原始数据，可再次转移给其他线程 */
+    this.buffer = buffer;
+    this.images = meta.images.map(img => {
+      const image = {
+        name: img.name,
+        type: img.type,
+        width: img.width,
+        height: img.height,
+        hash: img.hash
+      };
+      if (img.sha256) image.sha256 = img.sha256;
+      if (img.known) {
+        image.known = true;
+        image.data = null;
+      } else {
+        image.data = bytes.subarray(mediaOffset + img.offset, mediaOffset + img.offset + img.size);
+      }
+      return image;
+    });
+    this.imagePositions = meta.imagePositions;
+    this.cellImageMappings = meta.cellImageMappings;
+    this.sheets = meta.sheets.map(sheet => new PackedSheet(this, sheet, bytes, textOffset, cells));
+  }
+  
+  /** @returns {string[]} 所有 Sheet 名称 */
+  sheetNames() {
+    return this.sheets.map(sheet => sheet.name);
+  }
+  
+  /**
+   * @param {string} [sheetName] - Sheet 名称，不传时返回第一个 Sheet
+   * @returns {PackedSheet}
+   */
+  sheet(sheetName) {
+    const sheet = sheetName ? this.sheets.find(s => s.name === sheetName) : this.sheets[0];
+    if (!sheet) {
+      throw new Error(sheetName ? `未找到名为 "${sheetName}" 的Sheet` : 'Excel文件中没有Sheet');
+    }
+    return sheet;
+  }
+  
+  /**
+   * 与单元格范围重叠的图片位置（行号为原表行号，从0开始，包含两端），按 imagePositions 顺序返回。
+   * 首次调用时按 Sheet 建立区间索引，之后的查询不再遍历全部图片
+   * @param {string} sheetName - Sheet 名称
+   * @param {{firstRow: number, lastRow: number, firstCol?: number, lastCol?: number}} range - 不传列时匹配所有列
+   * @returns {Object[]} imagePositions 中的项
+   *
+   * @example
+   * // 第 100-200 行中的图片
+   * const positions = wb.imagesInRange('Sheet1', { firstRow: 99, lastRow: 199 });
+   */
+  imagesInRange(sheetName, range) {
+    return this._anchorIndex().query(sheetName, normalizeCellRange(range)).map(index => this.imagePositions[index]);
+  }
+  
+  /**
+   * 图片锚点覆盖的单元格范围
+   * @param {Object} position - imagePositions 中的一项
+   * @returns {{firstRow: number, firstCol: number, lastRow: number, lastCol: number}}
+   */
+  imageCells(position) {
+    return anchorCells(position);
+  }
+  
+  /** @returns {Object|null} 名称对应的图片 */
+  _imageByName(name) {
+    if (!this._imagesByName) {
+      this._imagesByName = new Map();
+      for (const image of this.images) {
+        if (!this._imagesByName.has(image.name)) this._imagesByName.set(image.name, image);
+      }
+    }
+    return this._imagesByName.get(name) || null;
+  }
+  
+  _anchorIndex() {
+    if (!this._anchors) {
+      this._anchors = new AnchorIndex(this.imagePositions);
+    }
+    return this._anchors;
+  }
+}
+
+/**
+ * PackedWorkbook 中的一个 Sheet，行列号从0开始
+ */
+class PackedSheet {
+  constructor(workbook, sheet, bytes, textOffset, cells) {
+    this.name = sheet.name;
+    this.rowCount = sheet.rows;
+    this.columnCount = sheet.columns;
+    /** 使用 filter 时每行在原表中的行号，否则为 null */
+    this.rowIndex = sheet.rowIndex;
+    /** 使用 schemaRows 时每列推断的类型 [{ type, samples, fallbacks }]，否则为 null */
+    this.schema = sheet.schema;
+    this._workbook = workbook;
+    this._bytes = bytes;
+    this._textOffset = textOffset;
+    this._cells = cells;
+    this._first = sheet.cells;
+  }
+  
+  /**
+   * 单元格文本；嵌入单元格的图片为 "__IMAGE_CELL__" 标记，可用 image() 获取图片
+   * @param {number} row
+   * @param {number} col
+   * @returns {string}
+   */
+  cell(row, col) {
+    if (row < 0 || row >= this.rowCount || col < 0 || col >= this.columnCount) {
+      return '';
+    }
+    const index = this._first + row * this.columnCount + col;
+    const start = this._cells[index];
+    const end = this._cells[index + 1];
+    return start === end ? '' : this._bytes.toString('utf8', this._textOffset + start, this._textOffset + end);
+  }
+  
+  /**
+   * @param {number} row
+   * @returns {string[]} 一行的单元格文本
+   */
+  row(row) {
+    const values = new Array(this.columnCount);
+    for (let col = 0; col < this.columnCount; col++) {
+      values[col] = this.cell(row, col);
+    }
+    return values;
+  }
+  
+  /**
+   * @param {number} row
+   * @returns {number} 该行在原表中的行号
+   */
+  originalRow(row) {
+    return this.rowIndex ? this.rowIndex[row] : row;
+  }
+  
+  /**
+   * 嵌入单元格的图片（与 readTableAsJSON 相同的匹配规则），不是图片单元格时返回 null
+   * @param {number} row
+   * @param {number} col
+   * @returns {Object|null}
+   */
+  image(row, col) {
+    const text = this.cell(row, col);
+    if (!text.startsWith('__IMAGE_CELL__')) {
+      return null;
+    }
+    
+    const workbook = this._workbook;
+    let imageName;
+    if (text.startsWith('__IMAGE_CELL__:')) {
+      const imageId = text.slice(15);
+      const mapping = workbook.cellImageMappings.find(m => m.imageId === imageId);
+      imageName = mapping && mapping.imageName;
+    } else {
+      const index = workbook._anchorIndex().findAt(this.name, this.originalRow(row), col);
+      imageName = index >= 0 ? workbook.imagePositions[index].image : undefined;
+    }
+    return (imageName && workbook._imageByName(imageName)) || null;
+  }
+}
+
+/**
+ * 原生内存用量（字节）：读取结果的 arena、待交给 JS 的图片数据、导出 Buffer、写入器的共享字符串表等。
+ * 这部分内存不在 V8 堆中，已通过 external memory 告知 V8，以便 GC 按真实内存压力调度
+ * @returns {{current: number, peak: number, external: number}}
+ *   current 当前持有的原生内存，peak 进程内峰值，external 当前已报告给 V8 的字节数
+ *
+ * @example
+ * const { current, peak } = nativeMemoryUsage();
+ * console.log(`native: ${current} bytes (peak ${peak})`);
+ */
+function nativeMemoryUsage() {
+  return addon.nativeMemory();
+}
+
+/**
+ * 配置进程级读取调度器：所有读取（同步、异步、readMany、readPacked）在解析前按预算排队，
+ * 超出预算的读取按到达顺序等待，突发上传时内存峰值受控而不是所有读取同时展开。
+ * 每个读取按压缩包解压后大小估算内存（完整模式约 4 倍，valuesOnly 约 2 倍）；
+ * 单个估算超过整个预算的读取在没有其他读取运行时执行。排队中的异步读取可通过 AbortSignal 取消。
+ * 注意：同步读取排队时会阻塞当前线程，高并发场景请使用 readTableAsJSONAsync / readMany
+ * @param {Object} options
+ * @param {number} [options.maxConcurrent] - 同时解析的最大读取数，0 表示不限制
+ * @param {number} [options.memoryBudget] - 运行中读取的内存估算总和上限（字节），0 表示不限制
+ * @returns {Object} 当前状态，同 readSchedulerStats()
+ *
+ * @example
+ * configureReadScheduler({ maxConcurrent: os.cpus().length, memoryBudget: 2 * 1024 ** 3 });
+ */
+function configureReadScheduler(options = {}) {
+  return addon.configureScheduler(options);
+}
+
+/**
+ * 读取调度器状态
+ * @returns {{maxConcurrent: number, memoryBudget: number, running: number, queued: number,
+ *   reservedBytes: number, admitted: number, waited: number, totalWaitMs: number,
+ *   maxWaitMs: number, peakQueued: number}}
+ *   running 正在解析的读取数，queued 排队数，reservedBytes 运行中读取的内存估算总和，
+ *   admitted 已开始的读取总数，waited 其中排过队的数量，totalWaitMs / maxWaitMs 排队总时长与最长等待
+ */
+function readSchedulerStats() {
+  return addon.schedulerStats();
+}
+
+
 module.exports = {
-  readTableAsJSON
+  readTableAsJSON,
+  readTableAsJSONAsync,
+  readMany,
+  probe,
+  toCSV,
+  toNDJSON,
+  createWriter,
+  openWorkbook,
+  readPacked,
+  PackedWorkbook,
+  nativeMemoryUsage,
+  configureReadScheduler,
+  readSchedulerStats
 };
@@ -1,11 +1,38 @@
 {
+  "variables": {
+    "inflate_backend%": "libzip",
+    "count_allocations%": "false"
+  },
   "targets": [
     {
       "target_name": "baja_xlsx",
       "sources": [
         "src/addon.cpp",
         "src/xlsx_reader.cpp",
-        "src/image_extractor.cpp"
+        "src/image_extractor.cpp",
+        "src/ooxml_parts.cpp",
+        "src/arena.cpp",
+        "src/batch_reader.cpp",
+        "src/image_format.cpp",
+        "src/content_hash.cpp",
+        "src/zip_archive.cpp",
+        "src/workbook_probe.cpp",
+        "src/xlsx_writer.cpp",
+        "src/table_export.cpp",
+        "src/read_limits.cpp",
+        "src/read_control.cpp",
+        "src/cell_format.cpp",
+        "src/lean_workbook.cpp",
+        "src/native_memory.cpp",
+        "src/row_filter.cpp",
+        "src/sheet_index.cpp",
+        "src/parse_cache.cpp",
+        "src/packed_result.cpp",
+        "src/inflate.cpp",
+        "src/read_scheduler.cpp",
+        "src/anchor_index.cpp",
+        "src/column_schema.cpp",
+        "src/alloc_counter.cpp"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -20,6 +47,73 @@
       "cflags!": ["-fno-exceptions"],
       "cflags_cc!": ["-fno-exceptions"],
       "conditions": [
+        [
+          "inflate_backend=='libdeflate'",
+          {
+            "defines": [
+              "BAJA_INFLATE_LIBDEFLATE"
+            ],
+            "conditions": [
+              [
+                "OS=='win'",
+                {
+                  "libraries": [
+                    "<!(echo %VCPKG_ROOT%)/installed/x64-windows/lib/deflate.lib"
+                  ]
+                },
+                {
+                  "libraries": [
+                    "-ldeflate"
+                  ]
+                }
+              ]
+            ]
+          }
+        ],
+        [
+          "inflate_backend=='zlib-ng'",
+          {
+            "defines": [
+              "BAJA_INFLATE_ZLIB_NG"
+            ],
+            "conditions": [
+              [
+                "OS=='win'",
+                {
+                  "libraries": [
+                    "<!(echo %VCPKG_ROOT%)/installed/x64-windows/lib/zlib-ng.lib"
+                  ]
+                },
+                {
+                  "libraries": [
+                    "-lz-ng"
+                  ]
+                }
+              ]
+            ]
+          }
+        ],
+        [
+          "count_allocations=='true'",
+          {
+            "defines": [
+              "BAJA_COUNT_ALLOCATIONS"
+            ],
+            "conditions": [
+              [
+                "OS=='linux'",
+                {
+                  "defines": [
+                    "_GLIBCXX_ASSERTIONS"
+                  ],
+                  "ldflags": [
+                    "-Wl,-Bsymbolic-functions"
+                  ]
+                }
+              ]
+            ]
+          }
+        ],
         [
           "OS=='win'",
           {
@@ -0,0 +1,342 @@
+/**
+ * 内存回归测试
+ * 在生成的固定样本上运行 readExcel / readTableAsJSON，按阶段记录：
+ *   - 原生分配次数与字节数、原生分配峰值（需要计数构建：npm run build:memory）
+ *   - 进程峰值 RSS、V8 堆增量、nativeMemoryUsage() 增量
+ * 并与 scripts/memory-baselines.json 中的基线比较，超出容差时以非 0 退出码失败。
+ *
+ * 用法：
+ *   node scripts/memory-regression.js              与基线比较
+ *   node scripts/memory-regression.js --update     以本次结果更新当前平台的基线
+ *   node scripts/memory-regression.js --strict     当前平台没有基线时也视为失败
+ *   node scripts/memory-regression.js --case numbers/readExcel   只运行指定用例（可重复）
+ *
+ * 每个用例在独立的子进程中运行（--expose-gc），峰值 RSS 不受其他用例影响。
+ * 基线按 平台-架构-Node主版本 分组：分配次数取决于编译器和标准库，堆增量取决于 V8 版本。
+ */
+
+const fs = require('fs');
+const path = require('path');
+const os = require('os');
+const zlib = require('zlib');
+const { fork } = require('child_process');
+
+const ROOT = path.join(__dirname, '..');
+const BASELINE_FILE = path.join(__dirname, 'memory-baselines.json');
+const FIXTURE_DIR = path.join(os.tmpdir(), 'baja-xlsx-memory-fixtures');
+
+// ---------------------------------------------------------------------------
+// 样本：内容完全由固定种子决定，保证每次生成的文件相同
+// ---------------------------------------------------------------------------
+
+function lcg(seed) {
+  let state = seed >>> 0;
+  return () => {
+    state = (Math.imul(state, 1664525) + 1013904223) >>> 0;
+    return state / 4294967296;
+  };
+}
+
+const CRC_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+function crc32(buffer) {
+  let crc = 0xFFFFFFFF;
+  for (const byte of buffer) crc = CRC_TABLE[(crc ^ byte) & 0xFF] ^ (crc >>> 8);
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+function pngChunk(type, data) {
+  const length = Buffer.alloc(4);
+  length.writeUInt32BE(data.length);
+  const body = Buffer.concat([Buffer.from(type, 'ascii'), data]);
+  const crc = Buffer.alloc(4);
+  crc.writeUInt32BE(crc32(body));
+  return Buffer.concat([length, body, crc]);
+}
+
+// size x size 的 RGB PNG，像素由 seed 决定，每张图片哈希不同
+function makePng(size, seed) {
+  const random = lcg(seed);
+  const raw = Buffer.alloc((size * 3 + 1) * size);
+  for (let y = 0; y < size; y++) {
+    const row = y * (size * 3 + 1);
+    for (let x = 0; x < size * 3; x++) raw[row + 1 + x] = Math.floor(random() * 256);
+  }
+  const header = Buffer.alloc(13);
+  header.writeUInt32BE(size, 0);
+  header.writeUInt32BE(size, 4);
+  header[8] = 8;   // bit depth
+  header[9] = 2;   // RGB
+  return Buffer.concat([
+    Buffer.from([0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A]),
+    pngChunk('IHDR', header),
+    pngChunk('IDAT', zlib.deflateSync(raw)),
+    pngChunk('IEND', Buffer.alloc(0))
+  ]);
+}
+
+const FIXTURES = {
+  // 文本为主：重复率高的共享字符串
+  strings: writer => {
+    const random = lcg(1);
+    const words = Array.from({ length: 500 }, (_, i) => `项目-${i}-${'x'.repeat(i % 40)}`);
+    writer.writeRow(['编号', '名称', '类别', '地区', '负责人', '备注', '状态', '标签']);
+    for (let r = 0; r < 20000; r++) {
+      const row = [`R${r}`];
+      for (let c = 1; c < 8; c++) row.push(words[Math.floor(random() * words.length)]);
+      writer.writeRow(row);
+    }
+  },
+  // 数值为主：整数、小数、布尔
+  numbers: writer => {
+    const random = lcg(2);
+    writer.writeRow(['id', 'amount', 'price', 'ratio', 'serial', 'flag']);
+    for (let r = 0; r < 50000; r++) {
+      writer.writeRow([r, Math.floor(random() * 1e6), Math.round(random() * 1e4) / 100,
+        random(), 45000 + Math.floor(random() * 2000), random() < 0.5]);
+    }
+  },
+  // 图片为主：嵌入单元格的图片加浮动图片
+  images: writer => {
+    writer.writeRow(['名称', '图片']);
+    for (let r = 0; r < 200; r++) {
+      writer.writeRow([`图片 ${r}`, { data: makePng(64, 1000 + r) }]);
+    }
+    for (let i = 0; i < 20; i++) {
+      writer.addImage(makePng(128, 5000 + i), { col: 3, row: i * 10, toCol: 6, toRow: i * 10 + 8 });
+    }
+  }
+};
+
+// 用例：样本 x 接口 x 选项
+const CASES = [];
+for (const fixture of Object.keys(FIXTURES)) {
+  CASES.push({ name: `${fixture}/readExcel`, fixture, api: 'readExcel', options: {} });
+  CASES.push({ name: `${fixture}/readExcel-valuesOnly`, fixture, api: 'readExcel', options: { valuesOnly: true } });
+  CASES.push({ name: `${fixture}/readTableAsJSON`, fixture, api: 'readTableAsJSON', options: {} });
+}
+
+// ---------------------------------------------------------------------------
+// 子进程：加载扩展，运行一个用例的各阶段并回传测量结果
+// ---------------------------------------------------------------------------
+
+function loadAddon() {
+  try {
+    return require(path.join(ROOT, 'build', 'Release', 'baja_xlsx.node'));
+  } catch (err) {
+    return require(path.join(ROOT, 'build', 'Debug', 'baja_xlsx.node'));
+  }
+}
+
+function runCase(testCase, file) {
+  const addon = loadAddon();
+  const lib = require(ROOT);
+  const counting = addon.allocationStats().enabled;
+
+  // 阶段开始：GC 后记录基准，并开启新的原生峰值窗口
+  const begin = () => {
+    global.gc();
+    global.gc();
+    return {
+      alloc: addon.allocationStats(true),
+      heap: process.memoryUsage().heapUsed,
+      native: addon.nativeMemory().current
+    };
+  };
+  const end = start => {
+    global.gc();
+    global.gc();
+    const alloc = addon.allocationStats();
+    return {
+      allocations: counting ? alloc.count - start.alloc.count : null,
+      allocatedBytes: counting ? alloc.bytes - start.alloc.bytes : null,
+      nativePeak: counting ? alloc.peak - start.alloc.live : null,
+      peakRss: process.resourceUsage().maxRSS * 1024,
+      heapDelta: process.memoryUsage().heapUsed - start.heap,
+      nativeHeld: addon.nativeMemory().current - start.native
+    };
+  };
+
+  const phases = {};
+
+  // read：结果保留在内存中，堆增量即结果占用的 V8 堆
+  let start = begin();
+  let result = testCase.api === 'readExcel'
+    ? addon.readExcel(file, testCase.options)
+    : lib.readTableAsJSON(file, testCase.options);
+  phases.read = end(start);
+
+  // release：丢弃结果，原生内存和堆应回到读取前的水平
+  start = begin();
+  result = null;
+  phases.release = end(start);
+
+  return { counting, phases };
+}
+
+if (process.argv[2] === '--child') {
+  const testCase = JSON.parse(process.argv[3]);
+  const file = process.argv[4];
+  const { counting, phases } = runCase(testCase, file);
+  process.send({ counting, phases });
+  process.exit(0);
+}
+
+// ---------------------------------------------------------------------------
+// 主进程：生成样本、逐个运行用例、与基线比较
+// ---------------------------------------------------------------------------
+
+const METRICS = ['allocations', 'allocatedBytes', 'nativePeak', 'peakRss', 'heapDelta', 'nativeHeld'];
+const BYTE_METRICS = new Set(['allocatedBytes', 'nativePeak', 'peakRss', 'heapDelta', 'nativeHeld']);
+
+function parseArgs(argv) {
+  const args = { update: false, strict: false, cases: [] };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--update') args.update = true;
+    else if (argv[i] === '--strict') args.strict = true;
+    else if (argv[i] === '--case') args.cases.push(argv[++i]);
+  }
+  return args;
+}
+
+function generateFixtures(names) {
+  const lib = require(ROOT);
+  fs.mkdirSync(FIXTURE_DIR, { recursive: true });
+  const files = {};
+  for (const name of names) {
+    const file = path.join(FIXTURE_DIR, `${name}.xlsx`);
+    const writer = lib.createWriter(file);
+    FIXTURES[name](writer);
+    writer.close();
+    files[name] = file;
+  }
+  return files;
+}
+
+function runInChild(testCase, file) {
+  return new Promise((resolve, reject) => {
+    const child = fork(__filename, ['--child', JSON.stringify(testCase), file], {
+      execArgv: ['--expose-gc'],
+      stdio: ['ignore', 'inherit', 'inherit', 'ipc']
+    });
+    let message = null;
+    child.on('message', m => { message = m; });
+    child.on('error', reject);
+    child.on('exit', code => {
+      if (code === 0 && message) resolve(message);
+      else reject(new Error(`${testCase.name}: 子进程退出码 ${code}`));
+    });
+  });
+}
+
+function formatValue(metric, value) {
+  if (value === null || value === undefined) return '-';
+  if (!BYTE_METRICS.has(metric)) return String(value);
+  const sign = value < 0 ? '-' : '';
+  const abs = Math.abs(value);
+  if (abs >= 1024 * 1024) return `${sign}${(abs / 1024 / 1024).toFixed(1)} MB`;
+  if (abs >= 1024) return `${sign}${(abs / 1024).toFixed(1)} KB`;
+  return `${sign}${abs} B`;
+}
+
+// 超出 基线 * (1 + 容差) + 余量 视为回归；明显低于基线时提示更新
+function compareMetric(metric, current, baseline, config) {
+  if (current === null || baseline === null || baseline === undefined) return null;
+  const tolerance = config.tolerance[metric];
+  const slack = BYTE_METRICS.has(metric) ? config.slackBytes : config.slackAllocations;
+  const limit = Math.abs(baseline) * tolerance + slack;
+  if (current > baseline + limit) return 'regression';
+  if (current < baseline - limit) return 'improvement';
+  return 'ok';
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const selected = args.cases.length > 0 ? CASES.filter(c => args.cases.includes(c.name)) : CASES;
+  if (selected.length === 0) {
+    console.error(`❌ 未找到用例：${args.cases.join(', ')}`);
+    console.error(`   可用用例：${CASES.map(c => c.name).join(', ')}`);
+    process.exit(2);
+  }
+
+  const config = JSON.parse(fs.readFileSync(BASELINE_FILE, 'utf8'));
+  const platformKey = `${process.platform}-${process.arch}-node${process.versions.node.split('.')[0]}`;
+  const baselines = (config.platforms[platformKey] || {}).cases || {};
+
+  console.log(`🧪 内存回归测试（${platformKey}）\n`);
+  const files = generateFixtures([...new Set(selected.map(c => c.fixture))]);
+
+  const results = {};
+  let counting = false;
+  const regressions = [];
+  const improvements = [];
+  const missing = [];
+
+  for (const testCase of selected) {
+    const measured = await runInChild(testCase, files[testCase.fixture]);
+    counting = measured.counting;
+    results[testCase.name] = measured.phases;
+
+    console.log(`▶ ${testCase.name}`);
+    const baseline = baselines[testCase.name];
+    if (!baseline) missing.push(testCase.name);
+
+    for (const [phase, metrics] of Object.entries(measured.phases)) {
+      const cells = METRICS.map(metric => {
+        const expected = baseline && baseline[phase] ? baseline[phase][metric] : undefined;
+        const verdict = compareMetric(metric, metrics[metric], expected, config);
+        if (verdict === 'regression') regressions.push(`${testCase.name} ${phase}.${metric}`);
+        if (verdict === 'improvement') improvements.push(`${testCase.name} ${phase}.${metric}`);
+        const mark = verdict === 'regression' ? ' ❌' : verdict === 'improvement' ? ' ⬇' : '';
+        const reference = expected === undefined || expected === null ? '' : ` (基线 ${formatValue(metric, expected)})`;
+        return `${metric}=${formatValue(metric, metrics[metric])}${reference}${mark}`;
+      });
+      console.log(`  ${phase.padEnd(8)} ${cells.join('  ')}`);
+    }
+  }
+
+  if (!counting) {
+    console.log('\n⚠️  扩展未启用分配计数，仅比较 RSS / 堆 / nativeMemory 指标');
+    console.log('   启用方式：npm run build:memory');
+  }
+
+  if (args.update) {
+    const entry = config.platforms[platformKey] || { cases: {} };
+    entry.node = process.versions.node;
+    entry.countingAllocator = counting;
+    entry.cases = Object.assign(entry.cases || {}, results);
+    config.platforms[platformKey] = entry;
+    fs.writeFileSync(BASELINE_FILE, JSON.stringify(config, null, 2) + '\n');
+    console.log(`\n✓ 已更新 ${path.relative(ROOT, BASELINE_FILE)} 中 ${platformKey} 的 ${selected.length} 个用例`);
+    return;
+  }
+
+  if (improvements.length > 0) {
+    console.log(`\n⬇ ${improvements.length} 项明显低于基线，确认后可运行 npm run test:memory:update 更新基线`);
+  }
+  if (missing.length > 0) {
+    console.log(`\nℹ️  ${platformKey} 缺少基线：${missing.join(', ')}`);
+    console.log('   运行 npm run test:memory:update 记录基线');
+    if (args.strict) process.exitCode = 1;
+  }
+  if (regressions.length > 0) {
+    console.error(`\n❌ 内存回归 ${regressions.length} 项：`);
+    regressions.forEach(item => console.error(`   - ${item}`));
+    process.exitCode = 1;
+    return;
+  }
+  console.log('\n✓ 未发现内存回归');
+}
+
+main().catch(err => {
+  console.error(`❌ ${err.message}`);
+  process.exit(1);
+});
@@ -1,14 +1,50 @@
 #include <napi.h>
 #include "xlsx_reader.h"
+#include "workbook_probe.h"
+#include "batch_reader.h"
+#include "xlsx_writer.h"
+#include "table_export.h"
+#include "row_filter.h"
+#include "sheet_index.h"
+#include "packed_result.h"
+#include "read_scheduler.h"
+#include "anchor_index.h"
+#include "alloc_counter.h"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 
 using namespace Napi;
 using namespace baja_xlsx;
 
+// Helper function to create a JS string from arena cell text
+String cellTextToString(Env env, CellText text) {
+    if (text.empty()) {
+        return String::New(env, "");
+    }
+    return String::New(env, text.data(), text.size());
+}
+
 // Helper function to create image object
 Object createImageObject(Env env, const ImageData& img) {
     Object imgObj = Object::New(env);
     imgObj.Set("name", String::New(env, img.name));
     imgObj.Set("type", String::New(env, img.type));
+    imgObj.Set("width", Number::New(env, img.width));
+    imgObj.Set("height", Number::New(env, img.height));
+    imgObj.Set("hash", String::New(env, img.hash));
+    if (!img.sha256.empty()) {
+        imgObj.Set("sha256", String::New(env, img.sha256));
+    }
+    
+    // Known payloads are identified by hash only
+    if (img.known) {
+        imgObj.Set("known", Boolean::New(env, true));
+        imgObj.Set("data", env.Null());
+        return imgObj;
+    }
     
     Buffer<uint8_t> buffer = Buffer<uint8_t>::Copy(env,
         img.data.data(),
@@ -25,6 +61,14 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
                     const std::vector<CellImageMapping>& cellImageMappings) {
     Array result = Array::New(env, sheets.size());
     
+    // Anchors are looked up per marker cell; index them once instead of
+    // scanning every position for every image cell
+    AnchorIndex anchorIndex(positions);
+    std::unordered_map<std::string, const ImageData*> imagesByName;
+    for (const auto& img : images) {
+        imagesByName.emplace(img.name, &img);
+    }
+    
     for (size_t i = 0; i < sheets.size(); ++i) {
         Object sheetObj = Object::New(env);
         sheetObj.Set("name", String::New(env, sheets[i].name));
@@ -33,7 +77,7 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
         for (size_t row = 0; row < sheets[i].data.size(); ++row) {
             Array rowArray = Array::New(env, sheets[i].data[row].size());
             for (size_t col = 0; col < sheets[i].data[row].size(); ++col) {
-                const std::string& cellValue = sheets[i].data[row][col];
+                CellText cellValue = sheets[i].data[row][col];
                 
                 // Check if this is an embedded image cell marker
                 // Format: __IMAGE_CELL__ or __IMAGE_CELL__:ID_xxx (WPS Excel)
@@ -44,7 +88,7 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
                     // Check if this is WPS Excel format with embedded ID
                     if (cellValue.find("__IMAGE_CELL__:") == 0) {
                         // Extract image ID (e.g., "ID_C6F9C8CE7BB34DB9B1BB9835C5297155")
-                        std::string imageId = cellValue.substr(15); // Skip "__IMAGE_CELL__:"
+                        CellText imageId = cellValue.substr(15); // Skip "__IMAGE_CELL__:"
                         
                         // Find the image name using cellImageMappings
                         for (const auto& mapping : cellImageMappings) {
@@ -55,24 +99,20 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
                         }
                     } else {
                         // Standard Excel format - find by position
-                        for (const auto& pos : positions) {
-                            if (pos.sheetName == sheets[i].name &&
-                                pos.fromRow == static_cast<int>(row) &&
-                                pos.fromCol == static_cast<int>(col)) {
-                                targetImageName = pos.imageName;
-                                break;
-                            }
+                        long anchor = anchorIndex.findAt(sheets[i].name,
+                                                         static_cast<int>(sheets[i].originalRow(row)),
+                                                         static_cast<int>(col));
+                        if (anchor >= 0) {
+                            targetImageName = positions[anchor].imageName;
                         }
                     }
                     
                     // Find the image by name
                     if (!targetImageName.empty()) {
-                        for (const auto& img : images) {
-                            if (img.name == targetImageName) {
-                                rowArray.Set(col, createImageObject(env, img));
-                                imageFound = true;
-                                break;
-                            }
+                        auto it = imagesByName.find(targetImageName);
+                        if (it != imagesByName.end()) {
+                            rowArray.Set(col, createImageObject(env, *it->second));
+                            imageFound = true;
                         }
                     }
                     
@@ -82,12 +122,35 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
                     }
                 } else {
                     // Normal cell - set string value
-                    rowArray.Set(col, String::New(env, cellValue));
+                    rowArray.Set(col, cellTextToString(env, cellValue));
                 }
             }
             dataArray.Set(row, rowArray);
         }
         
+        // Put an image into a cell; a cell that already holds one becomes an array
+        auto attachImage = [&](int targetRow, int targetCol, const ImageData& img) {
+            Array rowArray = dataArray.Get(targetRow).As<Array>();
+            Value currentValue = rowArray.Get(targetCol);
+            
+            if (currentValue.IsObject()) {
+                Object currentObj = currentValue.As<Object>();
+                if (currentObj.IsArray() || currentObj.Has("hash")) {
+                    Array imgArray;
+                    if (currentObj.IsArray()) {
+                        imgArray = currentObj.As<Array>();
+                    } else {
+                        imgArray = Array::New(env, 1);
+                        imgArray.Set(uint32_t(0), currentObj);
+                    }
+                    imgArray.Set(imgArray.Length(), createImageObject(env, img));
+                    rowArray.Set(targetCol, imgArray);
+                    return;
+                }
+            }
+            rowArray.Set(targetCol, createImageObject(env, img));
+        };
+        
         // After filling all cells, process floating images
         // Floating images are added to cells based on their top-left position
         for (const auto& pos : positions) {
@@ -98,94 +161,62 @@ Array sheetsToArray(Env env, const std::vector<SheetData>& sheets,
             // Check if this is a floating image (not embedded)
             // Embedded images have fromRow == toRow and fromCol == toCol
             bool isEmbedded = (pos.fromRow == pos.toRow && pos.fromCol == pos.toCol);
+            if (isEmbedded) {
+                continue;
+            }
             
-            if (!isEmbedded) {
-                // This is a floating image
-                // Only attach to the top-left cell
-                int targetRow = pos.fromRow;
-                int targetCol = pos.fromCol;
-                
-                // Check if row and col are valid
-                if (targetRow >= 0 && targetRow < static_cast<int>(sheets[i].data.size())) {
-                    if (targetCol >= 0 && targetCol < static_cast<int>(sheets[i].data[targetRow].size())) {
-                        // Find the image data
-                        bool found = false;
-                        
-                        // Try exact match first
-                        for (const auto& img : images) {
-                            if (img.name == pos.imageName) {
-                                // Get the row array
-                                Array rowArray = dataArray.Get(targetRow).As<Array>();
-                                Value currentValue = rowArray.Get(targetCol);
-                                
-                                // Check if this cell already has an image
-                                if (currentValue.IsObject()) {
-                                    Object currentObj = currentValue.As<Object>();
-                                    if (currentObj.Has("data") && currentObj.Get("data").IsBuffer()) {
-                                        // Cell already has an image, convert to array
-                                        Array imgArray;
-                                        if (currentObj.IsArray()) {
-                                            imgArray = currentObj.As<Array>();
-                                        } else {
-                                            imgArray = Array::New(env, 1);
-                                            imgArray.Set(uint32_t(0), currentObj);
-                                        }
-                                        // Add new image
-                                        imgArray.Set(imgArray.Length(), createImageObject(env, img));
-                                        rowArray.Set(targetCol, imgArray);
-                                    } else {
-                                        // Not an image object, replace with image
-                                        rowArray.Set(targetCol, createImageObject(env, img));
-                                    }
-                                } else {
-                                    // No image yet, set it
-                                    rowArray.Set(targetCol, createImageObject(env, img));
-                                }
-                                
-                                found = true;
-                                break;
-                            }
-                        }
-                        
-                        // If exact match fails, try fuzzy match
-                        if (!found) {
-                            for (const auto& img : images) {
-                                if (!pos.imageName.empty() && !img.name.empty() &&
-                                    (img.name.find(pos.imageName) != std::string::npos ||
-                                     pos.imageName.find(img.name) != std::string::npos)) {
-                                    
-                                    Array rowArray = dataArray.Get(targetRow).As<Array>();
-                                    Value currentValue = rowArray.Get(targetCol);
-                                    
-                                    if (currentValue.IsObject()) {
-                                        Object currentObj = currentValue.As<Object>();
-                                        if (currentObj.Has("data") && currentObj.Get("data").IsBuffer()) {
-                                            Array imgArray;
-                                            if (currentObj.IsArray()) {
-                                                imgArray = currentObj.As<Array>();
-                                            } else {
-                                                imgArray = Array::New(env, 1);
-                                                imgArray.Set(uint32_t(0), currentObj);
-                                            }
-                                            imgArray.Set(imgArray.Length(), createImageObject(env, img));
-                                            rowArray.Set(targetCol, imgArray);
-                                        } else {
-                                            rowArray.Set(targetCol, createImageObject(env, img));
-                                        }
-                                    } else {
-                                        rowArray.Set(targetCol, createImageObject(env, img));
-                                    }
-                                    
-                                    break;
-                                }
-                            }
-                        }
-                    }
+            // Only attach to the top-left cell
+            int targetRow = sheets[i].findRow(pos.fromRow);
+            int targetCol = pos.fromCol;
+            
+            // Check if row and col are valid
+            if (targetRow < 0 || targetRow >= static_cast<int>(sheets[i].data.size()) ||
+                targetCol < 0 || targetCol >= static_cast<int>(sheets[i].data[targetRow].size())) {
+                continue;
+            }
+            
+            // Try exact match first
+            auto exact = imagesByName.find(pos.imageName);
+            if (exact != imagesByName.end()) {
+                attachImage(targetRow, targetCol, *exact->second);
+                continue;
+            }
+            
+            // If exact match fails, try fuzzy match
+            for (const auto& img : images) {
+                if (!pos.imageName.empty() && !img.name.empty() &&
+                    (img.name.find(pos.imageName) != std::string::npos ||
+                     pos.imageName.find(img.name) != std::string::npos)) {
+                    attachImage(targetRow, targetCol, img);
+                    break;
                 }
             }
         }
         
         sheetObj.Set("data", dataArray);
+        
+        // Filtered sheets: original row index of every entry in data
+        if (!sheets[i].rowIndex.empty()) {
+            Array rowIndex = Array::New(env, sheets[i].rowIndex.size());
+            for (size_t row = 0; row < sheets[i].rowIndex.size(); ++row) {
+                rowIndex.Set(row, Number::New(env, sheets[i].rowIndex[row]));
+            }
+            sheetObj.Set("rowIndex", rowIndex);
+        }
+        
+        // Inferred column types, when schemaRows was given
+        if (!sheets[i].columns.empty()) {
+            Array schema = Array::New(env, sheets[i].columns.size());
+            for (size_t col = 0; col < sheets[i].columns.size(); ++col) {
+                const ColumnSchema& column = sheets[i].columns[col];
+                Object columnObj = Object::New(env);
+                columnObj.Set("type", String::New(env, columnTypeName(column.type)));
+                columnObj.Set("samples", Number::New(env, column.samples));
+                columnObj.Set("fallbacks", Number::New(env, static_cast<double>(column.fallbacks)));
+                schema.Set(col, columnObj);
+            }
+            sheetObj.Set("schema", schema);
+        }
         result.Set(i, sheetObj);
     }
     
@@ -196,16 +227,7 @@ Array imagesToArray(Env env, const std::vector<ImageData>& images) {
     Array result = Array::New(env, images.size());
     
     for (size_t i = 0; i < images.size(); ++i) {
-        Object imgObj = Object::New(env);
-        imgObj.Set("name", String::New(env, images[i].name));
-        imgObj.Set("type", String::New(env, images[i].type));
-        
-        Buffer<uint8_t> buffer = Buffer<uint8_t>::Copy(env, 
-            images[i].data.data(), 
-            images[i].data.size());
-        imgObj.Set("data", buffer);
-        
-        result.Set(i, imgObj);
+        result.Set(i, createImageObject(env, images[i]));
     }
     
     return result;
@@ -222,11 +244,15 @@ Array positionsToArray(Env env, const std::vector<ImagePosition>& positions) {
         Object fromObj = Object::New(env);
         fromObj.Set("col", Number::New(env, positions[i].fromCol));
         fromObj.Set("row", Number::New(env, positions[i].fromRow));
+        fromObj.Set("colOff", Number::New(env, static_cast<double>(positions[i].fromColOff)));
+        fromObj.Set("rowOff", Number::New(env, static_cast<double>(positions[i].fromRowOff)));
         posObj.Set("from", fromObj);
         
         Object toObj = Object::New(env);
         toObj.Set("col", Number::New(env, positions[i].toCol));
         toObj.Set("row", Number::New(env, positions[i].toRow));
+        toObj.Set("colOff", Number::New(env, static_cast<double>(positions[i].toColOff)));
+        toObj.Set("rowOff", Number::New(env, static_cast<double>(positions[i].toRowOff)));
         posObj.Set("to", toObj);
         
         result.Set(i, posObj);
@@ -235,6 +261,280 @@ Array positionsToArray(Env env, const std::vector<ImagePosition>& positions) {
     return result;
 }
 
+// Helper function to read one literal of a filter condition
+bool parseFilterValue(const Value& value, FilterValue& out) {
+    if (value.IsNumber()) {
+        out.isNumber = true;
+        out.number = value.As<Number>().DoubleValue();
+        return true;
+    }
+    if (value.IsBoolean()) {
+        out.text = value.As<Boolean>().Value() ? "true" : "false";
+        return true;
+    }
+    if (value.IsString()) {
+        out.text = value.As<String>().Utf8Value();
+        return true;
+    }
+    return false;
+}
+
+// Helper function to read options.filter:
+// [{ column, eq?, in?, min?, max?, nonEmpty? }], every key present adds a condition.
+// A malformed entry throws a TypeError naming it (and returns null) rather than
+// being dropped, which would quietly widen the filter to every row.
+std::shared_ptr<const RowFilter> parseRowFilter(Env env, const Object& obj) {
+    Value filterValue = obj.Get("filter");
+    if (filterValue.IsUndefined() || filterValue.IsNull()) {
+        return nullptr;
+    }
+    if (!filterValue.IsArray()) {
+        TypeError::New(env, "filter must be an array of conditions").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    
+    auto fail = [&env](const std::string& message) -> std::shared_ptr<const RowFilter> {
+        TypeError::New(env, message).ThrowAsJavaScriptException();
+        return nullptr;
+    };
+    auto present = [](const Value& value) {
+        return !value.IsUndefined();
+    };
+    
+    auto filter = std::make_shared<RowFilter>();
+    Array entries = filterValue.As<Array>();
+    for (uint32_t i = 0; i < entries.Length(); ++i) {
+        std::string name = "filter[" + std::to_string(i) + "]";
+        Value entryValue = entries.Get(i);
+        if (!entryValue.IsObject() || entryValue.IsArray()) {
+            return fail(name + " must be an object");
+        }
+        Object entry = entryValue.As<Object>();
+        
+        // Misspelled keys ({ equals: ... }) would otherwise leave the entry without a condition
+        Array keys = entry.GetPropertyNames();
+        for (uint32_t k = 0; k < keys.Length(); ++k) {
+            std::string key = keys.Get(k).ToString().Utf8Value();
+            if (key != "column" && key != "eq" && key != "in" && key != "min" && key != "max" && key != "nonEmpty") {
+                return fail(name + " has unknown key \"" + key + "\" (expected column, eq, in, min, max or nonEmpty)");
+            }
+        }
+        
+        RowCondition base;
+        Value column = entry.Get("column");
+        if (column.IsNumber()) {
+            double index = column.As<Number>().DoubleValue();
+            if (!(index >= 0) || index != std::floor(index) || index > INT32_MAX) {
+                return fail(name + ".column must be a column index >= 0 or a header name");
+            }
+            base.columnIndex = static_cast<int>(index);
+        } else if (column.IsString()) {
+            base.column = column.As<String>().Utf8Value();
+        } else {
+            return fail(name + ".column must be a column index >= 0 or a header name");
+        }
+        
+        Value eq = entry.Get("eq");
+        Value in = entry.Get("in");
+        Value min = entry.Get("min");
+        Value max = entry.Get("max");
+        Value nonEmpty = entry.Get("nonEmpty");
+        if (!present(eq) && !present(in) && !present(min) && !present(max) && !present(nonEmpty)) {
+            return fail(name + " has no condition (eq, in, min, max or nonEmpty)");
+        }
+        
+        if (present(eq)) {
+            RowCondition condition = base;
+            condition.op = RowCondition::Equals;
+            condition.values.emplace_back();
+            if (!parseFilterValue(eq, condition.values.back())) {
+                return fail(name + ".eq must be a string, number or boolean");
+            }
+            filter->conditions.push_back(condition);
+        }
+        
+        if (present(in)) {
+            if (!in.IsArray() || in.As<Array>().Length() == 0) {
+                return fail(name + ".in must be a non-empty array");
+            }
+            RowCondition condition = base;
+            condition.op = RowCondition::In;
+            Array values = in.As<Array>();
+            for (uint32_t k = 0; k < values.Length(); ++k) {
+                condition.values.emplace_back();
+                if (!parseFilterValue(values.Get(k), condition.values.back())) {
+                    return fail(name + ".in[" + std::to_string(k) + "] must be a string, number or boolean");
+                }
+            }
+            filter->conditions.push_back(condition);
+        }
+        
+        if (present(min) || present(max)) {
+            RowCondition range = base;
+            range.op = RowCondition::Range;
+            range.hasMin = present(min);
+            range.hasMax = present(max);
+            if (range.hasMin && !parseFilterValue(min, range.min)) {
+                return fail(name + ".min must be a string, number or boolean");
+            }
+            if (range.hasMax && !parseFilterValue(max, range.max)) {
+                return fail(name + ".max must be a string, number or boolean");
+            }
+            filter->conditions.push_back(range);
+        }
+        
+        if (present(nonEmpty)) {
+            if (!nonEmpty.IsBoolean()) {
+                return fail(name + ".nonEmpty must be a boolean");
+            }
+            if (nonEmpty.As<Boolean>().Value()) {
+                RowCondition condition = base;
+                condition.op = RowCondition::NonEmpty;
+                filter->conditions.push_back(condition);
+            }
+        }
+    }
+    if (!filter->enabled()) {
+        return nullptr;
+    }
+    
+    // Names resolve against the same header row the table conversion uses
+    if (obj.Get("sheetName").IsString()) {
+        filter->sheetName = obj.Get("sheetName").As<String>().Utf8Value();
+    }
+    if (obj.Get("headerRow").IsNumber()) {
+        filter->headerRow = obj.Get("headerRow").As<Number>().Int32Value();
+    }
+    if (obj.Get("headerMap").IsObject()) {
+        Object headerMap = obj.Get("headerMap").As<Object>();
+        Array keys = headerMap.GetPropertyNames();
+        for (uint32_t i = 0; i < keys.Length(); ++i) {
+            std::string key = keys.Get(i).ToString().Utf8Value();
+            Value mapped = headerMap.Get(key);
+            if (mapped.IsString()) {
+                filter->headerMap[key] = mapped.As<String>().Utf8Value();
+            }
+        }
+    }
+    return filter;
+}
+
+// Helper function to read the options object shared by readExcel / readMany.
+// Throws a TypeError for a malformed filter; callers check env.IsExceptionPending()
+ReadOptions parseReadOptions(Env env, const Value& value) {
+    ReadOptions options;
+    if (!value.IsObject()) {
+        return options;
+    }
+    
+    Object obj = value.As<Object>();
+    
+    Value sha256 = obj.Get("sha256");
+    if (sha256.IsBoolean()) {
+        options.computeSha256 = sha256.As<Boolean>().Value();
+    }
+    
+    Value knownHashes = obj.Get("knownHashes");
+    if (knownHashes.IsArray()) {
+        Array hashes = knownHashes.As<Array>();
+        for (uint32_t i = 0; i < hashes.Length(); ++i) {
+            Value hash = hashes.Get(i);
+            if (hash.IsString()) {
+                options.knownHashes.insert(hash.As<String>().Utf8Value());
+            }
+        }
+    }
+
+    Value limits = obj.Get("limits");
+    if (limits.IsObject()) {
+        Object limitsObj = limits.As<Object>();
+        auto readLimit = [&limitsObj](const char* key) -> double {
+            Value value = limitsObj.Get(key);
+            return value.IsNumber() && value.As<Number>().DoubleValue() > 0 ? value.As<Number>().DoubleValue() : 0;
+        };
+        options.limits.maxUncompressedSize = static_cast<uint64_t>(readLimit("maxUncompressedSize"));
+        options.limits.maxEntrySize = static_cast<uint64_t>(readLimit("maxEntrySize"));
+        options.limits.maxCompressionRatio = readLimit("maxCompressionRatio");
+        options.limits.maxCells = static_cast<uint64_t>(readLimit("maxCells"));
+        options.limits.maxImages = static_cast<uint64_t>(readLimit("maxImages"));
+    }
+
+    Value valuesOnly = obj.Get("valuesOnly");
+    if (valuesOnly.IsBoolean()) {
+        options.valuesOnly = valuesOnly.As<Boolean>().Value();
+    }
+
+    Value parseThreads = obj.Get("parseThreads");
+    if (parseThreads.IsNumber() && parseThreads.As<Number>().Int32Value() > 0) {
+        options.parseThreads = static_cast<size_t>(parseThreads.As<Number>().Int32Value());
+    }
+
+    Value dates = obj.Get("dates");
+    if (dates.IsString()) {
+        options.isoDates = dates.As<String>().Utf8Value() == "iso";
+    }
+
+    options.filter = parseRowFilter(env, obj);
+    if (env.IsExceptionPending()) {
+        return options;
+    }
+
+    Value cacheDir = obj.Get("cacheDir");
+    if (cacheDir.IsString()) {
+        options.cacheDir = cacheDir.As<String>().Utf8Value();
+    }
+
+    // Sampling starts below the header row of the table conversion
+    Value schemaRows = obj.Get("schemaRows");
+    if (schemaRows.IsNumber() && schemaRows.As<Number>().Int32Value() > 0) {
+        options.schemaRows = static_cast<size_t>(schemaRows.As<Number>().Int32Value());
+        Value headerRow = obj.Get("headerRow");
+        if (headerRow.IsNumber() && headerRow.As<Number>().Int32Value() >= 0) {
+            options.schemaStartRow = static_cast<size_t>(headerRow.As<Number>().Int32Value()) + 1;
+        } else {
+            options.schemaStartRow = 1;
+        }
+    }
+
+    return options;
+}
+
+// Helper function to report native memory to V8, so that heap-based GC
+// scheduling sees memory that JS objects keep alive
+void adjustExternalMemory(Env env, int64_t bytes) {
+    if (bytes == 0) return;
+    MemoryManagement::AdjustExternalMemory(env, bytes);
+    NativeMemory::addExternal(bytes);
+}
+
+// Reports a native allocation to V8 for the lifetime of the scope
+class ExternalMemoryScope {
+public:
+    ExternalMemoryScope(Env env, int64_t bytes) : env_(env), bytes_(bytes) {
+        adjustExternalMemory(env_, bytes_);
+    }
+    ~ExternalMemoryScope() {
+        adjustExternalMemory(env_, -bytes_);
+    }
+
+private:
+    Env env_;
+    int64_t bytes_;
+};
+
+// Helper function to build the readExcel result object
+Object excelDataToObject(Env env, const ExcelData& data) {
+    // The arena and image payloads stay alive while the JS result is built;
+    // let V8 count them so a collection can run before the heap grows further
+    ExternalMemoryScope external(env, data.nativeBytes());
+    
+    Object result = Object::New(env);
+    result.Set("sheets", sheetsToArray(env, data.sheets, data.images, data.imagePositions, data.cellImageMappings));
+    result.Set("images", imagesToArray(env, data.images));
+    result.Set("imagePositions", positionsToArray(env, data.imagePositions));
+    return result;
+}
+
 // ReadExcel function - reads complete Excel data
 Value ReadExcel(const CallbackInfo& info) {
     Env env = info.Env();
@@ -245,21 +545,57 @@ Value ReadExcel(const CallbackInfo& info) {
     }
     
     std::string filepath = info[0].As<String>().Utf8Value();
+    ReadOptions options = parseReadOptions(env, info.Length() > 1 ? info[1] : env.Undefined());
+    if (env.IsExceptionPending()) {
+        return env.Null();
+    }
     
     XlsxReader reader;
-    ExcelData data = reader.readExcel(filepath);
+    ExcelData data = reader.readExcel(filepath, options);
     
     if (!reader.getLastError().empty()) {
         Error::New(env, reader.getLastError()).ThrowAsJavaScriptException();
         return env.Null();
     }
     
-    Object result = Object::New(env);
-    result.Set("sheets", sheetsToArray(env, data.sheets, data.images, data.imagePositions, data.cellImageMappings));
-    result.Set("images", imagesToArray(env, data.images));
-    result.Set("imagePositions", positionsToArray(env, data.imagePositions));
+    return excelDataToObject(env, data);
+}
+
+// ReadPacked function - reads like readExcel but returns the result packed into
+// one ArrayBuffer (see packed_result.h), cheap to transfer between threads
+Value ReadPacked(const CallbackInfo& info) {
+    Env env = info.Env();
     
-    return result;
+    if (info.Length() < 1 || !info[0].IsString()) {
+        TypeError::New(env, "String expected for filepath").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string filepath = info[0].As<String>().Utf8Value();
+    ReadOptions options = parseReadOptions(env, info.Length() > 1 ? info[1] : env.Undefined());
+    if (env.IsExceptionPending()) {
+        return env.Null();
+    }
+    
+    XlsxReader reader;
+    ExcelData data = reader.readExcel(filepath, options);
+    
+    if (!reader.getLastError().empty()) {
+        Error::New(env, reader.getLastError()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    PackedResult packed;
+    if (!packed.prepare(data)) {
+        Error::New(env, packed.getLastError()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // Packed straight into V8-owned memory: the buffer is the only copy and
+    // postMessage can transfer it without cloning
+    ArrayBuffer buffer = ArrayBuffer::New(env, packed.size());
+    packed.write(data, static_cast<uint8_t*>(buffer.Data()));
+    return buffer;
 }
 
 // ExtractImages function - only extracts images
@@ -289,10 +625,747 @@ Value ExtractImages(const CallbackInfo& info) {
     return imagesToArray(env, images);
 }
 
+// Probe function - reads workbook metadata without loading cells
+Value Probe(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        TypeError::New(env, "String expected for filepath").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string filepath = info[0].As<String>().Utf8Value();
+    
+    WorkbookProbe prober;
+    WorkbookProbeResult probe;
+    if (!prober.probe(filepath, probe)) {
+        Error::New(env, prober.getLastError()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Array sheets = Array::New(env, probe.sheets.size());
+    for (size_t i = 0; i < probe.sheets.size(); ++i) {
+        const SheetProbe& sheet = probe.sheets[i];
+        
+        Object sheetObj = Object::New(env);
+        sheetObj.Set("name", String::New(env, sheet.name));
+        sheetObj.Set("state", String::New(env, sheet.state));
+        sheetObj.Set("dimension", String::New(env, sheet.dimension));
+        sheetObj.Set("rowCount", Number::New(env, sheet.rowCount));
+        sheetObj.Set("columnCount", Number::New(env, sheet.columnCount));
+        sheetObj.Set("imageCount", Number::New(env, sheet.imageCount));
+        sheetObj.Set("compressedSize", Number::New(env, static_cast<double>(sheet.compressedSize)));
+        sheetObj.Set("uncompressedSize", Number::New(env, static_cast<double>(sheet.uncompressedSize)));
+        sheets.Set(i, sheetObj);
+    }
+    
+    Object result = Object::New(env);
+    result.Set("sheets", sheets);
+    result.Set("imageCount", Number::New(env, probe.imageCount));
+    result.Set("cellImageCount", Number::New(env, probe.cellImageCount));
+    result.Set("entryCount", Number::New(env, static_cast<double>(probe.entryCount)));
+    result.Set("compressedSize", Number::New(env, static_cast<double>(probe.compressedSize)));
+    result.Set("uncompressedSize", Number::New(env, static_cast<double>(probe.uncompressedSize)));
+    result.Set("mediaSize", Number::New(env, static_cast<double>(probe.mediaSize)));
+    
+    return result;
+}
+
+// ExportTable function - serializes one sheet as CSV / NDJSON without building JS objects
+// exportTable(filepath, options) -> Buffer, or the number of bytes written when options.fd is set
+Value ExportTable(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+        TypeError::New(env, "Expected (filepath: string, options: object)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string filepath = info[0].As<String>().Utf8Value();
+    Object obj = info[1].As<Object>();
+    
+    ExportOptions exportOptions;
+    if (obj.Get("format").IsString() && obj.Get("format").As<String>().Utf8Value() == "ndjson") {
+        exportOptions.format = ExportOptions::NDJSON;
+    }
+    if (obj.Get("sheetName").IsString()) {
+        exportOptions.sheetName = obj.Get("sheetName").As<String>().Utf8Value();
+    }
+    if (obj.Get("headerRow").IsNumber()) {
+        exportOptions.headerRow = obj.Get("headerRow").As<Number>().Int32Value();
+    }
+    if (obj.Get("skipRows").IsArray()) {
+        Array skipRows = obj.Get("skipRows").As<Array>();
+        for (uint32_t i = 0; i < skipRows.Length(); ++i) {
+            Value row = skipRows.Get(i);
+            if (row.IsNumber()) {
+                exportOptions.skipRows.insert(row.As<Number>().Int32Value());
+            }
+        }
+    }
+    if (obj.Get("headerMap").IsObject()) {
+        Object headerMap = obj.Get("headerMap").As<Object>();
+        Array keys = headerMap.GetPropertyNames();
+        for (uint32_t i = 0; i < keys.Length(); ++i) {
+            Value key = keys.Get(i);
+            Value mapped = headerMap.Get(key);
+            if (mapped.IsString()) {
+                exportOptions.headerMap[key.ToString().Utf8Value()] = mapped.As<String>().Utf8Value();
+            }
+        }
+    }
+    if (obj.Get("images").IsString() && obj.Get("images").As<String>().Utf8Value() == "base64") {
+        exportOptions.images = ExportOptions::ImageBase64;
+    }
+    if (obj.Get("delimiter").IsString()) {
+        std::string delimiter = obj.Get("delimiter").As<String>().Utf8Value();
+        if (delimiter.size() != 1) {
+            TypeError::New(env, "delimiter must be a single character").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        exportOptions.delimiter = delimiter[0];
+    }
+    if (obj.Get("header").IsBoolean()) {
+        exportOptions.includeHeader = obj.Get("header").As<Boolean>().Value();
+    }
+    
+    ReadOptions options = parseReadOptions(env, obj);
+    if (env.IsExceptionPending()) {
+        return env.Null();
+    }
+    
+    XlsxReader reader;
+    ExcelData data = reader.readExcel(filepath, options);
+    
+    if (!reader.getLastError().empty()) {
+        Error::New(env, reader.getLastError()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    TableExporter exporter(exportOptions);
+    
+    if (obj.Get("fd").IsNumber()) {
+        size_t written = 0;
+        if (!exporter.exportToFd(data, obj.Get("fd").As<Number>().Int32Value(), written)) {
+            Error::New(env, exporter.getLastError()).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        return Number::New(env, static_cast<double>(written));
+    }
+    
+    std::string* output = new std::string();
+    if (!exporter.exportToString(data, *output)) {
+        delete output;
+        Error::New(env, exporter.getLastError()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    // Hand the string's storage to the Buffer instead of copying it; it is
+    // native memory owned by a JS object until the Buffer is collected
+    int64_t bytes = static_cast<int64_t>(output->capacity());
+    NativeMemory::add(bytes);
+    adjustExternalMemory(env, bytes);
+    return Buffer<char>::New(env, &(*output)[0], output->size(),
+        [bytes](Env env, char*, std::string* owned) {
+            delete owned;
+            NativeMemory::add(-bytes);
+            adjustExternalMemory(env, -bytes);
+        }, output);
+}
+
+// Helper function to create the Error for a failed read; cancelled reads
+// reject with an AbortError like other AbortSignal-aware Node APIs
+Value readErrorToValue(Env env, const std::string& message) {
+    Error error = Error::New(env, message);
+    if (message == kReadAbortedError) {
+        error.Set("name", String::New(env, "AbortError"));
+        error.Set("code", String::New(env, "ABORT_ERR"));
+    }
+    return error.Value();
+}
+
+// Helper function to wrap a running job as { promise, cancel }
+Object createJobHandle(Env env, Promise promise, std::shared_ptr<ReadControl> control) {
+    Object handle = Object::New(env);
+    handle.Set("promise", promise);
+    handle.Set("cancel", Function::New(env, [control](const CallbackInfo& info) {
+        control->cancel();
+    }, "cancel"));
+    return handle;
+}
+
+// Helper function to create the object passed to onProgress
+Object progressToObject(Env env, const ReadProgress& progress) {
+    static const char* const kPhaseNames[] = { "load", "sheets", "images" };
+    
+    Object obj = Object::New(env);
+    obj.Set("phase", String::New(env, kPhaseNames[progress.phase]));
+    obj.Set("bytesRead", Number::New(env, static_cast<double>(progress.bytesRead)));
+    obj.Set("sheetsDone", Number::New(env, progress.sheetsDone));
+    obj.Set("sheetCount", Number::New(env, progress.sheetCount));
+    obj.Set("rowsDone", Number::New(env, static_cast<double>(progress.rowsDone)));
+    obj.Set("bytesInflated", Number::New(env, static_cast<double>(progress.bytesInflated)));
+    return obj;
+}
+
+// State shared by the worker thread and the JS thread for one readExcelAsync() call
+struct ReadJob {
+    std::thread worker;
+    std::shared_ptr<ReadControl> control;
+    ThreadSafeFunction tsfn;
+    Promise::Deferred deferred;
+    ExcelData data;
+    std::string error;
+    
+    explicit ReadJob(Env env) : deferred(Promise::Deferred::New(env)) {}
+};
+
+// ReadExcelAsync function - reads one file on a native thread
+// readExcelAsync(filepath, options?, onProgress?) -> { promise, cancel }
+// onProgress receives { phase, bytesRead, sheetsDone, sheetCount, rowsDone, bytesInflated }
+// at most every 100 ms; cancel() stops the read and rejects the promise with an AbortError.
+Value ReadExcelAsync(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        TypeError::New(env, "String expected for filepath").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string filepath = info[0].As<String>().Utf8Value();
+    ReadOptions options = parseReadOptions(env, info.Length() > 1 ? info[1] : env.Undefined());
+    if (env.IsExceptionPending()) {
+        return env.Null();
+    }
+    bool hasProgress = info.Length() > 2 && info[2].IsFunction();
+    
+    ReadJob* job = new ReadJob(env);
+    job->control = std::make_shared<ReadControl>();
+    options.control = job->control;
+    Promise promise = job->deferred.Promise();
+    
+    job->tsfn = ThreadSafeFunction::New(env, hasProgress ? info[2].As<Function>() : Function(),
+        "baja_xlsx.readExcelAsync", 0, 1,
+        [job](Env env) {
+            job->worker.join();
+            if (job->control->cancelled()) {
+                job->deferred.Reject(readErrorToValue(env, kReadAbortedError));
+            } else if (!job->error.empty()) {
+                job->deferred.Reject(readErrorToValue(env, job->error));
+            } else {
+                job->deferred.Resolve(excelDataToObject(env, job->data));
+            }
+            delete job;
+        });
+    
+    if (hasProgress) {
+        job->control->setProgressCallback([job](const ReadProgress& progress) {
+            // Progress is best effort: a report that cannot be queued is dropped
+            ReadProgress* payload = new ReadProgress(progress);
+            napi_status status = job->tsfn.NonBlockingCall(payload, [](Env env, Function onProgress, ReadProgress* item) {
+                Object progressObj = progressToObject(env, *item);
+                delete item;
+                onProgress.Call({progressObj});
+            });
+            if (status != napi_ok) {
+                delete payload;
+            }
+        }, std::chrono::milliseconds(100));
+    }
+    
+    job->worker = std::thread([job, filepath, options]() {
+        XlsxReader reader;
+        job->data = reader.readExcel(filepath, options);
+        job->error = reader.getLastError();
+        
+        // A cancelled read releases everything it built before JS sees the result
+        if (job->control->cancelled()) {
+            job->data = ExcelData();
+        }
+        job->tsfn.Release();
+    });
+    
+    return createJobHandle(env, promise, job->control);
+}
+
+// State shared by the worker threads and the JS thread for one readMany() call
+// Owned by the tsfn finalizer and the JS handle; workers use it through a raw
+// pointer, which stays valid until the finalizer has joined them.
+struct BatchJob {
+    std::unique_ptr<BatchReader> reader;
+    ThreadSafeFunction tsfn;
+    Promise::Deferred deferred;
+    bool finished;   // finalizer ran; touched on the JS thread only
+    
+    explicit BatchJob(Env env) : deferred(Promise::Deferred::New(env)), finished(false) {}
+};
+
+// ReadMany function - reads many files on a native thread pool
+// readMany(paths, concurrency, onResult(err, index, data), options?) -> { promise, cancel, pause, resume }
+// Results are delivered in completion order; the promise resolves after the last one.
+// cancel() stops handing out files and aborts the reads in progress. pause() keeps
+// workers from starting new files (reads in progress still deliver) and lets the
+// process exit while paused; resume() undoes it.
+Value ReadMany(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() < 3 || !info[0].IsArray() || !info[1].IsNumber() || !info[2].IsFunction()) {
+        TypeError::New(env, "Expected (paths: string[], concurrency: number, onResult: Function)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Array pathArray = info[0].As<Array>();
+    std::vector<std::string> paths;
+    paths.reserve(pathArray.Length());
+    for (uint32_t i = 0; i < pathArray.Length(); ++i) {
+        Value path = pathArray.Get(i);
+        if (!path.IsString()) {
+            TypeError::New(env, "String expected for every filepath").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        paths.push_back(path.As<String>().Utf8Value());
+    }
+    
+    int32_t concurrency = info[1].As<Number>().Int32Value();
+    ReadOptions options = parseReadOptions(env, info.Length() > 3 ? info[3] : env.Undefined());
+    if (env.IsExceptionPending()) {
+        return env.Null();
+    }
+    std::shared_ptr<ReadControl> control = std::make_shared<ReadControl>();
+    options.control = control;
+    
+    std::shared_ptr<BatchJob> job = std::make_shared<BatchJob>(env);
+    BatchJob* worker = job.get();
+    job->reader.reset(new BatchReader(std::move(paths), concurrency > 0 ? static_cast<size_t>(concurrency) : 0, options));
+    Promise promise = job->deferred.Promise();
+    
+    // Bounded queue: workers block once the JS thread falls behind on conversion
+    size_t queueSize = job->reader->threadCount() * 2;
+    job->tsfn = ThreadSafeFunction::New(env, info[2].As<Function>(), "baja_xlsx.readMany",
+        queueSize, job->reader->threadCount(),
+        [job](Env env) {
+            // Also runs at environment teardown, possibly while workers are paused
+            // or still reading: stop them so join() cannot block forever
+            job->reader->cancel();
+            job->reader->resume();
+            job->reader->join();
+            job->finished = true;
+            job->deferred.Resolve(env.Undefined());
+        });
+    
+    job->reader->start(
+        [worker](BatchItemResult&& itemResult) {
+            BatchItemResult* payload = new BatchItemResult(std::move(itemResult));
+            napi_status status = worker->tsfn.BlockingCall(payload, [](Env env, Function onResult, BatchItemResult* item) {
+                Value error = env.Null();
+                Value data = env.Null();
+                if (!item->error.empty()) {
+                    error = readErrorToValue(env, item->error);
+                } else {
+                    data = excelDataToObject(env, item->data);
+                }
+                
+                // Free the native result before calling back into JS
+                size_t index = item->index;
+                delete item;
+                
+                onResult.Call({error, Number::New(env, static_cast<double>(index)), data});
+            });
+            if (status != napi_ok) {
+                delete payload;
+                return false;
+            }
+            return true;
+        },
+        [worker]() {
+            worker->tsfn.Release();
+        });
+    
+    Object handle = createJobHandle(env, promise, control);
+    handle.Set("cancel", Function::New(env, [job](const CallbackInfo& info) {
+        job->reader->cancel();
+    }, "cancel"));
+    handle.Set("pause", Function::New(env, [job](const CallbackInfo& info) {
+        if (job->finished) return;
+        job->reader->pause();
+        job->tsfn.Unref(info.Env());
+    }, "pause"));
+    handle.Set("resume", Function::New(env, [job](const CallbackInfo& info) {
+        if (job->finished) return;
+        job->reader->resume();
+        job->tsfn.Ref(info.Env());
+    }, "resume"));
+    return handle;
+}
+
+// Streaming writer exposed to JS as `new addon.XlsxWriter(filepath)`
+class XlsxWriterWrap : public ObjectWrap<XlsxWriterWrap> {
+public:
+    static Function DefineClass(Napi::Env env) {
+        return ObjectWrap<XlsxWriterWrap>::DefineClass(env, "XlsxWriter", {
+            InstanceMethod("addSheet", &XlsxWriterWrap::AddSheet),
+            InstanceMethod("writeRow", &XlsxWriterWrap::WriteRow),
+            InstanceMethod("addImage", &XlsxWriterWrap::AddImage),
+            InstanceMethod("close", &XlsxWriterWrap::Close)
+        });
+    }
+
+    XlsxWriterWrap(const CallbackInfo& info) : ObjectWrap<XlsxWriterWrap>(info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            TypeError::New(env, "String expected for filepath").ThrowAsJavaScriptException();
+            return;
+        }
+
+        if (!writer_.open(info[0].As<String>().Utf8Value())) {
+            Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+        }
+    }
+
+    ~XlsxWriterWrap() {
+        syncMemory(Env(), 0);
+    }
+
+private:
+    // The shared string table grows with the data written; report it in 1 MB steps
+    static constexpr int64_t kMemoryReportStep = 1024 * 1024;
+
+    void syncMemory(Napi::Env env, int64_t step) {
+        int64_t delta = static_cast<int64_t>(writer_.memoryUsage()) - reportedBytes_;
+        if (delta == 0 || (delta > -step && delta < step)) return;
+        NativeMemory::add(delta);
+        adjustExternalMemory(env, delta);
+        reportedBytes_ += delta;
+    }
+
+    Napi::Value AddSheet(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            TypeError::New(env, "String expected for sheet name").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        if (!writer_.addSheet(info[0].As<String>().Utf8Value())) {
+            Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+        }
+        return env.Undefined();
+    }
+
+    // writeRow(values) - values are string | number | boolean | null | { data: Buffer }
+    // Image values are placed in their cell; the cell itself is left empty
+    Napi::Value WriteRow(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            TypeError::New(env, "Array expected for row values").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        Array values = info[0].As<Array>();
+        std::vector<WriteCell> cells(values.Length());
+        std::vector<std::pair<int, Buffer<uint8_t>>> cellImages;
+
+        for (uint32_t col = 0; col < values.Length(); ++col) {
+            Napi::Value value = values.Get(col);
+            WriteCell& cell = cells[col];
+
+            if (value.IsString()) {
+                cell.type = WriteCell::String;
+                cell.text = value.As<String>().Utf8Value();
+            } else if (value.IsNumber()) {
+                cell.type = WriteCell::Number;
+                cell.number = value.As<Number>().DoubleValue();
+            } else if (value.IsBoolean()) {
+                cell.type = WriteCell::Boolean;
+                cell.boolean = value.As<Boolean>().Value();
+            } else if (value.IsBuffer()) {
+                cellImages.emplace_back(static_cast<int>(col), value.As<Buffer<uint8_t>>());
+            } else if (value.IsObject() && value.As<Object>().Get("data").IsBuffer()) {
+                cellImages.emplace_back(static_cast<int>(col), value.As<Object>().Get("data").As<Buffer<uint8_t>>());
+            } else if (!value.IsNull() && !value.IsUndefined()) {
+                cell.type = WriteCell::String;
+                cell.text = value.ToString().Utf8Value();
+            }
+        }
+
+        int row = writer_.currentRow();
+        if (!writer_.writeRow(cells)) {
+            Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        for (auto& image : cellImages) {
+            WriteImageAnchor anchor;
+            anchor.fromCol = image.first;
+            anchor.fromRow = row;
+            if (!writer_.addImage(image.second.Data(), image.second.Length(), anchor)) {
+                Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+
+        syncMemory(env, kMemoryReportStep);
+        return env.Undefined();
+    }
+
+    // addImage(buffer, { col, row, toCol?, toRow? }) - 0-based cell coordinates
+    Napi::Value AddImage(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsObject()) {
+            TypeError::New(env, "Expected (image: Buffer, anchor: { col, row, toCol?, toRow? })").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        Buffer<uint8_t> image = info[0].As<Buffer<uint8_t>>();
+        Object anchorObj = info[1].As<Object>();
+
+        WriteImageAnchor anchor;
+        auto readInt = [&anchorObj](const char* key, int& out) {
+            Napi::Value value = anchorObj.Get(key);
+            if (value.IsNumber()) {
+                out = value.As<Number>().Int32Value();
+            }
+        };
+        readInt("col", anchor.fromCol);
+        readInt("row", anchor.fromRow);
+        readInt("toCol", anchor.toCol);
+        readInt("toRow", anchor.toRow);
+
+        if (anchor.fromCol < 0 || anchor.fromRow < 0) {
+            RangeError::New(env, "Image anchor col/row must be >= 0").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        if (!writer_.addImage(image.Data(), image.Length(), anchor)) {
+            Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+        }
+        return env.Undefined();
+    }
+
+    Napi::Value Close(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        bool ok = writer_.close();
+        syncMemory(env, 0);
+        if (!ok) {
+            Error::New(env, writer_.getLastError()).ThrowAsJavaScriptException();
+        }
+        return env.Undefined();
+    }
+
+    XlsxWriter writer_;
+    int64_t reportedBytes_ = 0;   // writer memory currently reported to V8
+};
+
+// Workbook handle exposed to JS as `new addon.Workbook(filepath, options)`:
+// row pages of large sheets are read through a per-sheet row offset index
+class WorkbookWrap : public ObjectWrap<WorkbookWrap> {
+public:
+    static Function DefineClass(Napi::Env env) {
+        return ObjectWrap<WorkbookWrap>::DefineClass(env, "Workbook", {
+            InstanceMethod("sheetNames", &WorkbookWrap::SheetNames),
+            InstanceMethod("sheetSize", &WorkbookWrap::SheetSize),
+            InstanceMethod("readRows", &WorkbookWrap::ReadRows),
+            InstanceMethod("close", &WorkbookWrap::Close)
+        });
+    }
+
+    WorkbookWrap(const CallbackInfo& info) : ObjectWrap<WorkbookWrap>(info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 1 || !info[0].IsString()) {
+            TypeError::New(env, "String expected for filepath").ThrowAsJavaScriptException();
+            return;
+        }
+
+        ReadOptions options = parseReadOptions(env, info.Length() > 1 ? info[1] : env.Undefined());
+        if (env.IsExceptionPending()) {
+            return;
+        }
+        if (!workbook_.open(info[0].As<String>().Utf8Value(), options)) {
+            Error::New(env, workbook_.getLastError()).ThrowAsJavaScriptException();
+        }
+    }
+
+private:
+    // Sheet name argument; empty selects the first sheet
+    static std::string sheetNameArg(const CallbackInfo& info) {
+        return info.Length() > 0 && info[0].IsString() ? info[0].As<String>().Utf8Value() : std::string();
+    }
+
+    Napi::Value SheetNames(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        std::vector<std::string> names = workbook_.sheetNames();
+        Array result = Array::New(env, names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            result.Set(i, String::New(env, names[i]));
+        }
+        return result;
+    }
+
+    // sheetSize(sheetName?) - { rows, columns }; the first call for a sheet builds its index
+    Napi::Value SheetSize(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        uint32_t rows = 0;
+        uint32_t columns = 0;
+        if (!workbook_.sheetSize(sheetNameArg(info), rows, columns)) {
+            Error::New(env, workbook_.getLastError()).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        Object result = Object::New(env);
+        result.Set("rows", Number::New(env, rows));
+        result.Set("columns", Number::New(env, columns));
+        return result;
+    }
+
+    // readRows(sheetName?, start, count) - rows as arrays of cell text, 0-based like sheet data
+    Napi::Value ReadRows(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() < 3 || !info[1].IsNumber() || !info[2].IsNumber()) {
+            TypeError::New(env, "Expected (sheetName, start: number, count: number)").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        int64_t start = info[1].As<Number>().Int64Value();
+        int64_t count = info[2].As<Number>().Int64Value();
+        if (start < 0 || count < 0) {
+            RangeError::New(env, "start and count must be >= 0").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        Arena arena;
+        SheetData page;
+        if (!workbook_.readRows(sheetNameArg(info), static_cast<uint32_t>(std::min<int64_t>(start, UINT32_MAX)),
+                                static_cast<uint32_t>(std::min<int64_t>(count, UINT32_MAX)), arena, page)) {
+            Error::New(env, workbook_.getLastError()).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        // Pages carry no images; image cells read as empty like unresolved ones in readExcel
+        Array rows = Array::New(env, page.data.size());
+        for (size_t row = 0; row < page.data.size(); ++row) {
+            const SheetRow& cells = page.data[row];
+            Array rowArray = Array::New(env, cells.size());
+            for (size_t col = 0; col < cells.size(); ++col) {
+                CellText text = cells[col];
+                rowArray.Set(col, text.find("__IMAGE_CELL__") == 0 ? String::New(env, "") : cellTextToString(env, text));
+            }
+            rows.Set(row, rowArray);
+        }
+        return rows;
+    }
+
+    Napi::Value Close(const CallbackInfo& info) {
+        workbook_.close();
+        return info.Env().Undefined();
+    }
+
+    IndexedWorkbook workbook_;
+};
+
+// NativeMemory function - live gauge of native memory held by the addon
+Value NativeMemoryUsage(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    Object result = Object::New(env);
+    result.Set("current", Number::New(env, static_cast<double>(NativeMemory::current())));
+    result.Set("peak", Number::New(env, static_cast<double>(NativeMemory::peak())));
+    result.Set("external", Number::New(env, static_cast<double>(NativeMemory::external())));
+    return result;
+}
+
+// AllocationStatsValue function - operator new counters of allocation-counting
+// builds, used by scripts/memory-regression.js; allocationStats(true) also
+// starts a new peak window
+Value AllocationStatsValue(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() > 0 && info[0].IsBoolean() && info[0].As<Boolean>().Value()) {
+        AllocationCounter::resetPeak();
+    }
+    AllocationStats stats = AllocationCounter::stats();
+    
+    Object result = Object::New(env);
+    result.Set("enabled", Boolean::New(env, stats.enabled));
+    result.Set("count", Number::New(env, static_cast<double>(stats.count)));
+    result.Set("bytes", Number::New(env, static_cast<double>(stats.bytes)));
+    result.Set("live", Number::New(env, static_cast<double>(stats.live)));
+    result.Set("peak", Number::New(env, static_cast<double>(stats.peak)));
+    return result;
+}
+
+// Helper function to convert the scheduler counters
+Object schedulerStatsToObject(Env env) {
+    SchedulerLimits limits = ReadScheduler::instance().limits();
+    SchedulerStats stats = ReadScheduler::instance().stats();
+    
+    Object result = Object::New(env);
+    result.Set("maxConcurrent", Number::New(env, static_cast<double>(limits.maxConcurrent)));
+    result.Set("memoryBudget", Number::New(env, static_cast<double>(limits.memoryBudget)));
+    result.Set("running", Number::New(env, static_cast<double>(stats.running)));
+    result.Set("queued", Number::New(env, static_cast<double>(stats.queued)));
+    result.Set("reservedBytes", Number::New(env, static_cast<double>(stats.reservedBytes)));
+    result.Set("admitted", Number::New(env, static_cast<double>(stats.admitted)));
+    result.Set("waited", Number::New(env, static_cast<double>(stats.waited)));
+    result.Set("totalWaitMs", Number::New(env, static_cast<double>(stats.totalWaitMs)));
+    result.Set("maxWaitMs", Number::New(env, static_cast<double>(stats.maxWaitMs)));
+    result.Set("peakQueued", Number::New(env, static_cast<double>(stats.peakQueued)));
+    return result;
+}
+
+// ConfigureScheduler function - sets the process-wide read budget
+// configureScheduler({ maxConcurrent?, memoryBudget? }) -> stats; omitted keys keep their value
+Value ConfigureScheduler(const CallbackInfo& info) {
+    Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        TypeError::New(env, "Object expected for scheduler options").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Object obj = info[0].As<Object>();
+    SchedulerLimits limits = ReadScheduler::instance().limits();
+    Value maxConcurrent = obj.Get("maxConcurrent");
+    if (maxConcurrent.IsNumber()) {
+        double value = maxConcurrent.As<Number>().DoubleValue();
+        limits.maxConcurrent = value > 0 ? static_cast<size_t>(value) : 0;
+    }
+    Value memoryBudget = obj.Get("memoryBudget");
+    if (memoryBudget.IsNumber()) {
+        double value = memoryBudget.As<Number>().DoubleValue();
+        limits.memoryBudget = value > 0 ? static_cast<uint64_t>(value) : 0;
+    }
+    ReadScheduler::instance().configure(limits);
+    
+    return schedulerStatsToObject(env);
+}
+
+// SchedulerStatsValue function - queue depth, wait times and current reservations
+Value SchedulerStatsValue(const CallbackInfo& info) {
+    return schedulerStatsToObject(info.Env());
+}
+
 // Initialize the addon
 Object Init(Env env, Object exports) {
     exports.Set("readExcel", Function::New(env, ReadExcel));
+    exports.Set("readPacked", Function::New(env, ReadPacked));
     exports.Set("extractImages", Function::New(env, ExtractImages));
+    exports.Set("probe", Function::New(env, Probe));
+    exports.Set("readExcelAsync", Function::New(env, ReadExcelAsync));
+    exports.Set("readMany", Function::New(env, ReadMany));
+    exports.Set("exportTable", Function::New(env, ExportTable));
+    exports.Set("XlsxWriter", XlsxWriterWrap::DefineClass(env));
+    exports.Set("Workbook", WorkbookWrap::DefineClass(env));
+    exports.Set("nativeMemory", Function::New(env, NativeMemoryUsage));
+    exports.Set("allocationStats", Function::New(env, AllocationStatsValue));
+    exports.Set("configureScheduler", Function::New(env, ConfigureScheduler));
+    exports.Set("schedulerStats", Function::New(env, SchedulerStatsValue));
     return exports;
 }
 
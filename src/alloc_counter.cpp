@@ -0,0 +1,121 @@
+#include "alloc_counter.h"
+#include <atomic>
+
+#ifdef BAJA_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#define BAJA_USABLE_SIZE(p) _msize(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define BAJA_USABLE_SIZE(p) malloc_size(p)
+#else
+#include <malloc.h>
+#define BAJA_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+#endif
+
+namespace baja_xlsx {
+
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> allocationBytes{0};
+static std::atomic<int64_t> liveBytes{0};
+static std::atomic<int64_t> peakBytes{0};
+
+#ifdef BAJA_COUNT_ALLOCATIONS
+// Sizes come from the allocator rather than a header: blocks allocated by
+// another module's operator new (a string built inside xlnt) can still be
+// released here, they only make live drift low
+static void* countedAlloc(size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) return nullptr;
+
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t block = static_cast<int64_t>(BAJA_USABLE_SIZE(p));
+    int64_t now = liveBytes.fetch_add(block, std::memory_order_relaxed) + block;
+    int64_t seen = peakBytes.load(std::memory_order_relaxed);
+    while (now > seen && !peakBytes.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+    }
+    return p;
+}
+
+static void countedFree(void* p) {
+    if (!p) return;
+    liveBytes.fetch_sub(static_cast<int64_t>(BAJA_USABLE_SIZE(p)), std::memory_order_relaxed);
+    std::free(p);
+}
+#endif
+
+AllocationStats AllocationCounter::stats() {
+    AllocationStats stats;
+#ifdef BAJA_COUNT_ALLOCATIONS
+    stats.enabled = true;
+#else
+    stats.enabled = false;
+#endif
+    stats.count = allocationCount.load(std::memory_order_relaxed);
+    stats.bytes = allocationBytes.load(std::memory_order_relaxed);
+    stats.live = liveBytes.load(std::memory_order_relaxed);
+    stats.peak = peakBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocationCounter::resetPeak() {
+    peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace baja_xlsx
+
+#ifdef BAJA_COUNT_ALLOCATIONS
+// Counting builds link with -Bsymbolic-functions on Linux, so the addon's own
+// calls bind to these while Node and shared libraries keep the runtime's; they
+// also define _GLIBCXX_ASSERTIONS, which keeps libstdc++ from routing std::string
+// allocations through its prebuilt (uncounted) instantiations.
+// Over-aligned new / delete are left to the runtime; they pair with each other.
+
+void* operator new(size_t size) {
+    void* p = baja_xlsx::countedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = baja_xlsx::countedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return baja_xlsx::countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return baja_xlsx::countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    baja_xlsx::countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    baja_xlsx::countedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    baja_xlsx::countedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    baja_xlsx::countedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    baja_xlsx::countedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    baja_xlsx::countedFree(p);
+}
+#endif
@@ -0,0 +1,33 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+namespace baja_xlsx {
+
+struct AllocationStats {
+    bool enabled;        // false unless built with count_allocations=true
+    uint64_t count;      // operator new calls so far
+    uint64_t bytes;      // bytes requested by them
+    int64_t live;        // bytes currently allocated (allocator block sizes)
+    int64_t peak;        // highest value of live since the last resetPeak
+};
+
+// Allocation counter behind the memory regression harness
+// (scripts/memory-regression.js). Builds with BAJA_COUNT_ALLOCATIONS replace
+// operator new / delete for the addon's own code; allocations made inside
+// xlnt, libzip or Node itself are not seen and only show up in peak RSS.
+// live and peak are approximate when the addon frees objects xlnt allocated,
+// but deterministic for a given file, which is what the baselines compare.
+// Regular builds compile the hook out and report enabled = false.
+class AllocationCounter {
+public:
+    static AllocationStats stats();
+
+    // Start a new peak window at the current live size
+    static void resetPeak();
+};
+
+} // namespace baja_xlsx
+
+#endif // ALLOC_COUNTER_H
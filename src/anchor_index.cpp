@@ -0,0 +1,128 @@
+#include "anchor_index.h"
+#include <algorithm>
+
+namespace baja_xlsx {
+
+CellRange anchorCells(const ImagePosition& pos) {
+    CellRange range;
+    range.firstRow = pos.fromRow;
+    range.firstCol = pos.fromCol;
+    range.lastRow = (pos.toRow > pos.fromRow && pos.toRowOff == 0) ? pos.toRow - 1 : pos.toRow;
+    range.lastCol = (pos.toCol > pos.fromCol && pos.toColOff == 0) ? pos.toCol - 1 : pos.toCol;
+    range.lastRow = std::max(range.lastRow, range.firstRow);
+    range.lastCol = std::max(range.lastCol, range.firstCol);
+    return range;
+}
+
+AnchorIndex::AnchorIndex(const std::vector<ImagePosition>& positions) : positions_(positions) {
+    for (size_t i = 0; i < positions.size(); ++i) {
+        CellRange cells = anchorCells(positions[i]);
+        sheets_[positions[i].sheetName].entries.push_back(Entry{cells.firstRow, cells.lastRow, cells.lastRow, i});
+    }
+    for (auto& sheet : sheets_) {
+        build(sheet.second);
+    }
+}
+
+// Implicit binary tree over the sorted array: leaves sit at even indexes and a
+// node at level k has k trailing one bits, its children k-1 levels below at
+// index -/+ 2^(k-1). Indexes past the end are treated as absent subtrees.
+void AnchorIndex::build(SheetTree& tree) {
+    std::vector<Entry>& a = tree.entries;
+    std::sort(a.begin(), a.end(), [](const Entry& x, const Entry& y) {
+        return x.firstRow != y.firstRow ? x.firstRow < y.firstRow : x.position < y.position;
+    });
+
+    size_t n = a.size();
+    tree.levels = 0;
+    if (n == 0) return;
+
+    // "last" carries the max of the rightmost, possibly incomplete subtree
+    size_t lastIndex = 0;
+    int last = 0;
+    for (size_t i = 0; i < n; i += 2) {
+        lastIndex = i;
+        last = a[i].maxLastRow = a[i].lastRow;
+    }
+    int k = 1;
+    for (; (static_cast<size_t>(1) << k) <= n; ++k) {
+        size_t x = static_cast<size_t>(1) << (k - 1);
+        size_t first = (x << 1) - 1;
+        size_t step = x << 2;
+        for (size_t i = first; i < n; i += step) {
+            int left = a[i - x].maxLastRow;
+            int right = i + x < n ? a[i + x].maxLastRow : last;
+            a[i].maxLastRow = std::max(a[i].lastRow, std::max(left, right));
+        }
+        lastIndex = ((lastIndex >> k) & 1) ? lastIndex - x : lastIndex + x;
+        if (lastIndex < n && a[lastIndex].maxLastRow > last) {
+            last = a[lastIndex].maxLastRow;
+        }
+    }
+    tree.levels = k - 1;
+}
+
+void AnchorIndex::collect(const SheetTree& tree, int firstRow, int lastRow, std::vector<size_t>& out) const {
+    const std::vector<Entry>& a = tree.entries;
+    size_t n = a.size();
+    if (n == 0) return;
+
+    struct Frame {
+        int level;
+        size_t node;
+        bool leftDone;
+    };
+    Frame stack[64];
+    int top = 0;
+    stack[top++] = Frame{tree.levels, (static_cast<size_t>(1) << tree.levels) - 1, false};
+
+    while (top > 0) {
+        Frame f = stack[--top];
+        if (f.level <= 3) {
+            // Small subtree: scan it in order
+            size_t begin = f.node >> f.level << f.level;
+            size_t end = std::min(n, begin + (static_cast<size_t>(1) << (f.level + 1)) - 1);
+            for (size_t i = begin; i < end && a[i].firstRow <= lastRow; ++i) {
+                if (a[i].lastRow >= firstRow) out.push_back(a[i].position);
+            }
+        } else if (!f.leftDone) {
+            size_t left = f.node - (static_cast<size_t>(1) << (f.level - 1));
+            stack[top++] = Frame{f.level, f.node, true};
+            if (left >= n || a[left].maxLastRow >= firstRow) {
+                stack[top++] = Frame{f.level - 1, left, false};
+            }
+        } else if (f.node < n && a[f.node].firstRow <= lastRow) {
+            if (a[f.node].lastRow >= firstRow) out.push_back(a[f.node].position);
+            stack[top++] = Frame{f.level - 1, f.node + (static_cast<size_t>(1) << (f.level - 1)), false};
+        }
+    }
+}
+
+std::vector<size_t> AnchorIndex::query(const std::string& sheetName, const CellRange& range) const {
+    std::vector<size_t> result;
+    auto it = sheets_.find(sheetName);
+    if (it == sheets_.end()) return result;
+
+    std::vector<size_t> rows;
+    collect(it->second, range.firstRow, range.lastRow, rows);
+    for (size_t index : rows) {
+        CellRange cells = anchorCells(positions_[index]);
+        if (cells.lastCol >= range.firstCol && cells.firstCol <= range.lastCol) {
+            result.push_back(index);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+long AnchorIndex::findAt(const std::string& sheetName, int row, int col) const {
+    for (size_t index : query(sheetName, CellRange{row, col, row, col})) {
+        const ImagePosition& pos = positions_[index];
+        if (pos.fromRow == row && pos.fromCol == col) {
+            return static_cast<long>(index);
+        }
+    }
+    return -1;
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,61 @@
+#ifndef ANCHOR_INDEX_H
+#define ANCHOR_INDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+// 0-based, inclusive rectangle of cells
+struct CellRange {
+    int firstRow;
+    int firstCol;
+    int lastRow;
+    int lastCol;
+};
+
+// Cells an anchor covers: from..to, minus the to row / column when the image
+// ends exactly on its leading edge (offset 0). One-cell anchors cover one cell.
+CellRange anchorCells(const ImagePosition& pos);
+
+// Static per-sheet interval tree over image anchors, so "which images overlap
+// rows 100-200" or "which image sits at B7" does not scan every anchor.
+// Anchors are sorted by first row and the tree is implicit in that array, each
+// node holding the largest last row below it: a query costs O(log n + k) in
+// rows, and matches are then filtered by column. The index refers into the
+// positions vector, which must outlive it.
+class AnchorIndex {
+public:
+    explicit AnchorIndex(const std::vector<ImagePosition>& positions);
+
+    // Indexes into positions of the anchors on sheetName overlapping range, ascending
+    std::vector<size_t> query(const std::string& sheetName, const CellRange& range) const;
+
+    // First anchor (in positions order) whose top-left cell is (row, col), or -1
+    long findAt(const std::string& sheetName, int row, int col) const;
+
+private:
+    struct Entry {
+        int firstRow;
+        int lastRow;
+        int maxLastRow;     // largest lastRow in the subtree rooted here
+        size_t position;
+    };
+
+    struct SheetTree {
+        std::vector<Entry> entries;
+        int levels;
+    };
+
+    static void build(SheetTree& tree);
+    void collect(const SheetTree& tree, int firstRow, int lastRow, std::vector<size_t>& out) const;
+
+    const std::vector<ImagePosition>& positions_;
+    std::unordered_map<std::string, SheetTree> sheets_;
+};
+
+} // namespace baja_xlsx
+
+#endif // ANCHOR_INDEX_H
@@ -0,0 +1,70 @@
+#include "arena.h"
+#include "native_memory.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace baja_xlsx {
+
+Arena::Arena(size_t blockSize)
+    : current_(nullptr), offset_(0), capacity_(0), blockSize_(blockSize), bytesReserved_(0) {
+}
+
+Arena::~Arena() {
+    for (char* block : blocks_) {
+        std::free(block);
+    }
+    NativeMemory::add(-static_cast<int64_t>(bytesReserved_));
+}
+
+void* Arena::allocateSlow(size_t bytes, size_t alignment) {
+    // Large requests get a dedicated block so the current block keeps serving small ones.
+    // malloc'd blocks already satisfy max_align_t, which covers every type we store.
+    if (bytes > blockSize_ / 4) {
+        char* block = static_cast<char*>(std::malloc(bytes));
+        if (!block) throw std::bad_alloc();
+        blocks_.push_back(block);
+        bytesReserved_ += bytes;
+        NativeMemory::add(static_cast<int64_t>(bytes));
+        return block;
+    }
+
+    char* block = static_cast<char*>(std::malloc(blockSize_));
+    if (!block) throw std::bad_alloc();
+    blocks_.push_back(block);
+    bytesReserved_ += blockSize_;
+    NativeMemory::add(static_cast<int64_t>(blockSize_));
+
+    current_ = block;
+    capacity_ = blockSize_;
+    offset_ = 0;
+
+    size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+    offset_ = aligned + bytes;
+    return current_ + aligned;
+}
+
+void Arena::adopt(Arena& other) {
+    if (&other == this) return;
+
+    // Adopted blocks are never allocated from again; the current block stays current
+    blocks_.insert(blocks_.end(), other.blocks_.begin(), other.blocks_.end());
+    bytesReserved_ += other.bytesReserved_;
+
+    other.blocks_.clear();
+    other.current_ = nullptr;
+    other.offset_ = 0;
+    other.capacity_ = 0;
+    other.bytesReserved_ = 0;
+}
+
+std::string_view Arena::copyString(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    char* dest = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(dest, text.data(), text.size());
+    return std::string_view(dest, text.size());
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,106 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace baja_xlsx {
+
+// Monotonic allocator for one read: memory is handed out from large blocks and
+// released all at once when the Arena is destroyed. Individual frees are no-ops.
+// Alignment requests above alignof(std::max_align_t) are not supported.
+class Arena {
+public:
+    static constexpr size_t kDefaultBlockSize = 256 * 1024;
+
+    explicit Arena(size_t blockSize = kDefaultBlockSize);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (current_ && aligned + bytes <= capacity_) {
+            offset_ = aligned + bytes;
+            return current_ + aligned;
+        }
+        return allocateSlow(bytes, alignment);
+    }
+
+    // Copy text into the arena; the view stays valid until the arena is destroyed
+    std::string_view copyString(std::string_view text);
+
+    // Take over other's blocks, e.g. one filled on a worker thread; views into
+    // them stay valid for the lifetime of this arena and other is left empty
+    void adopt(Arena& other);
+
+    // Total bytes reserved from the system (all blocks)
+    size_t bytesReserved() const { return bytesReserved_; }
+
+private:
+    void* allocateSlow(size_t bytes, size_t alignment);
+
+    std::vector<char*> blocks_;
+    char* current_;
+    size_t offset_;
+    size_t capacity_;
+    size_t blockSize_;
+    size_t bytesReserved_;
+};
+
+// std-compatible allocator on top of an Arena. A default-constructed allocator
+// (no arena) falls back to the global heap, so arena-backed containers stay
+// usable as plain value types.
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept : arena_(nullptr) {}
+    explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t n) {
+        if (!arena_) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        // Arena memory is released together with the arena
+        if (!arena_) {
+            ::operator delete(p);
+        }
+    }
+
+    Arena* arena() const noexcept { return arena_; }
+
+private:
+    Arena* arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena() == b.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena() != b.arena();
+}
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace baja_xlsx
+
+#endif // ARENA_H
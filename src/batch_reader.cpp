@@ -0,0 +1,95 @@
+#include "batch_reader.h"
+#include <algorithm>
+
+namespace baja_xlsx {
+
+BatchReader::BatchReader(std::vector<std::string> paths, size_t concurrency,
+                         const ReadOptions& options)
+    : paths_(std::move(paths)), options_(options), next_(0), paused_(false) {
+    if (concurrency == 0) {
+        concurrency = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threadCount_ = std::max<size_t>(1, std::min(concurrency, paths_.size()));
+
+    // Files already run in parallel; splitting sheets across threads as well would oversubscribe
+    if (threadCount_ > 1 && options_.parseThreads == 0) {
+        options_.parseThreads = 1;
+    }
+}
+
+BatchReader::~BatchReader() {
+    join();
+}
+
+void BatchReader::start(ResultCallback onResult, WorkerExitCallback onWorkerExit) {
+    onResult_ = std::move(onResult);
+    onWorkerExit_ = std::move(onWorkerExit);
+
+    workers_.reserve(threadCount_);
+    for (size_t i = 0; i < threadCount_; ++i) {
+        workers_.emplace_back(&BatchReader::workerLoop, this);
+    }
+}
+
+void BatchReader::join() {
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void BatchReader::pause() {
+    std::lock_guard<std::mutex> lock(gateMutex_);
+    paused_ = true;
+}
+
+void BatchReader::resume() {
+    {
+        std::lock_guard<std::mutex> lock(gateMutex_);
+        paused_ = false;
+    }
+    gate_.notify_all();
+}
+
+void BatchReader::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(gateMutex_);
+        if (options_.control) options_.control->cancel();
+    }
+    gate_.notify_all();
+}
+
+void BatchReader::workerLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(gateMutex_);
+            gate_.wait(lock, [this]() { return !paused_ || cancelled(); });
+        }
+
+        // A cancelled batch stops handing out files; the read in progress stops on its own
+        if (cancelled()) break;
+
+        size_t index = next_.fetch_add(1);
+        if (index >= paths_.size()) break;
+
+        BatchItemResult result;
+        result.index = index;
+
+        XlsxReader reader;
+        result.data = reader.readExcel(paths_[index], options_);
+        result.error = reader.getLastError();
+
+        if (!onResult_(std::move(result))) {
+            cancel();
+            break;
+        }
+    }
+
+    if (onWorkerExit_) {
+        onWorkerExit_();
+    }
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,76 @@
+#ifndef BATCH_READER_H
+#define BATCH_READER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+struct BatchItemResult {
+    size_t index;          // position of the file in the input list
+    ExcelData data;
+    std::string error;     // empty on success
+};
+
+// Reads many workbooks on a fixed pool of native threads. Each thread pulls the
+// next file, inflates and parses it, and hands the result to onResult while it
+// moves on to the next file, so conversion on the JS thread overlaps with
+// parsing of the following files.
+class BatchReader {
+public:
+    // Returns false when the result could not be delivered (the consumer is gone)
+    using ResultCallback = std::function<bool(BatchItemResult&& result)>;
+    using WorkerExitCallback = std::function<void()>;
+
+    BatchReader(std::vector<std::string> paths, size_t concurrency,
+                const ReadOptions& options = ReadOptions());
+    ~BatchReader();
+
+    BatchReader(const BatchReader&) = delete;
+    BatchReader& operator=(const BatchReader&) = delete;
+
+    // Number of worker threads start() will spawn (at least 1)
+    size_t threadCount() const { return threadCount_; }
+
+    // Spawn the workers. onResult is called on a worker thread as each file
+    // completes; a result that cannot be delivered cancels the batch.
+    // onWorkerExit is called once per worker when it runs out of files.
+    void start(ResultCallback onResult, WorkerExitCallback onWorkerExit);
+
+    // Wait for all workers to exit
+    void join();
+
+    // Backpressure: while paused, workers finish the file they are reading but
+    // do not start another one
+    void pause();
+    void resume();
+
+    // Stop handing out files and abort the reads in progress through
+    // options.control (also wakes paused workers); no-op without a control
+    void cancel();
+
+private:
+    void workerLoop();
+    bool cancelled() const { return options_.control && options_.control->cancelled(); }
+
+    std::vector<std::string> paths_;
+    ReadOptions options_;
+    size_t threadCount_;
+    std::atomic<size_t> next_;
+    std::vector<std::thread> workers_;
+    std::mutex gateMutex_;
+    std::condition_variable gate_;
+    bool paused_;
+    ResultCallback onResult_;
+    WorkerExitCallback onWorkerExit_;
+};
+
+} // namespace baja_xlsx
+
+#endif // BATCH_READER_H
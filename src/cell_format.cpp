@@ -0,0 +1,300 @@
+#include "cell_format.h"
+#include <cerrno>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+// Floating-point to_chars/from_chars are missing from older standard libraries (libc++
+// before macOS 13.3 among them); those builds fall back to snprintf and strtod below
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define BAJA_HAVE_FLOAT_CHARCONV 1
+#endif
+
+namespace baja_xlsx {
+
+// Every integer up to 2^53 is exact and prints without an exponent
+static const double kMaxExactInteger = 9007199254740992.0;
+
+static size_t formatInteger(uint64_t magnitude, bool negative, char* out) {
+    char digits[24];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t length = 0;
+    if (negative) out[length++] = '-';
+    while (count > 0) out[length++] = digits[--count];
+    return length;
+}
+
+size_t parseDecimal(std::string_view text, double& out) {
+    // strtod skipped leading blanks and a '+'; from_chars accepts neither
+    size_t start = 0;
+    while (start < text.size() && (text[start] == ' ' || text[start] == '\t')) ++start;
+    if (start < text.size() && text[start] == '+' &&
+        (start + 1 == text.size() || text[start + 1] != '-')) {
+        ++start;
+    }
+    const char* first = text.data() + start;
+    const char* last = text.data() + text.size();
+#ifdef BAJA_HAVE_FLOAT_CHARCONV
+    // Out-of-range values ("1e400") are not numbers here, rather than strtod's HUGE_VAL
+    std::from_chars_result result = std::from_chars(first, last, out);
+    if (result.ec != std::errc()) return 0;
+    return static_cast<size_t>(result.ptr - text.data());
+#else
+    // strtod with the locale's decimal point in place of '.'
+    char buffer[kMaxNumberChars * 2 + 1];
+    size_t length = 0;
+    char point = *std::localeconv()->decimal_point;
+    for (const char* p = first; p != last && length + 1 < sizeof(buffer); ++p) {
+        char c = *p;
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e' || c == 'E' || c == '.')) break;
+        buffer[length++] = c == '.' ? point : c;
+    }
+    buffer[length] = '\0';
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtod(buffer, &end);
+    // ERANGE also flags subnormal results, which from_chars accepts
+    if (end == buffer || (errno == ERANGE && (out == 0 || std::isinf(out)))) return 0;
+    return start + static_cast<size_t>(end - buffer);
+#endif
+}
+
+// Shortest significant digits that read back to magnitude (finite, non-zero) and
+// the decimal exponent of the first one; trailing zeros are dropped
+static size_t shortestDigits(double magnitude, char* digits, int& exponent) {
+    char text[kMaxNumberChars];
+#ifdef BAJA_HAVE_FLOAT_CHARCONV
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), magnitude, std::chars_format::scientific);
+    *result.ptr = '\0';
+#else
+    // The first precision that reads back is the shortest. Below 15 digits any
+    // normal double prints its shortest digits padded with zeros; subnormals carry
+    // fewer significant bits and may need fewer digits, so they search from one
+    int first = magnitude < DBL_MIN ? 0 : 14;
+    for (int precision = first; precision <= 16; ++precision) {
+        std::snprintf(text, sizeof(text), "%.*e", precision, magnitude);
+        // snprintf wrote the locale's decimal point, which strtod reads back
+        if (std::strtod(text, nullptr) == magnitude) break;
+    }
+#endif
+
+    // "d.ddde+XX"; the point may be a locale-specific character in the snprintf case
+    size_t count = 0;
+    const char* p = text;
+    for (; *p != 'e' && *p != '\0'; ++p) {
+        if (*p >= '0' && *p <= '9') digits[count++] = *p;
+    }
+    exponent = *p == 'e' ? std::atoi(p + 1) : 0;
+    while (count > 1 && digits[count - 1] == '0') --count;
+    return count;
+}
+
+size_t formatNumber(double value, char* out) {
+    // Fast path: most numeric cells are whole numbers (ids, counts, amounts)
+    if (std::fabs(value) <= kMaxExactInteger && value == std::trunc(value)) {
+        if (value == 0) {
+            out[0] = '0';
+            return 1;
+        }
+        return formatInteger(static_cast<uint64_t>(std::fabs(value)), value < 0, out);
+    }
+    if (std::isnan(value)) {
+        std::memcpy(out, "nan", 3);
+        return 3;
+    }
+    if (std::isinf(value)) {
+        std::memcpy(out, value < 0 ? "-inf" : "inf", value < 0 ? 4 : 3);
+        return value < 0 ? 4 : 3;
+    }
+
+    char digits[kMaxNumberChars];
+    int exponent = 0;
+    size_t count = shortestDigits(std::fabs(value), digits, exponent);
+
+    // Lay the digits out like JavaScript's Number#toString, so String(Number(text))
+    // gives the text back: plain notation from 1e-6 up to 1e21, exponent beyond
+    size_t length = 0;
+    if (value < 0) out[length++] = '-';
+    int point = exponent + 1;
+    if (point > 0 && point <= 21) {
+        for (int i = 0; i < point; ++i) {
+            out[length++] = static_cast<size_t>(i) < count ? digits[i] : '0';
+        }
+        if (static_cast<size_t>(point) < count) {
+            out[length++] = '.';
+            for (size_t i = point; i < count; ++i) out[length++] = digits[i];
+        }
+    } else if (point <= 0 && point > -6) {
+        out[length++] = '0';
+        out[length++] = '.';
+        for (int i = point; i < 0; ++i) out[length++] = '0';
+        for (size_t i = 0; i < count; ++i) out[length++] = digits[i];
+    } else {
+        out[length++] = digits[0];
+        if (count > 1) {
+            out[length++] = '.';
+            for (size_t i = 1; i < count; ++i) out[length++] = digits[i];
+        }
+        length += std::snprintf(out + length, kMaxNumberChars - length, "e%+d", exponent);
+    }
+    return length;
+}
+
+std::string formatNumber(double value) {
+    char buffer[kMaxNumberChars];
+    return std::string(buffer, formatNumber(value, buffer));
+}
+
+bool isCanonicalInteger(std::string_view text) {
+    size_t start = !text.empty() && text[0] == '-' ? 1 : 0;
+    size_t digits = text.size() - start;
+    // 15 digits stay below 2^53; no leading zeros and no "-0"
+    if (digits == 0 || digits > 15) return false;
+    if (text[start] == '0') return text.size() == 1;
+    for (size_t i = start; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+    }
+    return true;
+}
+
+bool isBuiltinDateFormat(int numFmtId) {
+    return (numFmtId >= 14 && numFmtId <= 22) ||
+           (numFmtId >= 27 && numFmtId <= 36) ||
+           (numFmtId >= 45 && numFmtId <= 47) ||
+           (numFmtId >= 50 && numFmtId <= 58);
+}
+
+bool isDateFormatCode(std::string_view formatCode) {
+    // Only the first (positive number) section decides
+    for (size_t i = 0; i < formatCode.size(); ++i) {
+        char c = formatCode[i];
+        switch (c) {
+            case ';':
+                return false;
+            case '"': {
+                size_t close = formatCode.find('"', i + 1);
+                if (close == std::string_view::npos) return false;
+                i = close;
+                break;
+            }
+            case '\\':
+            case '_':
+            case '*':
+                i++;  // the next character is a literal / padding
+                break;
+            case '[': {
+                size_t close = formatCode.find(']', i + 1);
+                if (close == std::string_view::npos) return false;
+                // [h], [mm], [ss] are elapsed-time tokens; [Red], [$-409] are not
+                char first = i + 1 < close ? formatCode[i + 1] : '\0';
+                if (first == 'h' || first == 'H' || first == 'm' || first == 'M' || first == 's' || first == 'S') {
+                    return true;
+                }
+                i = close;
+                break;
+            }
+            case 'y': case 'Y':
+            case 'm': case 'M':
+            case 'd': case 'D':
+            case 'h': case 'H':
+            case 's': case 'S':
+                return true;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+// Days since 1970-01-01 to civil date (proleptic Gregorian)
+static void civilFromDays(long long days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned doe = static_cast<unsigned>(days - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long y = static_cast<long long>(yoe) + era * 400;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(y + (month <= 2));
+}
+
+// Last serial that is still in year 9999, per date system
+static const double kMaxSerial1900 = 2958465;
+static const double kMaxSerial1904 = 2958465 - 1462;
+
+std::string serialToIsoDate(double serial, bool date1904) {
+    if (!std::isfinite(serial) || serial < 0 || serial >= (date1904 ? kMaxSerial1904 : kMaxSerial1900) + 1) {
+        return formatNumber(serial);
+    }
+
+    long long whole = static_cast<long long>(std::floor(serial));
+    long long seconds = std::llround((serial - static_cast<double>(whole)) * 86400.0);
+    if (seconds >= 86400) {
+        whole += 1;
+        seconds -= 86400;
+    }
+    // Rounding up to midnight may step past the last day
+    if (whole > (date1904 ? kMaxSerial1904 : kMaxSerial1900)) {
+        return formatNumber(serial);
+    }
+
+    // Every component is in range now; narrowed so the buffer provably fits
+    int hour = static_cast<int>(seconds / 3600);
+    int minute = static_cast<int>((seconds / 60) % 60);
+    int second = static_cast<int>(seconds % 60);
+
+    char buffer[48];
+    if (!date1904 && whole == 0) {
+        std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", hour, minute, second);
+        return buffer;
+    }
+
+    // 1900 system: serial 1 is 1900-01-01 and serial 60 is the fictitious 1900-02-29
+    // (kept as such, like xlnt), so serials from 61 on are counted from 1899-12-30.
+    // 1904 system: serial 0 is 1904-01-01.
+    int year;
+    unsigned month;
+    unsigned day;
+    if (!date1904 && whole == 60) {
+        year = 1900;
+        month = 2;
+        day = 29;
+    } else {
+        long long epochDays;
+        if (date1904) {
+            epochDays = -24107 + whole;        // 1904-01-01
+        } else if (whole < 60) {
+            epochDays = -25568 + whole;        // 1899-12-31
+        } else {
+            epochDays = -25569 + whole;        // 1899-12-30
+        }
+        civilFromDays(epochDays, year, month, day);
+    }
+
+    if (second == 0 && minute == 0 && hour == 0) {
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", year, month, day);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT%02d:%02d:%02d", year, month, day,
+                      hour, minute, second);
+    }
+    return buffer;
+}
+
+} // namespace baja_xlsx
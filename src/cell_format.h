@@ -0,0 +1,41 @@
+#ifndef CELL_FORMAT_H
+#define CELL_FORMAT_H
+
+#include <string>
+#include <string_view>
+
+namespace baja_xlsx {
+
+// Longest text formatNumber writes, sign and exponent included
+constexpr size_t kMaxNumberChars = 32;
+
+// Text for a numeric cell value, shared by every reader path and the writer.
+// Shortest text that parses back to the same double, locale independent:
+// integers have no decimals ("25"), other values use %g notation ("0.1", "1e+21").
+std::string formatNumber(double value);
+
+// Same text written to out (at least kMaxNumberChars bytes); returns its length
+size_t formatNumber(double value, char* out);
+
+// Decimal number at the start of text ("25", "-1.5E-7"), read the same way whatever
+// the process locale; returns the characters used, 0 when there is no number
+size_t parseDecimal(std::string_view text, double& out);
+
+// True when text is an integer formatNumber would print unchanged, e.g. a raw
+// sheet value "25"; lets readers copy such values without parsing them
+bool isCanonicalInteger(std::string_view text);
+
+// True when numFmtId is one of the built-in date/time formats
+bool isBuiltinDateFormat(int numFmtId);
+
+// True when a custom format code displays a date or time, e.g. "yyyy-mm-dd" or "[h]:mm"
+// (quoted literals, escapes and color/locale brackets are ignored)
+bool isDateFormatCode(std::string_view formatCode);
+
+// Excel serial date to ISO 8601: "2024-01-31", "2024-01-31T08:30:00", or "08:30:00" for
+// a pure time (serial below 1). Values outside the calendar fall back to formatNumber.
+std::string serialToIsoDate(double serial, bool date1904);
+
+} // namespace baja_xlsx
+
+#endif // CELL_FORMAT_H
@@ -0,0 +1,18 @@
+#include "column_schema.h"
+
+namespace baja_xlsx {
+
+const char* columnTypeName(ColumnType type) {
+    switch (type) {
+        case ColumnType::Number: return "number";
+        case ColumnType::Date: return "date";
+        case ColumnType::Boolean: return "boolean";
+        case ColumnType::String: return "string";
+        case ColumnType::Formula: return "formula";
+        case ColumnType::Mixed: return "mixed";
+        case ColumnType::Empty:
+        default: return "empty";
+    }
+}
+
+} // namespace baja_xlsx
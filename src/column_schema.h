@@ -0,0 +1,52 @@
+#ifndef COLUMN_SCHEMA_H
+#define COLUMN_SCHEMA_H
+
+#include <cstdint>
+
+namespace baja_xlsx {
+
+// What a sheet column holds, inferred from a sample of its rows
+enum class ColumnType : uint8_t {
+    Empty,      // no non-empty cell sampled
+    Number,
+    Date,       // numbers in a date format; only told apart when ISO dates are requested
+    Boolean,
+    String,     // shared, inline or error text
+    Formula,    // cached formula text, including DISPIMG image cells
+    Mixed       // sampled cells of more than one kind
+};
+
+// "number", "date", ... as exposed to JS
+const char* columnTypeName(ColumnType type);
+
+// Per-column result of schema inference. Both readers (xlnt and values-only)
+// follow the same rule:
+//   - rows [schemaStartRow, schemaStartRow + schemaRows) (0-based) are sampled;
+//   - a column whose sample is uniform gets a decoder, tried on every row of the
+//     sheet, header included; cells that do not fit it go through the generic
+//     per-cell path, so the text is the same either way;
+//   - fallbacks counts those cells from schemaStartRow on; rows above it (the
+//     header) are expected not to fit;
+//   - there is one entry per column of the padded grid, i.e. the width of every
+//     row in SheetData::data.
+struct ColumnSchema {
+    ColumnType type;
+    uint32_t samples;     // non-empty cells the type was inferred from
+    uint64_t fallbacks;   // cells from schemaStartRow on the column decoder could not take
+
+    ColumnSchema() : type(ColumnType::Empty), samples(0), fallbacks(0) {}
+
+    // Fold one sampled, non-empty cell into the column type
+    void observe(ColumnType cellType) {
+        samples++;
+        if (type == ColumnType::Empty) {
+            type = cellType;
+        } else if (type != cellType) {
+            type = ColumnType::Mixed;
+        }
+    }
+};
+
+} // namespace baja_xlsx
+
+#endif // COLUMN_SCHEMA_H
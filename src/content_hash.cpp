@@ -0,0 +1,250 @@
+#include "content_hash.h"
+#include <cstring>
+
+namespace baja_xlsx {
+
+static const uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t readLE64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * kPrime64_2;
+    acc = rotl64(acc, 31);
+    return acc * kPrime64_1;
+}
+
+static uint64_t xxhMergeRound(uint64_t acc, uint64_t value) {
+    acc ^= xxhRound(0, value);
+    return acc * kPrime64_1 + kPrime64_4;
+}
+
+static std::string toHex(const uint8_t* bytes, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(size * 2, '0');
+    for (size_t i = 0; i < size; ++i) {
+        hex[i * 2] = digits[bytes[i] >> 4];
+        hex[i * 2 + 1] = digits[bytes[i] & 0x0F];
+    }
+    return hex;
+}
+
+Xxh64Hasher::Xxh64Hasher(uint64_t seed) : seed_(seed), totalLength_(0), bufferSize_(0) {
+    v_[0] = seed + kPrime64_1 + kPrime64_2;
+    v_[1] = seed + kPrime64_2;
+    v_[2] = seed;
+    v_[3] = seed - kPrime64_1;
+}
+
+void Xxh64Hasher::update(const uint8_t* data, size_t size) {
+    totalLength_ += size;
+
+    // Top up a partial stripe first
+    if (bufferSize_ > 0) {
+        size_t take = 32 - bufferSize_;
+        if (take > size) take = size;
+        std::memcpy(buffer_ + bufferSize_, data, take);
+        bufferSize_ += take;
+        data += take;
+        size -= take;
+
+        if (bufferSize_ < 32) return;
+        for (int i = 0; i < 4; ++i) {
+            v_[i] = xxhRound(v_[i], readLE64(buffer_ + i * 8));
+        }
+        bufferSize_ = 0;
+    }
+
+    while (size >= 32) {
+        for (int i = 0; i < 4; ++i) {
+            v_[i] = xxhRound(v_[i], readLE64(data + i * 8));
+        }
+        data += 32;
+        size -= 32;
+    }
+
+    if (size > 0) {
+        std::memcpy(buffer_, data, size);
+        bufferSize_ = size;
+    }
+}
+
+uint64_t Xxh64Hasher::digest() const {
+    uint64_t h;
+    if (totalLength_ >= 32) {
+        h = rotl64(v_[0], 1) + rotl64(v_[1], 7) + rotl64(v_[2], 12) + rotl64(v_[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            h = xxhMergeRound(h, v_[i]);
+        }
+    } else {
+        h = seed_ + kPrime64_5;
+    }
+    h += totalLength_;
+
+    const uint8_t* p = buffer_;
+    size_t remaining = bufferSize_;
+    while (remaining >= 8) {
+        h ^= xxhRound(0, readLE64(p));
+        h = rotl64(h, 27) * kPrime64_1 + kPrime64_4;
+        p += 8;
+        remaining -= 8;
+    }
+    if (remaining >= 4) {
+        h ^= static_cast<uint64_t>(readLE32(p)) * kPrime64_1;
+        h = rotl64(h, 23) * kPrime64_2 + kPrime64_3;
+        p += 4;
+        remaining -= 4;
+    }
+    while (remaining > 0) {
+        h ^= (*p) * kPrime64_5;
+        h = rotl64(h, 11) * kPrime64_1;
+        p++;
+        remaining--;
+    }
+
+    // Avalanche
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string Xxh64Hasher::hexDigest() const {
+    uint64_t h = digest();
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<uint8_t>(h >> (56 - i * 8));
+    }
+    return toHex(bytes, 8);
+}
+
+static const uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotr32(uint32_t x, int r) {
+    return (x >> r) | (x << (32 - r));
+}
+
+Sha256Hasher::Sha256Hasher() : totalLength_(0), bufferSize_(0) {
+    static const uint32_t initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    std::memcpy(state_, initial, sizeof(state_));
+}
+
+void Sha256Hasher::processBlock(const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + kSha256K[i] + w[i];
+        uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+    state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+}
+
+void Sha256Hasher::update(const uint8_t* data, size_t size) {
+    totalLength_ += size;
+
+    if (bufferSize_ > 0) {
+        size_t take = 64 - bufferSize_;
+        if (take > size) take = size;
+        std::memcpy(buffer_ + bufferSize_, data, take);
+        bufferSize_ += take;
+        data += take;
+        size -= take;
+
+        if (bufferSize_ < 64) return;
+        processBlock(buffer_);
+        bufferSize_ = 0;
+    }
+
+    while (size >= 64) {
+        processBlock(data);
+        data += 64;
+        size -= 64;
+    }
+
+    if (size > 0) {
+        std::memcpy(buffer_, data, size);
+        bufferSize_ = size;
+    }
+}
+
+std::string Sha256Hasher::hexDigest() const {
+    Sha256Hasher copy(*this);
+
+    // Padding: 0x80, zeros, then the message length in bits (big-endian)
+    uint64_t bitLength = totalLength_ * 8;
+    uint8_t padding[72] = {0x80};
+    size_t padLength = (copy.bufferSize_ < 56) ? (56 - copy.bufferSize_) : (120 - copy.bufferSize_);
+    for (int i = 0; i < 8; ++i) {
+        padding[padLength + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    copy.update(padding, padLength + 8);
+
+    uint8_t bytes[32];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i * 4] = static_cast<uint8_t>(copy.state_[i] >> 24);
+        bytes[i * 4 + 1] = static_cast<uint8_t>(copy.state_[i] >> 16);
+        bytes[i * 4 + 2] = static_cast<uint8_t>(copy.state_[i] >> 8);
+        bytes[i * 4 + 3] = static_cast<uint8_t>(copy.state_[i]);
+    }
+    return toHex(bytes, 32);
+}
+
+} // namespace baja_xlsx
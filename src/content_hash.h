@@ -0,0 +1,50 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace baja_xlsx {
+
+// Streaming XXH64: fast non-cryptographic digest used to identify media payloads
+class Xxh64Hasher {
+public:
+    explicit Xxh64Hasher(uint64_t seed = 0);
+
+    void update(const uint8_t* data, size_t size);
+    uint64_t digest() const;
+
+    // 16 lowercase hex digits
+    std::string hexDigest() const;
+
+private:
+    uint64_t v_[4];
+    uint64_t seed_;
+    uint64_t totalLength_;
+    uint8_t buffer_[32];
+    size_t bufferSize_;
+};
+
+// Streaming SHA-256 (FIPS 180-4)
+class Sha256Hasher {
+public:
+    Sha256Hasher();
+
+    void update(const uint8_t* data, size_t size);
+
+    // 64 lowercase hex digits; finalizes a copy, so update() may continue afterwards
+    std::string hexDigest() const;
+
+private:
+    void processBlock(const uint8_t* block);
+
+    uint32_t state_[8];
+    uint64_t totalLength_;
+    uint8_t buffer_[64];
+    size_t bufferSize_;
+};
+
+} // namespace baja_xlsx
+
+#endif // CONTENT_HASH_H
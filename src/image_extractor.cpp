@@ -1,29 +1,80 @@
 #include "image_extractor.h"
+#include "image_format.h"
+#include "content_hash.h"
+#include "zip_archive.h"
+#include "inflate.h"
+#include "ooxml_parts.h"
 #include <zip.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <sstream>
 #include <cstring>
+#include <charconv>
 
 namespace baja_xlsx {
 
-ImageExtractor::ImageExtractor() {
+// Parse a decimal coordinate such as the text of <xdr:col>
+static bool parseIntField(std::string_view text, int& outValue) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\n' || text.front() == '\r' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    auto result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+    return result.ec == std::errc();
 }
 
-ImageExtractor::~ImageExtractor() {
+// Parse one <xdr:from> or <xdr:to> marker; false leaves the outputs untouched
+static bool parseAnchorMarker(std::string_view anchorXml, std::string_view openTag, std::string_view closeTag,
+                              int& outCol, int& outRow, int64_t& outColOff, int64_t& outRowOff) {
+    size_t start = anchorXml.find(openTag);
+    if (start == std::string::npos) return false;
+    size_t end = anchorXml.find(closeTag, start);
+    if (end == std::string::npos) end = anchorXml.length();
+    std::string_view section = anchorXml.substr(start, end - start);
+    
+    auto field = [&](std::string_view tag, std::string_view close, std::string_view& outText) {
+        size_t pos = section.find(tag);
+        if (pos == std::string::npos) return false;
+        size_t fieldEnd = section.find(close, pos);
+        if (fieldEnd == std::string::npos) return false;
+        outText = section.substr(pos + tag.size(), fieldEnd - pos - tag.size());
+        return true;
+    };
+    
+    std::string_view colStr, rowStr, colOffStr, rowOffStr;
+    int col = 0, row = 0;
+    if (!field("<xdr:col>", "</xdr:col>", colStr) || !field("<xdr:row>", "</xdr:row>", rowStr) ||
+        !parseIntField(colStr, col) || !parseIntField(rowStr, row)) {
+        return false;
+    }
+    
+    // Offsets are optional in practice; a malformed one is treated as 0
+    int64_t colOff = 0, rowOff = 0;
+    if (field("<xdr:colOff>", "</xdr:colOff>", colOffStr)) {
+        while (!colOffStr.empty() && colOffStr.front() == ' ') colOffStr.remove_prefix(1);
+        if (std::from_chars(colOffStr.data(), colOffStr.data() + colOffStr.size(), colOff).ec != std::errc()) colOff = 0;
+    }
+    if (field("<xdr:rowOff>", "</xdr:rowOff>", rowOffStr)) {
+        while (!rowOffStr.empty() && rowOffStr.front() == ' ') rowOffStr.remove_prefix(1);
+        if (std::from_chars(rowOffStr.data(), rowOffStr.data() + rowOffStr.size(), rowOff).ec != std::errc()) rowOff = 0;
+    }
+    
+    outCol = col;
+    outRow = row;
+    outColOff = colOff;
+    outRowOff = rowOff;
+    return true;
 }
 
-std::string ImageExtractor::getContentType(const std::string& extension) {
-    std::string ext = extension;
-    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-    
-    if (ext == ".png") return "image/png";
-    if (ext == ".jpg" || ext == ".jpeg") return "image/jpeg";
-    if (ext == ".gif") return "image/gif";
-    if (ext == ".bmp") return "image/bmp";
-    if (ext == ".emf") return "image/x-emf";
-    if (ext == ".wmf") return "image/x-wmf";
-    
-    return "application/octet-stream";
+// View raw part bytes as XML text without copying
+static std::string_view asXmlText(const std::vector<uint8_t>& data) {
+    return std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+ImageExtractor::ImageExtractor() : computeSha256_(false), control_(nullptr) {
+}
+
+ImageExtractor::~ImageExtractor() {
 }
 
 bool ImageExtractor::readFileFromZip(void* zipArchive, const std::string& filename, 
@@ -42,20 +93,24 @@ bool ImageExtractor::readFileFromZip(void* zipArchive, const std::string& filena
         return false;
     }
     
+    // Never size a buffer from a declared length we have not vetted
+    if (!checkEntrySize(filename, sb.size, limits_, lastError_)) {
+        return false;
+    }
+    
     // Read file
-    zip_file_t* zf = zip_fopen_index(za, index, 0);
-    if (!zf) {
+    if (!inflateZipEntry(za, index, outData)) {
         return false;
     }
     
-    outData.resize(sb.size);
-    zip_int64_t bytesRead = zip_fread(zf, outData.data(), sb.size);
-    zip_fclose(zf);
+    if (control_) {
+        control_->addBytesInflated(outData.size());
+    }
     
-    return bytesRead == static_cast<zip_int64_t>(sb.size);
+    return true;
 }
 
-std::map<std::string, std::string> ImageExtractor::parseRelationships(const std::string& xmlContent) {
+std::map<std::string, std::string> ImageExtractor::parseRelationships(std::string_view xmlContent) {
     std::map<std::string, std::string> rIdMap;
     
     // Parse XML like: <Relationship Id="rId1" Type="..." Target="../media/image1.png"/>
@@ -67,7 +122,7 @@ std::map<std::string, std::string> ImageExtractor::parseRelationships(const std:
         }
         if (endPos == std::string::npos) break;
         
-        std::string relXml = xmlContent.substr(pos, endPos - pos);
+        std::string_view relXml = xmlContent.substr(pos, endPos - pos);
         
         // Extract Id
         std::string rId;
@@ -75,7 +130,7 @@ std::map<std::string, std::string> ImageExtractor::parseRelationships(const std:
         if (idPos != std::string::npos) {
             size_t idEnd = relXml.find("\"", idPos + 4);
             if (idEnd != std::string::npos) {
-                rId = relXml.substr(idPos + 4, idEnd - idPos - 4);
+                rId = std::string(relXml.substr(idPos + 4, idEnd - idPos - 4));
             }
         }
         
@@ -85,7 +140,7 @@ std::map<std::string, std::string> ImageExtractor::parseRelationships(const std:
         if (targetPos != std::string::npos) {
             size_t targetEnd = relXml.find("\"", targetPos + 8);
             if (targetEnd != std::string::npos) {
-                target = relXml.substr(targetPos + 8, targetEnd - targetPos - 8);
+                target = std::string(relXml.substr(targetPos + 8, targetEnd - targetPos - 8));
                 
                 // Extract just the filename from path like "../media/image1.png"
                 size_t lastSlash = target.find_last_of('/');
@@ -105,7 +160,7 @@ std::map<std::string, std::string> ImageExtractor::parseRelationships(const std:
     return rIdMap;
 }
 
-bool ImageExtractor::parseDrawingXml(const std::string& xmlContent,
+bool ImageExtractor::parseDrawingXml(std::string_view xmlContent,
                                      const std::string& sheetName,
                                      const std::map<std::string, std::string>& rIdToImageMap,
                                      std::vector<DrawingAnchor>& outAnchors) {
@@ -122,73 +177,22 @@ bool ImageExtractor::parseDrawingXml(const std::string& xmlContent,
         size_t endPos = xmlContent.find("</xdr:twoCellAnchor>", pos);
         if (endPos == std::string::npos) break;
         
-        std::string anchorXml = xmlContent.substr(pos, endPos - pos);
-        
-        // Parse from coordinates
-        size_t fromPos = anchorXml.find("<xdr:from>");
-        if (fromPos != std::string::npos) {
-            size_t fromEnd = anchorXml.find("</xdr:from>", fromPos);
-            if (fromEnd == std::string::npos) fromEnd = anchorXml.length();
-            
-            std::string fromSection = anchorXml.substr(fromPos, fromEnd - fromPos);
-            
-            size_t colPos = fromSection.find("<xdr:col>");
-            size_t rowPos = fromSection.find("<xdr:row>");
-            
-            if (colPos != std::string::npos && rowPos != std::string::npos) {
-                size_t colEnd = fromSection.find("</xdr:col>", colPos);
-                size_t rowEnd = fromSection.find("</xdr:row>", rowPos);
-                
-                if (colEnd != std::string::npos && rowEnd != std::string::npos) {
-                    std::string colStr = fromSection.substr(colPos + 9, colEnd - colPos - 9);  // <xdr:col> is 9 chars
-                    std::string rowStr = fromSection.substr(rowPos + 9, rowEnd - rowPos - 9);  // <xdr:row> is 9 chars
-                    
-                    try {
-                        anchor.fromCol = std::stoi(colStr);
-                        anchor.fromRow = std::stoi(rowStr);
-                    } catch (const std::exception& e) {
-                        anchor.fromCol = 0;
-                        anchor.fromRow = 0;
-                    }
-                }
-            }
-        }
+        std::string_view anchorXml = xmlContent.substr(pos, endPos - pos);
         
-        // Parse to coordinates
-        size_t toPos = anchorXml.find("<xdr:to>");
-        if (toPos != std::string::npos) {
-            size_t toEnd = anchorXml.find("</xdr:to>", toPos);
-            if (toEnd == std::string::npos) toEnd = anchorXml.length();
-            
-            std::string toSection = anchorXml.substr(toPos, toEnd - toPos);
-            
-            size_t colPos = toSection.find("<xdr:col>");
-            size_t rowPos = toSection.find("<xdr:row>");
-            
-            if (colPos != std::string::npos && rowPos != std::string::npos) {
-                size_t colEnd = toSection.find("</xdr:col>", colPos);
-                size_t rowEnd = toSection.find("</xdr:row>", rowPos);
-                
-                if (colEnd != std::string::npos && rowEnd != std::string::npos) {
-                    std::string colStr = toSection.substr(colPos + 9, colEnd - colPos - 9);  // <xdr:col> is 9 chars
-                    std::string rowStr = toSection.substr(rowPos + 9, rowEnd - rowPos - 9);  // <xdr:row> is 9 chars
-                    try {
-                        anchor.toCol = std::stoi(colStr);
-                        anchor.toRow = std::stoi(rowStr);
-                    } catch (...) {
-                        anchor.toCol = 0;
-                        anchor.toRow = 0;
-                    }
-                }
-            }
-        }
+        anchor.fromCol = anchor.fromRow = anchor.toCol = anchor.toRow = 0;
+        anchor.fromColOff = anchor.fromRowOff = anchor.toColOff = anchor.toRowOff = 0;
+        
+        parseAnchorMarker(anchorXml, "<xdr:from>", "</xdr:from>",
+                          anchor.fromCol, anchor.fromRow, anchor.fromColOff, anchor.fromRowOff);
+        parseAnchorMarker(anchorXml, "<xdr:to>", "</xdr:to>",
+                          anchor.toCol, anchor.toRow, anchor.toColOff, anchor.toRowOff);
         
         // Try to find image reference (rId)
         size_t embedPos = anchorXml.find("r:embed=\"");
         if (embedPos != std::string::npos) {
             size_t quoteEnd = anchorXml.find("\"", embedPos + 9);
             if (quoteEnd != std::string::npos) {
-                std::string rId = anchorXml.substr(embedPos + 9, quoteEnd - embedPos - 9);
+                std::string rId(anchorXml.substr(embedPos + 9, quoteEnd - embedPos - 9));
                 
                 // Map rId to actual image filename
                 auto it = rIdToImageMap.find(rId);
@@ -216,49 +220,25 @@ bool ImageExtractor::parseDrawingXml(const std::string& xmlContent,
         size_t endPos = xmlContent.find("</xdr:oneCellAnchor>", pos);
         if (endPos == std::string::npos) break;
         
-        std::string anchorXml = xmlContent.substr(pos, endPos - pos);
-        
-        // Parse from coordinates
-        size_t fromPos = anchorXml.find("<xdr:from>");
-        if (fromPos != std::string::npos) {
-            size_t fromEnd = anchorXml.find("</xdr:from>", fromPos);
-            if (fromEnd == std::string::npos) fromEnd = anchorXml.length();
-            
-            std::string fromSection = anchorXml.substr(fromPos, fromEnd - fromPos);
-            
-            size_t colPos = fromSection.find("<xdr:col>");
-            size_t rowPos = fromSection.find("<xdr:row>");
-            
-            if (colPos != std::string::npos && rowPos != std::string::npos) {
-                size_t colEnd = fromSection.find("</xdr:col>", colPos);
-                size_t rowEnd = fromSection.find("</xdr:row>", rowPos);
-                
-                if (colEnd != std::string::npos && rowEnd != std::string::npos) {
-                    std::string colStr = fromSection.substr(colPos + 9, colEnd - colPos - 9);
-                    std::string rowStr = fromSection.substr(rowPos + 9, rowEnd - rowPos - 9);
-                    
-                    try {
-                        anchor.fromCol = std::stoi(colStr);
-                        anchor.fromRow = std::stoi(rowStr);
-                        // For oneCellAnchor, to is the same as from (embedded image)
-                        anchor.toCol = anchor.fromCol;
-                        anchor.toRow = anchor.fromRow;
-                    } catch (const std::exception& e) {
-                        anchor.fromCol = 0;
-                        anchor.fromRow = 0;
-                        anchor.toCol = 0;
-                        anchor.toRow = 0;
-                    }
-                }
-            }
-        }
+        std::string_view anchorXml = xmlContent.substr(pos, endPos - pos);
+        
+        anchor.fromCol = anchor.fromRow = 0;
+        anchor.fromColOff = anchor.fromRowOff = 0;
+        parseAnchorMarker(anchorXml, "<xdr:from>", "</xdr:from>",
+                          anchor.fromCol, anchor.fromRow, anchor.fromColOff, anchor.fromRowOff);
+        
+        // For oneCellAnchor, to is the same as from (embedded image)
+        anchor.toCol = anchor.fromCol;
+        anchor.toRow = anchor.fromRow;
+        anchor.toColOff = anchor.fromColOff;
+        anchor.toRowOff = anchor.fromRowOff;
         
         // Try to find image reference (rId)
         size_t embedPos = anchorXml.find("r:embed=\"");
         if (embedPos != std::string::npos) {
             size_t quoteEnd = anchorXml.find("\"", embedPos + 9);
             if (quoteEnd != std::string::npos) {
-                std::string rId = anchorXml.substr(embedPos + 9, quoteEnd - embedPos - 9);
+                std::string rId(anchorXml.substr(embedPos + 9, quoteEnd - embedPos - 9));
                 
                 // Map rId to actual image filename
                 auto it = rIdToImageMap.find(rId);
@@ -280,7 +260,54 @@ bool ImageExtractor::parseDrawingXml(const std::string& xmlContent,
     return true;
 }
 
-bool ImageExtractor::parseCellImagesXml(const std::string& xmlContent,
+std::map<std::string, std::string> ImageExtractor::mapDrawingSheets(void* zipArchive,
+                                                                    std::vector<uint8_t>& scratch,
+                                                                    std::string& outFirstSheet) {
+    std::map<std::string, std::string> drawingSheets;
+    outFirstSheet = "Sheet1";
+    
+    auto readPart = [&](const std::string& name) -> std::string_view {
+        if (!readFileFromZip(zipArchive, name, scratch)) return std::string_view();
+        return asXmlText(scratch);
+    };
+    
+    // Locate the workbook part through the package relationships
+    std::string workbookPart = "xl/workbook.xml";
+    for (const auto& rel : parseRelationshipList(readPart("_rels/.rels"))) {
+        if (relationshipTypeIs(rel.type, "officeDocument")) {
+            workbookPart = resolvePartTarget("", rel.target);
+            break;
+        }
+    }
+    
+    std::map<std::string, std::string> workbookTargets;
+    for (const auto& rel : parseRelationshipList(readPart(relationshipsPartFor(workbookPart)))) {
+        workbookTargets[rel.id] = resolvePartTarget(workbookPart, rel.target);
+    }
+    
+    std::vector<WorkbookSheetEntry> sheets = parseWorkbookSheets(readPart(workbookPart));
+    if (!sheets.empty()) {
+        outFirstSheet = sheets.front().name;
+    }
+    
+    for (const auto& sheet : sheets) {
+        auto target = workbookTargets.find(sheet.relId);
+        if (target == workbookTargets.end()) continue;
+        
+        const std::string& sheetPart = target->second;
+        for (const auto& rel : parseRelationshipList(readPart(relationshipsPartFor(sheetPart)))) {
+            if (relationshipTypeIs(rel.type, "drawing")) {
+                // A drawing shared by several sheets stays with the first of them
+                drawingSheets.emplace(resolvePartTarget(sheetPart, rel.target), sheet.name);
+            }
+        }
+    }
+    
+    scratch.clear();
+    return drawingSheets;
+}
+
+bool ImageExtractor::parseCellImagesXml(std::string_view xmlContent,
                                         const std::map<std::string, std::string>& rIdToImageMap,
                                         std::vector<CellImageInfo>& outCellImages) {
     // Parse WPS Excel cellimages.xml format
@@ -301,7 +328,7 @@ bool ImageExtractor::parseCellImagesXml(const std::string& xmlContent,
         size_t endPos = xmlContent.find("</etc:cellImage>", pos);
         if (endPos == std::string::npos) break;
         
-        std::string cellImageXml = xmlContent.substr(pos, endPos - pos);
+        std::string_view cellImageXml = xmlContent.substr(pos, endPos - pos);
         
         CellImageInfo cellImg;
         
@@ -310,7 +337,7 @@ bool ImageExtractor::parseCellImagesXml(const std::string& xmlContent,
         if (namePos != std::string::npos) {
             size_t nameEnd = cellImageXml.find("\"", namePos + 6);
             if (nameEnd != std::string::npos) {
-                cellImg.imageId = cellImageXml.substr(namePos + 6, nameEnd - namePos - 6);
+                cellImg.imageId = std::string(cellImageXml.substr(namePos + 6, nameEnd - namePos - 6));
             }
         }
         
@@ -319,7 +346,7 @@ bool ImageExtractor::parseCellImagesXml(const std::string& xmlContent,
         if (embedPos != std::string::npos) {
             size_t embedEnd = cellImageXml.find("\"", embedPos + 9);
             if (embedEnd != std::string::npos) {
-                std::string rId = cellImageXml.substr(embedPos + 9, embedEnd - embedPos - 9);
+                std::string rId(cellImageXml.substr(embedPos + 9, embedEnd - embedPos - 9));
                 
                 // Map rId to actual image filename
                 auto it = rIdToImageMap.find(rId);
@@ -343,16 +370,19 @@ bool ImageExtractor::parseCellImagesXml(const std::string& xmlContent,
 bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
                                      std::vector<ImageInfo>& outImages,
                                      std::vector<DrawingAnchor>& outAnchors) {
-    int errorp;
-    zip_t* za = zip_open(xlsxPath.c_str(), ZIP_RDONLY, &errorp);
-    
-    if (!za) {
-        zip_error_t error;
-        zip_error_init_with_code(&error, errorp);
-        lastError_ = std::string("Failed to open XLSX file as ZIP: ") + zip_error_strerror(&error);
-        zip_error_fini(&error);
+    lastError_.clear();
+    ZipArchive archive;
+    if (!archive.open(xlsxPath)) {
+        lastError_ = archive.getLastError();
+        return false;
+    }
+    
+    // Sizes, ratios and media count come from the central directory, so a
+    // bomb is rejected before a single byte is inflated
+    if (!checkArchiveLimits(archive, limits_, lastError_)) {
         return false;
     }
+    zip_t* za = static_cast<zip_t*>(archive.handle());
     
     // Get number of files in archive
     zip_int64_t numEntries = zip_get_num_entries(za, 0);
@@ -364,6 +394,9 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
     std::map<std::string, std::map<std::string, std::string>> drawingRelsMap;
     std::map<std::string, std::string> cellImagesRelsMap;  // WPS Excel cellimages.xml relationships
     
+    // One scratch buffer is reused for every XML part; parsers view it in place
+    std::vector<uint8_t> xmlScratch;
+    
     for (zip_int64_t i = 0; i < numEntries; i++) {
         const char* name = zip_get_name(za, i, 0);
         if (!name) continue;
@@ -372,10 +405,9 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         
         // Parse drawing relationship files (for floating images)
         if (filename.find("xl/drawings/_rels/") == 0 && filename.find(".xml.rels") != std::string::npos) {
-            std::vector<uint8_t> xmlData;
-            if (readFileFromZip(za, filename, xmlData)) {
+            if (readFileFromZip(za, filename, xmlScratch)) {
                 try {
-                    std::string xmlContent(xmlData.begin(), xmlData.end());
+                    std::string_view xmlContent = asXmlText(xmlScratch);
                     std::map<std::string, std::string> rIdMap = parseRelationships(xmlContent);
                     
                     // Extract drawing number (e.g., "drawing1.xml.rels" -> "drawing1")
@@ -388,7 +420,7 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
                         baseName = baseName.substr(0, xmlRelsPos);
                     }
                     
-                    drawingRelsMap[baseName] = rIdMap;
+                    drawingRelsMap[baseName] = std::move(rIdMap);
                 } catch (...) {
                     // Ignore parsing errors
                 }
@@ -397,10 +429,9 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         
         // Parse cellimages relationship file (for WPS Excel embedded images)
         if (filename == "xl/_rels/cellimages.xml.rels") {
-            std::vector<uint8_t> xmlData;
-            if (readFileFromZip(za, filename, xmlData)) {
+            if (readFileFromZip(za, filename, xmlScratch)) {
                 try {
-                    std::string xmlContent(xmlData.begin(), xmlData.end());
+                    std::string_view xmlContent = asXmlText(xmlScratch);
                     cellImagesRelsMap = parseRelationships(xmlContent);
                 } catch (...) {
                     // Ignore parsing errors
@@ -409,7 +440,11 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         }
     }
     
-    // Second pass: Extract images and parse drawing XML files
+    std::string firstSheet;
+    std::map<std::string, std::string> drawingSheets = mapDrawingSheets(za, xmlScratch, firstSheet);
+    
+    // Second pass: Collect media entries and parse drawing XML files
+    std::vector<std::string> mediaNames;
     for (zip_int64_t i = 0; i < numEntries; i++) {
         const char* name = zip_get_name(za, i, 0);
         if (!name) continue;
@@ -418,40 +453,17 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         
         // Check if it's in the media directory
         if (filename.find("xl/media/") == 0) {
-            ImageInfo img;
-            
-            if (readFileFromZip(za, filename, img.data)) {
-                // Extract just the filename without path
-                size_t lastSlash = filename.find_last_of('/');
-                img.filename = (lastSlash != std::string::npos) 
-                    ? filename.substr(lastSlash + 1) 
-                    : filename;
-                
-                // Skip invalid images (empty name or empty data)
-                if (img.filename.empty() || img.data.empty()) {
-                    continue;
-                }
-                
-                // Determine content type from extension
-                size_t dotPos = img.filename.find_last_of('.');
-                if (dotPos != std::string::npos) {
-                    img.contentType = getContentType(img.filename.substr(dotPos));
-                } else {
-                    img.contentType = "application/octet-stream";
-                }
-                
-                outImages.push_back(img);
-            }
+            // Media is inflated and hashed after this pass, in parallel
+            mediaNames.push_back(filename);
         }
         
         // Parse drawing XML files for image positions
         if (filename.find("xl/drawings/drawing") == 0 && 
             filename.find(".xml") != std::string::npos &&
             filename.find(".rels") == std::string::npos) {
-            std::vector<uint8_t> xmlData;
-            if (readFileFromZip(za, filename, xmlData)) {
+            if (readFileFromZip(za, filename, xmlScratch)) {
                 try {
-                    std::string xmlContent(xmlData.begin(), xmlData.end());
+                    std::string_view xmlContent = asXmlText(xmlScratch);
                     
                     // Extract drawing number
                     size_t lastSlash = filename.find_last_of('/');
@@ -464,14 +476,15 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
                     }
                     
                     // Get corresponding rId mapping
-                    std::map<std::string, std::string> rIdMap;
+                    static const std::map<std::string, std::string> emptyMap;
                     auto it = drawingRelsMap.find(baseName);
-                    if (it != drawingRelsMap.end()) {
-                        rIdMap = it->second;
-                    }
+                    const std::map<std::string, std::string>& rIdMap =
+                        (it != drawingRelsMap.end()) ? it->second : emptyMap;
                     
-                    // Extract sheet name from filename (simplified)
-                    std::string sheetName = "Sheet1"; // Default, should be mapped from relationships
+                    // Drawings no sheet refers to are attributed to the first sheet
+                    auto sheetIt = drawingSheets.find(filename);
+                    const std::string& sheetName =
+                        (sheetIt != drawingSheets.end()) ? sheetIt->second : firstSheet;
                     
                     parseDrawingXml(xmlContent, sheetName, rIdMap, outAnchors);
                 } catch (...) {
@@ -482,10 +495,9 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         
         // Parse cellimages.xml for WPS Excel embedded images
         if (filename == "xl/cellimages.xml") {
-            std::vector<uint8_t> xmlData;
-            if (readFileFromZip(za, filename, xmlData)) {
+            if (readFileFromZip(za, filename, xmlScratch)) {
                 try {
-                    std::string xmlContent(xmlData.begin(), xmlData.end());
+                    std::string_view xmlContent = asXmlText(xmlScratch);
                     
                     // Use the dedicated cellimages.xml.rels mapping (WPS Excel)
                     parseCellImagesXml(xmlContent, cellImagesRelsMap, cellImageMappings_);
@@ -496,10 +508,192 @@ bool ImageExtractor::extractFromXlsx(const std::string& xlsxPath,
         }
     }
     
-    zip_close(za);
+    // readFileFromZip only sets lastError_ when a part exceeds the limits;
+    // a partial result would look like a workbook without those parts
+    if (!lastError_.empty()) {
+        outAnchors.clear();
+        cellImageMappings_.clear();
+        return false;
+    }
+    
+    extractMedia(xlsxPath, za, mediaNames, outImages);
+    
+    if (control_ && control_->cancelled()) {
+        lastError_ = kReadAbortedError;
+        outImages.clear();
+        return false;
+    }
+    
     return true;
 }
 
+// Name, digests and sniffed format of a fully inflated media part
+static void finishMediaEntry(const std::string& filename, Xxh64Hasher& xxh, Sha256Hasher* sha,
+                             ImageInfo& outImage) {
+    // Extract just the filename without path
+    size_t lastSlash = filename.find_last_of('/');
+    outImage.filename = (lastSlash != std::string::npos) 
+        ? filename.substr(lastSlash + 1) 
+        : filename;
+    
+    outImage.hash = xxh.hexDigest();
+    if (sha) {
+        outImage.sha256 = sha->hexDigest();
+    }
+    
+    // Determine content type and size from the header bytes;
+    // the extension is only a fallback for formats we don't recognize
+    ImageFormatInfo format;
+    if (sniffImageFormat(outImage.data.data(), outImage.data.size(), format)) {
+        outImage.contentType = format.contentType;
+    } else {
+        outImage.contentType = contentTypeFromExtension(outImage.filename);
+    }
+    outImage.width = format.width;
+    outImage.height = format.height;
+}
+
+bool ImageExtractor::readMediaEntry(void* zipArchive, const std::string& filename, ImageInfo& outImage) {
+    zip_t* za = static_cast<zip_t*>(zipArchive);
+    
+    zip_int64_t index = zip_name_locate(za, filename.c_str(), 0);
+    if (index < 0) {
+        return false;
+    }
+    
+    struct zip_stat sb;
+    if (zip_stat_index(za, index, 0, &sb) != 0) {
+        return false;
+    }
+    
+    // Runs on worker threads, so no lastError_ here; extractFromXlsx has
+    // already refused archives whose media exceed the limits
+    std::string limitError;
+    if (!checkEntrySize(filename, sb.size, limits_, limitError)) {
+        return false;
+    }
+    
+    Xxh64Hasher xxh;
+    Sha256Hasher sha;
+    
+    // A one-shot inflate backend decodes the whole entry at once; hash afterwards
+    if (inflateAvailable()) {
+        if (control_ && control_->cancelled()) {
+            return false;
+        }
+        if (!inflateZipEntry(za, index, outImage.data)) {
+            return false;
+        }
+        if (control_) {
+            control_->addBytesInflated(outImage.data.size());
+        }
+        xxh.update(outImage.data.data(), outImage.data.size());
+        if (computeSha256_) {
+            sha.update(outImage.data.data(), outImage.data.size());
+        }
+        finishMediaEntry(filename, xxh, computeSha256_ ? &sha : nullptr, outImage);
+        return true;
+    }
+    
+    zip_file_t* zf = zip_fopen_index(za, index, 0);
+    if (!zf) {
+        return false;
+    }
+    
+    // Inflate in chunks and hash each chunk while it is still in cache. The
+    // buffer grows with the bytes actually inflated: the declared size is only
+    // trusted up to kEntryReserveLimit, so a forged one cannot force a huge allocation
+    const zip_uint64_t chunkSize = 64 * 1024;
+    
+    outImage.data.clear();
+    outImage.data.reserve(static_cast<size_t>(std::min<zip_uint64_t>(sb.size, kEntryReserveLimit)));
+    zip_uint64_t offset = 0;
+    while (offset < sb.size) {
+        zip_uint64_t want = std::min(chunkSize, sb.size - offset);
+        outImage.data.resize(static_cast<size_t>(offset + want));
+        zip_int64_t n = zip_fread(zf, outImage.data.data() + offset, want);
+        outImage.data.resize(static_cast<size_t>(offset + (n > 0 ? n : 0)));
+        if (n <= 0) break;
+        
+        if (control_) {
+            if (control_->cancelled()) break;
+            control_->addBytesInflated(static_cast<uint64_t>(n));
+        }
+        
+        xxh.update(outImage.data.data() + offset, static_cast<size_t>(n));
+        if (computeSha256_) {
+            sha.update(outImage.data.data() + offset, static_cast<size_t>(n));
+        }
+        offset += static_cast<zip_uint64_t>(n);
+    }
+    zip_fclose(zf);
+    
+    if (offset != sb.size) {
+        return false;
+    }
+    
+    finishMediaEntry(filename, xxh, computeSha256_ ? &sha : nullptr, outImage);
+    return true;
+}
+
+void ImageExtractor::extractMedia(const std::string& xlsxPath, void* zipArchive,
+                                  const std::vector<std::string>& mediaNames,
+                                  std::vector<ImageInfo>& outImages) {
+    std::vector<ImageInfo> images(mediaNames.size());
+    std::vector<char> readOk(mediaNames.size(), 0);
+    
+    size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), kMaxMediaThreads);
+    threadCount = std::min(threadCount, mediaNames.size() / 2);
+    
+    if (threadCount <= 1) {
+        for (size_t i = 0; i < mediaNames.size(); ++i) {
+            if (control_ && control_->cancelled()) break;
+            readOk[i] = readMediaEntry(zipArchive, mediaNames[i], images[i]);
+        }
+    } else {
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        
+        for (size_t t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&]() {
+                // libzip handles are not thread-safe, so every worker opens its own
+                int errorp;
+                zip_t* za = zip_open(xlsxPath.c_str(), ZIP_RDONLY, &errorp);
+                if (!za) return;
+                
+                for (;;) {
+                    size_t i = next.fetch_add(1);
+                    if (i >= mediaNames.size()) break;
+                    if (control_ && control_->cancelled()) break;
+                    readOk[i] = readMediaEntry(za, mediaNames[i], images[i]);
+                }
+                zip_discard(za);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        // A worker that cannot open its own handle (e.g. out of file descriptors
+        // under readMany) leaves its share to the others; anything no worker
+        // claimed is read here through the caller's archive
+        for (size_t i = next.load(); i < mediaNames.size(); ++i) {
+            if (control_ && control_->cancelled()) break;
+            readOk[i] = readMediaEntry(zipArchive, mediaNames[i], images[i]);
+        }
+    }
+    
+    // Keep archive order
+    for (size_t i = 0; i < images.size(); ++i) {
+        // Skip invalid images (empty name or empty data)
+        if (!readOk[i] || images[i].filename.empty() || images[i].data.empty()) {
+            continue;
+        }
+        outImages.push_back(std::move(images[i]));
+    }
+}
+
 } // namespace baja_xlsx
 
 
@@ -1,16 +1,24 @@
 #ifndef IMAGE_EXTRACTOR_H
 #define IMAGE_EXTRACTOR_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include "read_limits.h"
+#include "read_control.h"
 
 namespace baja_xlsx {
 
 struct ImageInfo {
     std::string filename;
     std::vector<uint8_t> data;
-    std::string contentType;
+    std::string contentType;  // from header bytes, falls back to the extension
+    int width;                // pixels from the image header, 0 if unknown
+    int height;
+    std::string hash;         // XXH64 of the bytes, 16 hex digits
+    std::string sha256;       // SHA-256 hex, only when enabled
 };
 
 struct DrawingAnchor {
@@ -20,6 +28,10 @@ struct DrawingAnchor {
     int fromRow;
     int toCol;
     int toRow;
+    int64_t fromColOff;    // offsets into the from/to cells, in EMU
+    int64_t fromRowOff;
+    int64_t toColOff;
+    int64_t toRowOff;
 };
 
 // WPS Excel embedded image info (from cellimages.xml)
@@ -38,6 +50,15 @@ public:
                         std::vector<ImageInfo>& outImages,
                         std::vector<DrawingAnchor>& outAnchors);
     
+    // Also compute SHA-256 for every media part (XXH64 is always computed)
+    void setComputeSha256(bool enabled) { computeSha256_ = enabled; }
+    
+    // Refuse archives and parts that exceed these limits
+    void setLimits(const ReadLimits& limits) { limits_ = limits; }
+    
+    // Report inflated bytes to, and stop early when cancelled through, control (may be null)
+    void setControl(ReadControl* control) { control_ = control; }
+    
     // Get cell image mappings (WPS Excel format)
     const std::vector<CellImageInfo>& getCellImageMappings() const { return cellImageMappings_; }
     
@@ -46,27 +67,42 @@ public:
 private:
     std::string lastError_;
     std::vector<CellImageInfo> cellImageMappings_;  // WPS Excel cell image ID to filename mapping
+    bool computeSha256_;
+    ReadLimits limits_;
+    ReadControl* control_;
+    
+    static constexpr size_t kMaxMediaThreads = 8;
     
     // Helper to read file from ZIP
     bool readFileFromZip(void* zipArchive, const std::string& filename, 
                         std::vector<uint8_t>& outData);
     
+    // Inflate one media part, hashing and sniffing it on the way
+    bool readMediaEntry(void* zipArchive, const std::string& filename, ImageInfo& outImage);
+    
+    // Inflate all media parts, in parallel when there are enough of them
+    void extractMedia(const std::string& xlsxPath, void* zipArchive,
+                      const std::vector<std::string>& mediaNames,
+                      std::vector<ImageInfo>& outImages);
+    
     // Parse drawing XML to get image positions
-    bool parseDrawingXml(const std::string& xmlContent,
+    bool parseDrawingXml(std::string_view xmlContent,
                         const std::string& sheetName,
                         const std::map<std::string, std::string>& rIdToImageMap,
                         std::vector<DrawingAnchor>& outAnchors);
     
+    // Map drawing parts ("xl/drawings/drawing1.xml") to the name of the sheet
+    // that references them, following workbook and sheet relationships
+    std::map<std::string, std::string> mapDrawingSheets(void* zipArchive, std::vector<uint8_t>& scratch,
+                                                        std::string& outFirstSheet);
+    
     // Parse cellimages.xml (WPS Excel embedded images)
-    bool parseCellImagesXml(const std::string& xmlContent,
+    bool parseCellImagesXml(std::string_view xmlContent,
                            const std::map<std::string, std::string>& rIdToImageMap,
                            std::vector<CellImageInfo>& outCellImages);
     
     // Parse relationship XML to map rId to image filenames
-    std::map<std::string, std::string> parseRelationships(const std::string& xmlContent);
-    
-    // Get content type from content types XML
-    std::string getContentType(const std::string& extension);
+    std::map<std::string, std::string> parseRelationships(std::string_view xmlContent);
 };
 
 } // namespace baja_xlsx
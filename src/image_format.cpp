@@ -0,0 +1,200 @@
+#include "image_format.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace baja_xlsx {
+
+static uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint16_t readBE16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static uint32_t readBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static void sniffJpegSize(const uint8_t* data, size_t size, ImageFormatInfo& outInfo) {
+    // Walk the marker segments until a start-of-frame marker
+    size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xFF) return;
+
+        uint8_t marker = data[pos + 1];
+        if (marker == 0xFF) {
+            // Fill byte
+            pos++;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD9)) {
+            // Standalone markers carry no length
+            pos += 2;
+            continue;
+        }
+
+        uint16_t segmentLength = readBE16(data + pos + 2);
+        bool isStartOfFrame = marker >= 0xC0 && marker <= 0xCF &&
+                              marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (isStartOfFrame) {
+            // length(2) precision(1) height(2) width(2)
+            if (pos + 9 <= size) {
+                outInfo.height = readBE16(data + pos + 5);
+                outInfo.width = readBE16(data + pos + 7);
+            }
+            return;
+        }
+        if (segmentLength < 2) return;
+        pos += 2 + segmentLength;
+    }
+}
+
+static void sniffWebpSize(const uint8_t* data, size_t size, ImageFormatInfo& outInfo) {
+    if (size < 30) return;
+
+    if (std::memcmp(data + 12, "VP8 ", 4) == 0) {
+        // Lossy: frame tag (3) + start code (3), then 14-bit width and height
+        outInfo.width = readLE16(data + 26) & 0x3FFF;
+        outInfo.height = readLE16(data + 28) & 0x3FFF;
+    } else if (std::memcmp(data + 12, "VP8L", 4) == 0) {
+        // Lossless: signature 0x2F, then 14-bit width-1 and height-1
+        const uint8_t* b = data + 21;
+        outInfo.width = 1 + (((b[1] & 0x3F) << 8) | b[0]);
+        outInfo.height = 1 + (((b[3] & 0x0F) << 10) | (b[2] << 2) | ((b[1] & 0xC0) >> 6));
+    } else if (std::memcmp(data + 12, "VP8X", 4) == 0) {
+        // Extended: 24-bit canvas width-1 and height-1
+        outInfo.width = 1 + static_cast<int>(data[24] | (data[25] << 8) | (data[26] << 16));
+        outInfo.height = 1 + static_cast<int>(data[27] | (data[28] << 8) | (data[29] << 16));
+    }
+}
+
+bool sniffImageFormat(const uint8_t* data, size_t size, ImageFormatInfo& outInfo) {
+    outInfo.contentType.clear();
+    outInfo.width = 0;
+    outInfo.height = 0;
+
+    if (!data || size < 4) {
+        return false;
+    }
+
+    // PNG: signature, then the IHDR chunk
+    static const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    if (size >= 8 && std::memcmp(data, pngSignature, 8) == 0) {
+        outInfo.contentType = "image/png";
+        if (size >= 24 && std::memcmp(data + 12, "IHDR", 4) == 0) {
+            outInfo.width = static_cast<int>(readBE32(data + 16));
+            outInfo.height = static_cast<int>(readBE32(data + 20));
+        }
+        return true;
+    }
+
+    // JPEG: SOI followed by another marker
+    if (data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+        outInfo.contentType = "image/jpeg";
+        sniffJpegSize(data, size, outInfo);
+        return true;
+    }
+
+    // GIF: logical screen descriptor follows the 6-byte signature
+    if (size >= 10 && (std::memcmp(data, "GIF87a", 6) == 0 || std::memcmp(data, "GIF89a", 6) == 0)) {
+        outInfo.contentType = "image/gif";
+        outInfo.width = readLE16(data + 6);
+        outInfo.height = readLE16(data + 8);
+        return true;
+    }
+
+    // BMP: file header (14) followed by a DIB header
+    if (data[0] == 'B' && data[1] == 'M' && size >= 26) {
+        outInfo.contentType = "image/bmp";
+        uint32_t dibSize = readLE32(data + 14);
+        if (dibSize == 12) {
+            // BITMAPCOREHEADER: 16-bit dimensions
+            outInfo.width = readLE16(data + 18);
+            outInfo.height = readLE16(data + 20);
+        } else {
+            // BITMAPINFOHEADER and later: signed 32-bit, negative height means top-down
+            int32_t height = static_cast<int32_t>(readLE32(data + 22));
+            outInfo.width = static_cast<int32_t>(readLE32(data + 18));
+            outInfo.height = height < 0 ? -height : height;
+        }
+        return true;
+    }
+
+    // WebP: RIFF container with WEBP form type
+    if (size >= 16 && std::memcmp(data, "RIFF", 4) == 0 && std::memcmp(data + 8, "WEBP", 4) == 0) {
+        outInfo.contentType = "image/webp";
+        sniffWebpSize(data, size, outInfo);
+        return true;
+    }
+
+    // EMF: EMR_HEADER record (type 1) with " EMF" signature; rclBounds is in device pixels
+    if (size >= 44 && readLE32(data) == 1 && readLE32(data + 40) == 0x464D4520) {
+        outInfo.contentType = "image/x-emf";
+        int32_t left = static_cast<int32_t>(readLE32(data + 8));
+        int32_t top = static_cast<int32_t>(readLE32(data + 12));
+        int32_t right = static_cast<int32_t>(readLE32(data + 16));
+        int32_t bottom = static_cast<int32_t>(readLE32(data + 20));
+        if (right >= left && bottom >= top) {
+            outInfo.width = right - left + 1;
+            outInfo.height = bottom - top + 1;
+        }
+        return true;
+    }
+
+    // WMF: placeable header carries a bounding box in logical units plus units per inch
+    if (readLE32(data) == 0x9AC6CDD7) {
+        outInfo.contentType = "image/x-wmf";
+        if (size >= 16) {
+            int16_t left = static_cast<int16_t>(readLE16(data + 6));
+            int16_t top = static_cast<int16_t>(readLE16(data + 8));
+            int16_t right = static_cast<int16_t>(readLE16(data + 10));
+            int16_t bottom = static_cast<int16_t>(readLE16(data + 12));
+            uint16_t unitsPerInch = readLE16(data + 14);
+            if (unitsPerInch > 0) {
+                // Report at 96 DPI, the resolution Excel lays pictures out at
+                outInfo.width = std::abs(right - left) * 96 / unitsPerInch;
+                outInfo.height = std::abs(bottom - top) * 96 / unitsPerInch;
+            }
+        }
+        return true;
+    }
+
+    // WMF without placeable header (memory or disk metafile): no size information
+    if ((readLE16(data) == 1 || readLE16(data) == 2) && readLE16(data + 2) == 9) {
+        outInfo.contentType = "image/x-wmf";
+        return true;
+    }
+
+    return false;
+}
+
+std::string contentTypeFromExtension(const std::string& filename) {
+    size_t dotPos = filename.find_last_of('.');
+    if (dotPos == std::string::npos) {
+        return "application/octet-stream";
+    }
+
+    std::string ext = filename.substr(dotPos);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    if (ext == ".png") return "image/png";
+    if (ext == ".jpg" || ext == ".jpeg") return "image/jpeg";
+    if (ext == ".gif") return "image/gif";
+    if (ext == ".bmp") return "image/bmp";
+    if (ext == ".emf") return "image/x-emf";
+    if (ext == ".wmf") return "image/x-wmf";
+    if (ext == ".webp") return "image/webp";
+
+    return "application/octet-stream";
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,26 @@
+#ifndef IMAGE_FORMAT_H
+#define IMAGE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace baja_xlsx {
+
+struct ImageFormatInfo {
+    std::string contentType;  // MIME type, e.g. "image/png"
+    int width;                // pixels, 0 if the header does not say
+    int height;               // pixels, 0 if the header does not say
+};
+
+// Identify an image from its header bytes (PNG, JPEG, GIF, BMP, EMF, WMF, WebP)
+// and read its dimensions without decoding pixels. Returns false if the format
+// is not recognized; outInfo is left with an empty content type in that case.
+bool sniffImageFormat(const uint8_t* data, size_t size, ImageFormatInfo& outInfo);
+
+// MIME type from a file name's extension, e.g. "image1.PNG" -> "image/png"
+std::string contentTypeFromExtension(const std::string& filename);
+
+} // namespace baja_xlsx
+
+#endif // IMAGE_FORMAT_H
@@ -0,0 +1,116 @@
+#include "inflate.h"
+
+#if defined(BAJA_INFLATE_LIBDEFLATE)
+#include <libdeflate.h>
+#elif defined(BAJA_INFLATE_ZLIB_NG)
+#include <zlib-ng.h>
+#include <algorithm>
+#endif
+
+namespace baja_xlsx {
+
+#if defined(BAJA_INFLATE_LIBDEFLATE)
+
+// A decompressor is reusable but not shareable; media are inflated on worker threads
+struct DecompressorHolder {
+    libdeflate_decompressor* decompressor = libdeflate_alloc_decompressor();
+    ~DecompressorHolder() {
+        if (decompressor) libdeflate_free_decompressor(decompressor);
+    }
+};
+
+bool inflateAvailable() {
+    return true;
+}
+
+const char* inflateBackendName() {
+    return "libdeflate";
+}
+
+bool inflateRaw(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    static thread_local DecompressorHolder holder;
+    if (!holder.decompressor) return false;
+
+    // No actual_out: anything but exactly outSize bytes is an error
+    return libdeflate_deflate_decompress(holder.decompressor, in, inSize, out, outSize, nullptr) ==
+           LIBDEFLATE_SUCCESS;
+}
+
+uint32_t inflateCrc32(const uint8_t* data, size_t size) {
+    return libdeflate_crc32(0, data, size);
+}
+
+#elif defined(BAJA_INFLATE_ZLIB_NG)
+
+bool inflateAvailable() {
+    return true;
+}
+
+const char* inflateBackendName() {
+    return "zlib-ng";
+}
+
+bool inflateRaw(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    zng_stream stream = {};
+    if (zng_inflateInit2(&stream, -15) != Z_OK) return false;
+
+    // avail_in / avail_out are 32-bit; entries above 4 GB are fed in slices
+    const size_t kSlice = 0x40000000;
+    size_t inPos = 0;
+    size_t outPos = 0;
+    uint8_t spare = 0;
+    int status = Z_OK;
+    while (status == Z_OK) {
+        if (stream.avail_in == 0) {
+            size_t chunk = std::min(inSize - inPos, kSlice);
+            stream.next_in = in + inPos;
+            stream.avail_in = static_cast<uint32_t>(chunk);
+            inPos += chunk;
+        }
+        if (stream.avail_out == 0) {
+            if (outPos == outSize) {
+                // Room for the end of the stream; a byte written here is an overrun
+                if (stream.total_out > outSize) break;
+                stream.next_out = &spare;
+                stream.avail_out = 1;
+            } else {
+                size_t chunk = std::min(outSize - outPos, kSlice);
+                stream.next_out = out + outPos;
+                stream.avail_out = static_cast<uint32_t>(chunk);
+                outPos += chunk;
+            }
+        }
+        // Z_BUF_ERROR: no progress possible, the input is truncated or the output too small
+        status = zng_inflate(&stream, Z_NO_FLUSH);
+    }
+    bool complete = status == Z_STREAM_END && stream.total_out == outSize;
+    zng_inflateEnd(&stream);
+    return complete;
+}
+
+uint32_t inflateCrc32(const uint8_t* data, size_t size) {
+    // zng_crc32_z takes a size_t length
+    return static_cast<uint32_t>(zng_crc32_z(0, data, size));
+}
+
+#else
+
+bool inflateAvailable() {
+    return false;
+}
+
+const char* inflateBackendName() {
+    return "libzip";
+}
+
+bool inflateRaw(const uint8_t*, size_t, uint8_t*, size_t) {
+    return false;
+}
+
+uint32_t inflateCrc32(const uint8_t*, size_t) {
+    return 0;
+}
+
+#endif
+
+} // namespace baja_xlsx
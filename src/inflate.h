@@ -0,0 +1,28 @@
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace baja_xlsx {
+
+// One-shot raw DEFLATE decoding for whole ZIP entries. The engine is picked at
+// build time with the binding.gyp variable inflate_backend:
+//   libzip      (default) no one-shot engine; entries stream through libzip's zlib
+//   libdeflate  BAJA_INFLATE_LIBDEFLATE
+//   zlib-ng     BAJA_INFLATE_ZLIB_NG, native zng_* API
+bool inflateAvailable();
+
+// "libdeflate", "zlib-ng" or "libzip"
+const char* inflateBackendName();
+
+// Decode raw DEFLATE data that must produce exactly outSize bytes.
+// False on corrupt input or a size mismatch, and always without a backend.
+bool inflateRaw(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize);
+
+// CRC-32 as stored in ZIP headers, from the same library
+uint32_t inflateCrc32(const uint8_t* data, size_t size);
+
+} // namespace baja_xlsx
+
+#endif // INFLATE_H
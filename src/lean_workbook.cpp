@@ -0,0 +1,794 @@
+#include "lean_workbook.h"
+#include "cell_format.h"
+#include "ooxml_parts.h"
+#include "zip_archive.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace baja_xlsx {
+
+// Rows parsed between two progress updates / cancellation checks
+static const uint64_t kRowReportInterval = 256;
+
+// Sheet XML below this size is parsed on the calling thread; above it, in
+// pieces of at least kMinChunkBytes on up to kMaxParseThreads threads
+static const size_t kParallelParseMinBytes = 4 * 1024 * 1024;
+static const size_t kMinChunkBytes = 1024 * 1024;
+static const size_t kMaxParseThreads = 8;
+
+// workbook.xml and relationship parts are metadata; anything bigger is not a sane package
+static const uint64_t kMetadataPartLimit = 16 * 1024 * 1024;
+
+static std::string readPartAsString(ZipArchive& archive, const std::string& partName) {
+    std::vector<uint8_t> data;
+    if (!archive.readEntry(partName, data, kMetadataPartLimit)) {
+        return "";
+    }
+    return std::string(data.begin(), data.end());
+}
+
+// Local name of the element starting at xml[pos] == '<' ("x:row" -> "row").
+// Empty for end tags, comments and processing instructions.
+static std::string_view elementName(std::string_view xml, size_t pos) {
+    size_t start = pos + 1;
+    if (start >= xml.size() || xml[start] == '/' || xml[start] == '!' || xml[start] == '?') {
+        return std::string_view();
+    }
+    size_t end = start;
+    while (end < xml.size() && xml[end] != '>' && xml[end] != '/' &&
+           xml[end] != ' ' && xml[end] != '\t' && xml[end] != '\r' && xml[end] != '\n') {
+        end++;
+    }
+    std::string_view name = xml.substr(start, end - start);
+    size_t colon = name.find(':');
+    return colon == std::string_view::npos ? name : name.substr(colon + 1);
+}
+
+// Position of the end tag </localName> (any prefix) at or after from, or npos
+static size_t findEndTag(std::string_view xml, std::string_view localName, size_t from) {
+    size_t pos = from;
+    while ((pos = xml.find("</", pos)) != std::string_view::npos) {
+        size_t start = pos + 2;
+        size_t end = xml.find('>', start);
+        if (end == std::string_view::npos) return std::string_view::npos;
+        std::string_view name = xml.substr(start, end - start);
+        size_t colon = name.find(':');
+        if (colon != std::string_view::npos) name = name.substr(colon + 1);
+        if (name == localName) return pos;
+        pos = end + 1;
+    }
+    return std::string_view::npos;
+}
+
+// Raw attribute value from a start tag, without entity decoding. Only used for
+// attributes that never carry entities (r, t, s, numFmtId).
+static std::string_view rawAttribute(std::string_view tag, std::string_view name) {
+    size_t pos = 0;
+    while ((pos = tag.find(name, pos)) != std::string_view::npos) {
+        char before = pos > 0 ? tag[pos - 1] : '<';
+        size_t eq = pos + name.size();
+        if ((before == ' ' || before == '\t' || before == '\r' || before == '\n') &&
+            eq + 1 < tag.size() && tag[eq] == '=' && (tag[eq + 1] == '"' || tag[eq + 1] == '\'')) {
+            char quote = tag[eq + 1];
+            size_t valueStart = eq + 2;
+            size_t valueEnd = tag.find(quote, valueStart);
+            if (valueEnd == std::string_view::npos) return std::string_view();
+            return tag.substr(valueStart, valueEnd - valueStart);
+        }
+        pos = eq;
+    }
+    return std::string_view();
+}
+
+static bool isSelfClosing(std::string_view xml, size_t tagEnd) {
+    return tagEnd > 0 && xml[tagEnd - 1] == '/';
+}
+
+// Concatenated text of the <t> runs in a shared/inline string, skipping phonetic (<rPh>) runs
+static void appendRichText(std::string_view xml, std::string& out) {
+    size_t pos = 0;
+    while ((pos = xml.find('<', pos)) != std::string_view::npos) {
+        size_t tagEnd = xml.find('>', pos);
+        if (tagEnd == std::string_view::npos) return;
+        std::string_view name = elementName(xml, pos);
+
+        if (name == "rPh" && !isSelfClosing(xml, tagEnd)) {
+            size_t end = findEndTag(xml, "rPh", tagEnd + 1);
+            if (end == std::string_view::npos) return;
+            pos = end + 2;
+            continue;
+        }
+        if (name == "t" && !isSelfClosing(xml, tagEnd)) {
+            size_t textEnd = xml.find('<', tagEnd + 1);
+            if (textEnd == std::string_view::npos) return;
+            std::string_view text = xml.substr(tagEnd + 1, textEnd - tagEnd - 1);
+            if (text.find('&') == std::string_view::npos) {
+                out.append(text.data(), text.size());
+            } else {
+                out += decodeXmlEntities(text);
+            }
+            pos = textEnd;
+            continue;
+        }
+        pos = tagEnd + 1;
+    }
+}
+
+// Text of the <v> element of a cell, which is followed by '<' in the buffer
+static bool cellValue(std::string_view content, std::string_view& outValue) {
+    size_t tagEnd = 0;
+    size_t pos = findStartTag(content, "v", 0, tagEnd);
+    if (pos == std::string_view::npos || isSelfClosing(content, tagEnd)) return false;
+    size_t valueEnd = content.find('<', tagEnd + 1);
+    if (valueEnd == std::string_view::npos) return false;
+    outValue = content.substr(tagEnd + 1, valueEnd - tagEnd - 1);
+    return true;
+}
+
+LeanWorkbookReader::LeanWorkbookReader()
+    : isoDates_(false), date1904_(false), parseThreads_(0), schemaRows_(0), schemaStartRow_(0),
+      control_(nullptr) {
+}
+
+bool LeanWorkbookReader::read(const std::string& xlsxPath, const ReadOptions& options, Arena& arena,
+                              std::vector<SheetData>& outSheets) {
+    outSheets.clear();
+    if (!open(xlsxPath, options, arena)) {
+        return false;
+    }
+
+    if (control_) {
+        control_->setSheetCount(static_cast<int>(sheets_.size()));
+        control_->setPhase(ReadProgress::Sheets);
+    }
+
+    uint64_t totalCells = 0;
+    for (const auto& entry : sheets_) {
+        SheetData sheet;
+        sheet.name = entry.name;
+        sheet.data = ArenaVector<SheetRow>(ArenaAllocator<SheetRow>(&arena));
+
+        if (!entry.part.empty() && !readSheet(archive_, entry.part, arena, sheet, totalCells)) {
+            outSheets.clear();
+            return false;
+        }
+
+        outSheets.push_back(std::move(sheet));
+        if (control_) control_->sheetDone();
+    }
+
+    lastError_ = "";
+    return true;
+}
+
+bool LeanWorkbookReader::open(const std::string& xlsxPath, const ReadOptions& options, Arena& arena) {
+    limits_ = options.limits;
+    control_ = options.control.get();
+    isoDates_ = options.isoDates;
+    parseThreads_ = options.parseThreads;
+    schemaRows_ = options.schemaRows;
+    schemaStartRow_ = options.schemaStartRow;
+    decoders_.clear();
+    sheets_.clear();
+    sharedStrings_.clear();
+    dateStyles_.clear();
+
+    archive_.close();
+    if (!archive_.open(xlsxPath)) {
+        lastError_ = archive_.getLastError();
+        return false;
+    }
+
+    // Locate the workbook part through the package relationships
+    std::string workbookPart = "xl/workbook.xml";
+    for (const auto& rel : parseRelationshipList(readPartAsString(archive_, "_rels/.rels"))) {
+        if (relationshipTypeIs(rel.type, "officeDocument")) {
+            workbookPart = resolvePartTarget("", rel.target);
+            break;
+        }
+    }
+
+    std::string workbookXml = readPartAsString(archive_, workbookPart);
+    if (workbookXml.empty()) {
+        lastError_ = "Failed to load file: workbook part not found: " + workbookPart;
+        return false;
+    }
+
+    std::map<std::string, std::string> sheetTargets;
+    std::string sharedStringsPart;
+    std::string stylesPart;
+    for (const auto& rel : parseRelationshipList(readPartAsString(archive_, relationshipsPartFor(workbookPart)))) {
+        std::string target = resolvePartTarget(workbookPart, rel.target);
+        if (relationshipTypeIs(rel.type, "sharedStrings")) {
+            sharedStringsPart = target;
+        } else if (relationshipTypeIs(rel.type, "styles")) {
+            stylesPart = target;
+        }
+        sheetTargets[rel.id] = target;
+    }
+
+    // Serial dates only need the calendar when they are converted
+    date1904_ = false;
+    if (isoDates_) {
+        size_t tagEnd = 0;
+        size_t pos = findStartTag(workbookXml, "workbookPr", 0, tagEnd);
+        if (pos != std::string::npos) {
+            std::string value = getXmlAttribute(std::string_view(workbookXml).substr(pos, tagEnd - pos + 1), "date1904");
+            date1904_ = value == "1" || value == "true";
+        }
+        if (!stylesPart.empty() && !loadStyles(archive_, stylesPart)) {
+            return false;
+        }
+    }
+
+    if (!sharedStringsPart.empty() && !loadSharedStrings(archive_, sharedStringsPart, arena)) {
+        return false;
+    }
+
+    for (const auto& entry : parseWorkbookSheets(workbookXml)) {
+        SheetPart sheet;
+        sheet.name = entry.name;
+        auto targetIt = sheetTargets.find(entry.relId);
+        if (targetIt != sheetTargets.end()) {
+            sheet.part = targetIt->second;
+        }
+        sheets_.push_back(std::move(sheet));
+    }
+
+    lastError_ = "";
+    return true;
+}
+
+bool LeanWorkbookReader::loadSharedStrings(ZipArchive& archive, const std::string& partName, Arena& arena) {
+    std::vector<uint8_t> data;
+    if (!archive.readEntry(partName, data, limits_.maxEntrySize)) {
+        lastError_ = archive.getLastError();
+        return false;
+    }
+    std::string_view xml(reinterpret_cast<const char*>(data.data()), data.size());
+
+    size_t tagEnd = 0;
+    size_t sst = findStartTag(xml, "sst", 0, tagEnd);
+    if (sst != std::string_view::npos) {
+        std::string_view count = rawAttribute(xml.substr(sst, tagEnd - sst + 1), "uniqueCount");
+        if (!count.empty()) {
+            sharedStrings_.reserve(std::min<size_t>(std::strtoul(std::string(count).c_str(), nullptr, 10), 1 << 24));
+        }
+    }
+
+    // Each string is copied into the arena once; every cell referencing it shares the view
+    std::string text;
+    size_t pos = 0;
+    while ((pos = findStartTag(xml, "si", pos, tagEnd)) != std::string_view::npos) {
+        text.clear();
+        if (isSelfClosing(xml, tagEnd)) {
+            sharedStrings_.push_back(CellText());
+            pos = tagEnd + 1;
+            continue;
+        }
+        size_t end = findEndTag(xml, "si", tagEnd + 1);
+        if (end == std::string_view::npos) break;
+        appendRichText(xml.substr(tagEnd + 1, end - tagEnd - 1), text);
+        sharedStrings_.push_back(arena.copyString(text));
+        pos = end + 2;
+    }
+    return true;
+}
+
+bool LeanWorkbookReader::loadStyles(ZipArchive& archive, const std::string& partName) {
+    std::vector<uint8_t> data;
+    if (!archive.readEntry(partName, data, limits_.maxEntrySize)) {
+        lastError_ = archive.getLastError();
+        return false;
+    }
+    std::string_view xml(reinterpret_cast<const char*>(data.data()), data.size());
+
+    // Custom number formats: numFmtId -> is a date
+    std::map<int, bool> customDateFormats;
+    size_t tagEnd = 0;
+    size_t pos = findStartTag(xml, "numFmts", 0, tagEnd);
+    if (pos != std::string_view::npos && !isSelfClosing(xml, tagEnd)) {
+        size_t end = findEndTag(xml, "numFmts", tagEnd + 1);
+        std::string_view numFmts = xml.substr(tagEnd + 1, end == std::string_view::npos ? std::string_view::npos : end - tagEnd - 1);
+        size_t fmtPos = 0;
+        while ((fmtPos = findStartTag(numFmts, "numFmt", fmtPos, tagEnd)) != std::string_view::npos) {
+            std::string_view tag = numFmts.substr(fmtPos, tagEnd - fmtPos + 1);
+            int id = std::atoi(std::string(rawAttribute(tag, "numFmtId")).c_str());
+            customDateFormats[id] = isDateFormatCode(getXmlAttribute(tag, "formatCode"));
+            fmtPos = tagEnd + 1;
+        }
+    }
+
+    // Cell formats, in order: the cell's s attribute indexes this list
+    pos = findStartTag(xml, "cellXfs", 0, tagEnd);
+    if (pos == std::string_view::npos || isSelfClosing(xml, tagEnd)) {
+        return true;
+    }
+    size_t end = findEndTag(xml, "cellXfs", tagEnd + 1);
+    std::string_view cellXfs = xml.substr(tagEnd + 1, end == std::string_view::npos ? std::string_view::npos : end - tagEnd - 1);
+    size_t xfPos = 0;
+    while ((xfPos = findStartTag(cellXfs, "xf", xfPos, tagEnd)) != std::string_view::npos) {
+        int id = std::atoi(std::string(rawAttribute(cellXfs.substr(xfPos, tagEnd - xfPos + 1), "numFmtId")).c_str());
+        auto custom = customDateFormats.find(id);
+        bool isDate = custom != customDateFormats.end() ? custom->second : isBuiltinDateFormat(id);
+        dateStyles_.push_back(isDate ? 1 : 0);
+
+        if (isSelfClosing(cellXfs, tagEnd)) {
+            xfPos = tagEnd + 1;
+        } else {
+            size_t xfEnd = findEndTag(cellXfs, "xf", tagEnd + 1);
+            if (xfEnd == std::string_view::npos) break;
+            xfPos = xfEnd + 2;
+        }
+    }
+    return true;
+}
+
+CellText LeanWorkbookReader::cellText(std::string_view type, std::string_view style, std::string_view content,
+                                      Arena& arena) {
+    if (type == "inlineStr") {
+        size_t tagEnd = 0;
+        size_t pos = findStartTag(content, "is", 0, tagEnd);
+        if (pos == std::string_view::npos || isSelfClosing(content, tagEnd)) return CellText();
+        size_t end = findEndTag(content, "is", tagEnd + 1);
+        if (end == std::string_view::npos) return CellText();
+        std::string text;
+        appendRichText(content.substr(tagEnd + 1, end - tagEnd - 1), text);
+        return arena.copyString(text);
+    }
+
+    // Everything else keeps its value in <v>
+    std::string_view value;
+    if (!cellValue(content, value)) return CellText();
+
+    if (type == "s") {
+        size_t index = std::strtoul(std::string(value).c_str(), nullptr, 10);
+        return index < sharedStrings_.size() ? sharedStrings_[index] : CellText();
+    }
+    if (type == "b") {
+        return value == "1" || value == "true" ? CellText("true") : CellText("false");
+    }
+    if (type == "str") {
+        std::string formula = value.find('&') == std::string_view::npos
+            ? std::string(value) : decodeXmlEntities(value);
+
+        // Embedded image formula (DISPIMG), same markers as XlsxReader::cellToString
+        if (formula.find("DISPIMG") != std::string::npos) {
+            size_t idStart = formula.find("\"");
+            if (idStart != std::string::npos) {
+                size_t idEnd = formula.find("\"", idStart + 1);
+                if (idEnd != std::string::npos) {
+                    return arena.copyString("__IMAGE_CELL__:" + formula.substr(idStart + 1, idEnd - idStart - 1));
+                }
+            }
+            return CellText("__IMAGE_CELL__");
+        }
+        return arena.copyString(formula);
+    }
+    if (!type.empty() && type != "n") {
+        // Errors (#N/A ...) and ISO dates (t="d") are already text
+        return arena.copyString(value.find('&') == std::string_view::npos
+            ? std::string(value) : decodeXmlEntities(value));
+    }
+
+    // Whole numbers outside date styles already are their own text
+    if (isCanonicalInteger(value) && (!isoDates_ || style.empty())) {
+        return arena.copyString(value);
+    }
+
+    // Number, read without regard to the process locale
+    double number = 0;
+    if (parseDecimal(value, number) == 0) return CellText();
+
+    if (isoDates_ && !style.empty()) {
+        size_t styleIndex = std::strtoul(std::string(style).c_str(), nullptr, 10);
+        if (styleIndex < dateStyles_.size() && dateStyles_[styleIndex]) {
+            return arena.copyString(serialToIsoDate(number, date1904_));
+        }
+    }
+    char buffer[kMaxNumberChars];
+    return arena.copyString(std::string_view(buffer, formatNumber(number, buffer)));
+}
+
+ColumnType LeanWorkbookReader::classifyCell(std::string_view type, std::string_view style,
+                                            ColumnDecoder::Kind& outKind) const {
+    outKind = ColumnDecoder::Generic;
+    if (type == "s") {
+        outKind = ColumnDecoder::SharedString;
+        return ColumnType::String;
+    }
+    if (type == "b") {
+        outKind = ColumnDecoder::Boolean;
+        return ColumnType::Boolean;
+    }
+    if (type == "str") return ColumnType::Formula;
+    if (type == "d") return ColumnType::Date;
+    if (!type.empty() && type != "n") return ColumnType::String;   // inlineStr, errors
+
+    if (isoDates_ && !style.empty()) {
+        size_t styleIndex = std::strtoul(std::string(style).c_str(), nullptr, 10);
+        if (styleIndex < dateStyles_.size() && dateStyles_[styleIndex]) {
+            outKind = ColumnDecoder::Date;
+            return ColumnType::Date;
+        }
+    }
+    outKind = ColumnDecoder::Number;
+    return ColumnType::Number;
+}
+
+void LeanWorkbookReader::inferColumns(std::string_view body, std::vector<ColumnSchema>& outColumns) {
+    outColumns.clear();
+    decoders_.clear();
+    std::vector<char> consistent;
+
+    // Same row / column numbering as parseRows, stopping after the sampled rows
+    const size_t lastRow = schemaStartRow_ + schemaRows_;   // 1-based, inclusive
+    uint32_t currentRow = 0;
+    uint32_t currentCol = 0;
+    size_t pos = 0;
+    while ((pos = body.find('<', pos)) != std::string_view::npos) {
+        size_t end = body.find('>', pos);
+        if (end == std::string_view::npos) break;
+        std::string_view name = elementName(body, pos);
+        std::string_view tag = body.substr(pos, end - pos + 1);
+
+        if (name == "row") {
+            std::string_view r = rawAttribute(tag, "r");
+            currentRow = r.empty() ? currentRow + 1 : static_cast<uint32_t>(std::strtoul(std::string(r).c_str(), nullptr, 10));
+            currentCol = 0;
+            if (currentRow > lastRow) break;
+            pos = end + 1;
+            continue;
+        }
+
+        if (name == "c") {
+            int col = 0;
+            int row = 0;
+            if (parseCellReference(rawAttribute(tag, "r"), col, row)) {
+                currentCol = static_cast<uint32_t>(col);
+                currentRow = static_cast<uint32_t>(row);
+            } else {
+                currentCol++;
+            }
+            if (isSelfClosing(body, end)) {
+                pos = end + 1;
+                continue;
+            }
+            size_t cellEnd = findEndTag(body, "c", end + 1);
+            if (cellEnd == std::string_view::npos) break;
+            std::string_view content = body.substr(end + 1, cellEnd - end - 1);
+            pos = cellEnd + 3;
+
+            if (currentRow <= schemaStartRow_ || currentRow > lastRow || currentCol == 0 || content.empty()) {
+                continue;
+            }
+            std::string_view type = rawAttribute(tag, "t");
+            std::string_view style = rawAttribute(tag, "s");
+            std::string_view value;
+            if (type != "inlineStr" && !cellValue(content, value)) {
+                continue;
+            }
+
+            if (currentCol > outColumns.size()) {
+                outColumns.resize(currentCol);
+                decoders_.resize(currentCol);
+                consistent.resize(currentCol, 1);
+            }
+            size_t index = currentCol - 1;
+            ColumnDecoder::Kind kind;
+            ColumnType cellType = classifyCell(type, style, kind);
+            ColumnDecoder& decoder = decoders_[index];
+            if (outColumns[index].samples == 0) {
+                decoder.kind = kind;
+                decoder.style = std::string(style);
+            } else if (decoder.kind != kind || (isoDates_ && decoder.style != style)) {
+                consistent[index] = 0;
+            }
+            outColumns[index].observe(cellType);
+            continue;
+        }
+
+        pos = end + 1;
+    }
+
+    // Columns whose sample disagrees on kind or style keep the generic path
+    for (size_t i = 0; i < decoders_.size(); ++i) {
+        if (!consistent[i]) decoders_[i].kind = ColumnDecoder::Generic;
+    }
+}
+
+bool LeanWorkbookReader::decodeCell(const ColumnDecoder& decoder, std::string_view type, std::string_view style,
+                                    std::string_view content, Arena& arena, CellText& outText) {
+    switch (decoder.kind) {
+        case ColumnDecoder::SharedString: {
+            std::string_view value;
+            size_t index = 0;
+            if (type != "s" || !cellValue(content, value)) return false;
+            auto result = std::from_chars(value.data(), value.data() + value.size(), index);
+            if (result.ec != std::errc()) return false;
+            outText = index < sharedStrings_.size() ? sharedStrings_[index] : CellText();
+            return true;
+        }
+        case ColumnDecoder::Boolean: {
+            std::string_view value;
+            if (type != "b" || !cellValue(content, value)) return false;
+            outText = value == "1" || value == "true" ? CellText("true") : CellText("false");
+            return true;
+        }
+        case ColumnDecoder::Number:
+        case ColumnDecoder::Date: {
+            // Style only matters, and is only compared, when dates are converted
+            std::string_view value;
+            if ((!type.empty() && type != "n") || (isoDates_ && style != decoder.style) ||
+                !cellValue(content, value)) {
+                return false;
+            }
+            if (decoder.kind == ColumnDecoder::Number && isCanonicalInteger(value)) {
+                outText = arena.copyString(value);
+                return true;
+            }
+            double number = 0;
+            if (parseDecimal(value, number) == 0) {
+                outText = CellText();
+            } else if (decoder.kind == ColumnDecoder::Date) {
+                outText = arena.copyString(serialToIsoDate(number, date1904_));
+            } else {
+                char buffer[kMaxNumberChars];
+                outText = arena.copyString(std::string_view(buffer, formatNumber(number, buffer)));
+            }
+            return true;
+        }
+        case ColumnDecoder::Generic:
+        default:
+            return false;
+    }
+}
+
+std::string_view LeanWorkbookReader::sheetDataBody(std::string_view xml) {
+    size_t tagEnd = 0;
+    size_t sheetDataPos = findStartTag(xml, "sheetData", 0, tagEnd);
+    if (sheetDataPos == std::string_view::npos || isSelfClosing(xml, tagEnd)) {
+        return std::string_view();
+    }
+    size_t sheetDataEnd = findEndTag(xml, "sheetData", tagEnd + 1);
+    return xml.substr(tagEnd + 1,
+        sheetDataEnd == std::string_view::npos ? std::string_view::npos : sheetDataEnd - tagEnd - 1);
+}
+
+// First <row> start tag at or after from; the end of xml if there is none
+static size_t nextRowBoundary(std::string_view xml, size_t from) {
+    size_t pos = from;
+    while ((pos = xml.find('<', pos)) != std::string_view::npos) {
+        if (elementName(xml, pos) == "row") return pos;
+        pos++;
+    }
+    return xml.size();
+}
+
+bool LeanWorkbookReader::parseRows(std::string_view xml, Arena& arena, RowChunk& chunk) {
+    // Row numbers stay relative to the chunk start until an explicit r attribute is seen
+    uint32_t currentRow = 0;
+    uint32_t currentCol = 0;
+
+    size_t pos = 0;
+    while ((pos = xml.find('<', pos)) != std::string_view::npos) {
+        size_t end = xml.find('>', pos);
+        if (end == std::string_view::npos) break;
+        std::string_view name = elementName(xml, pos);
+        std::string_view tag = xml.substr(pos, end - pos + 1);
+
+        if (name == "row") {
+            std::string_view r = rawAttribute(tag, "r");
+            if (r.empty()) {
+                currentRow++;
+            } else {
+                currentRow = static_cast<uint32_t>(std::strtoul(std::string(r).c_str(), nullptr, 10));
+                chunk.absolute = true;
+            }
+            currentCol = 0;
+
+            chunk.rows++;
+            if (control_ && chunk.rows % kRowReportInterval == 0) {
+                if (control_->cancelled()) {
+                    return false;
+                }
+                control_->addRows(kRowReportInterval);
+            }
+            pos = end + 1;
+            continue;
+        }
+
+        if (name == "c") {
+            int col = 0;
+            int row = 0;
+            if (parseCellReference(rawAttribute(tag, "r"), col, row)) {
+                currentCol = static_cast<uint32_t>(col);
+                currentRow = static_cast<uint32_t>(row);
+                chunk.absolute = true;
+            } else {
+                currentCol++;
+            }
+
+            std::string_view content;
+            size_t next = end + 1;
+            if (!isSelfClosing(xml, end)) {
+                size_t cellEnd = findEndTag(xml, "c", end + 1);
+                if (cellEnd == std::string_view::npos) break;
+                content = xml.substr(end + 1, cellEnd - end - 1);
+                next = cellEnd + 3;
+            }
+
+            ParsedCell cell;
+            cell.row = currentRow;
+            cell.col = currentCol;
+            if (!content.empty()) {
+                std::string_view type = rawAttribute(tag, "t");
+                std::string_view style = rawAttribute(tag, "s");
+                if (currentCol >= 1 && currentCol <= decoders_.size() &&
+                    decoders_[currentCol - 1].kind != ColumnDecoder::Generic) {
+                    if (!decodeCell(decoders_[currentCol - 1], type, style, content, arena, cell.text)) {
+                        cell.text = cellText(type, style, content, arena);
+                        // Counted once rows are stitched and the row number is final
+                        chunk.fallbackCells.push_back(chunk.cells.size());
+                    }
+                } else {
+                    cell.text = cellText(type, style, content, arena);
+                }
+            }
+            chunk.cells.push_back(cell);
+
+            if (!chunk.absolute) chunk.relativeCells++;
+            chunk.maxCol = std::max(chunk.maxCol, currentCol);
+            pos = next;
+            continue;
+        }
+
+        pos = end + 1;
+    }
+
+    chunk.endRow = currentRow;
+    if (control_) control_->addRows(chunk.rows % kRowReportInterval);
+    return true;
+}
+
+bool LeanWorkbookReader::readSheet(ZipArchive& archive, const std::string& partName, Arena& arena,
+                                   SheetData& sheet, uint64_t& totalCells) {
+    std::vector<uint8_t> data;
+    if (!archive.readEntry(partName, data, limits_.maxEntrySize)) {
+        lastError_ = archive.getLastError();
+        return false;
+    }
+    if (control_) control_->addBytesInflated(data.size());
+    std::string_view body = sheetDataBody(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+    if (body.empty()) {
+        return true;
+    }
+
+    // Column decoders are fixed before the pieces are parsed concurrently
+    std::vector<ColumnSchema> columns;
+    if (schemaRows_ > 0) {
+        inferColumns(body, columns);
+    } else {
+        decoders_.clear();
+    }
+
+    // Large sheets are cut at <row> boundaries and the pieces parsed concurrently
+    size_t threadCount = 1;
+    if (body.size() >= kParallelParseMinBytes) {
+        threadCount = parseThreads_ > 0 ? parseThreads_ : std::thread::hardware_concurrency();
+        threadCount = std::min(threadCount, kMaxParseThreads);
+        threadCount = std::min(threadCount, body.size() / kMinChunkBytes);
+    }
+
+    std::vector<std::string_view> pieces;
+    size_t start = 0;
+    for (size_t i = 1; i < threadCount; ++i) {
+        size_t boundary = nextRowBoundary(body, std::max(start, body.size() / threadCount * i));
+        if (boundary > start && boundary < body.size()) {
+            pieces.push_back(body.substr(start, boundary - start));
+            start = boundary;
+        }
+    }
+    pieces.push_back(body.substr(start));
+
+    std::vector<RowChunk> chunks(pieces.size());
+    bool ok = true;
+    if (pieces.size() == 1) {
+        ok = parseRows(pieces[0], arena, chunks[0]);
+    } else {
+        // The arena is single-threaded: each piece fills its own, adopted once parsing is done
+        std::vector<std::unique_ptr<Arena>> arenas(pieces.size());
+        std::vector<char> parsed(pieces.size(), 0);
+        std::vector<std::thread> workers;
+        workers.reserve(pieces.size());
+
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            arenas[i] = std::make_unique<Arena>();
+            workers.emplace_back([&, i]() {
+                try {
+                    parsed[i] = parseRows(pieces[i], *arenas[i], chunks[i]);
+                } catch (...) {
+                    parsed[i] = 0;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            arena.adopt(*arenas[i]);
+            ok = ok && parsed[i];
+        }
+    }
+    if (!ok) {
+        lastError_ = (control_ && control_->cancelled())
+            ? std::string(kReadAbortedError)
+            : "Failed to read sheet data: " + sheet.name;
+        return false;
+    }
+
+    // Stitch: rows counted before a chunk's first explicit row number continue from the previous chunk
+    uint32_t previousRow = 0;
+    uint32_t maxRow = 0;
+    uint32_t maxCol = 0;
+    bool hasA1 = false;
+    for (auto& chunk : chunks) {
+        for (size_t i = 0; i < chunk.relativeCells; ++i) {
+            chunk.cells[i].row += previousRow;
+        }
+        previousRow = chunk.absolute ? chunk.endRow : previousRow + chunk.endRow;
+
+        for (const auto& cell : chunk.cells) {
+            maxRow = std::max(maxRow, cell.row);
+            if (cell.row == 1 && cell.col == 1) hasA1 = true;
+        }
+        maxCol = std::max(maxCol, chunk.maxCol);
+    }
+
+    decoders_.clear();
+
+    // Same rule as the xlnt path: a sheet without an A1 cell is returned empty
+    if (!hasA1) {
+        return true;
+    }
+
+    // A single far-away cell makes the dense grid huge; refuse before allocating it
+    if (!checkCellCount(sheet.name, maxRow, maxCol, totalCells, limits_, lastError_)) {
+        return false;
+    }
+
+    // Dense grid, empty cells stay default-constructed views
+    sheet.data.reserve(maxRow);
+    for (uint32_t row = 0; row < maxRow; ++row) {
+        sheet.data.emplace_back(maxCol, CellText(), ArenaAllocator<CellText>(&arena));
+    }
+    for (const auto& chunk : chunks) {
+        for (const auto& cell : chunk.cells) {
+            if (cell.row >= 1 && cell.col >= 1) {
+                sheet.data[cell.row - 1][cell.col - 1] = cell.text;
+            }
+        }
+    }
+
+    // One entry per grid column; rows above the sample (the header) are not counted
+    if (schemaRows_ > 0) {
+        columns.resize(sheet.width());
+        for (const auto& chunk : chunks) {
+            for (size_t i : chunk.fallbackCells) {
+                const ParsedCell& cell = chunk.cells[i];
+                if (cell.row > schemaStartRow_) {
+                    columns[cell.col - 1].fallbacks++;
+                }
+            }
+        }
+        sheet.columns = std::move(columns);
+    }
+    return true;
+}
+
+} // namespace baja_xlsx
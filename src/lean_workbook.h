@@ -0,0 +1,112 @@
+#ifndef LEAN_WORKBOOK_H
+#define LEAN_WORKBOOK_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "xlsx_reader.h"
+#include "zip_archive.h"
+
+namespace baja_xlsx {
+
+// Values-only workbook loader. Instead of building xlnt's full object model
+// (styles, themes, defined names, comments, properties) it reads only:
+//   - workbook.xml and its relationships, for sheet order and names
+//   - sharedStrings.xml, copied once into the arena and shared by every cell using it
+//   - each worksheet's <sheetData>, split at <row> boundaries and parsed in parallel when large
+//   - styles.xml <numFmts>/<cellXfs>, and only when ISO dates are requested
+// Cell text matches XlsxReader::readSheetData so either path can back readExcel.
+// With ReadOptions::schemaRows set, the first rows of each sheet are sampled to
+// pick one decoder per column (see ColumnSchema), so cells skip the per-cell type dispatch.
+class LeanWorkbookReader {
+public:
+    LeanWorkbookReader();
+
+    bool read(const std::string& xlsxPath, const ReadOptions& options, Arena& arena,
+              std::vector<SheetData>& outSheets);
+
+    // Open the package and load workbook.xml, shared strings (into arena) and, for
+    // ISO dates, styles. The package stays open for archive() until the next open.
+    bool open(const std::string& xlsxPath, const ReadOptions& options, Arena& arena);
+
+    struct SheetPart {
+        std::string name;
+        std::string part;     // worksheet part name, empty when the relationship is missing
+    };
+
+    // Sheets in workbook order, after open()
+    const std::vector<SheetPart>& sheets() const { return sheets_; }
+
+    ZipArchive& archive() { return archive_; }
+
+    // Contents of <sheetData> in a worksheet part, empty if there is none
+    static std::string_view sheetDataBody(std::string_view xml);
+
+    std::string getLastError() const { return lastError_; }
+
+    struct ParsedCell {
+        uint32_t row;    // 1-based
+        uint32_t col;    // 1-based
+        CellText text;
+    };
+
+    // Cells parsed from one row-aligned piece of <sheetData>
+    struct RowChunk {
+        std::vector<ParsedCell> cells;
+        size_t relativeCells = 0;   // leading cells whose row counts from the piece start
+        bool absolute = false;      // an explicit row number (row or cell r) was seen
+        uint32_t endRow = 0;        // current row at the end (relative unless absolute)
+        uint32_t maxCol = 0;
+        uint64_t rows = 0;
+        std::vector<size_t> fallbackCells;   // indices into cells the column decoder could not take
+    };
+
+    // Parse the <row> elements of one piece; safe to run on several pieces at once
+    // as long as each has its own arena. Returns false when cancelled.
+    bool parseRows(std::string_view xml, Arena& arena, RowChunk& chunk);
+
+private:
+    bool loadSharedStrings(ZipArchive& archive, const std::string& partName, Arena& arena);
+    bool loadStyles(ZipArchive& archive, const std::string& partName);
+    bool readSheet(ZipArchive& archive, const std::string& partName, Arena& arena,
+                   SheetData& sheet, uint64_t& totalCells);
+
+    // Text for one <c> element, given its attributes and the XML between <c> and </c>
+    CellText cellText(std::string_view type, std::string_view style, std::string_view content, Arena& arena);
+
+    // Decoder picked for one column from the schema sample
+    struct ColumnDecoder {
+        enum Kind { Generic, SharedString, Number, Date, Boolean };
+        Kind kind = Generic;
+        std::string style;    // s attribute every sampled cell had; checked only with ISO dates
+    };
+
+    // Column type and decoder of a cell, from its t and s attributes
+    ColumnType classifyCell(std::string_view type, std::string_view style, ColumnDecoder::Kind& outKind) const;
+
+    // Sample the rows [schemaStartRow_, schemaStartRow_ + schemaRows_) of body, filling
+    // outColumns and decoders_
+    void inferColumns(std::string_view body, std::vector<ColumnSchema>& outColumns);
+
+    // Column-specialized cellText; false when the cell does not fit the decoder
+    bool decodeCell(const ColumnDecoder& decoder, std::string_view type, std::string_view style,
+                    std::string_view content, Arena& arena, CellText& outText);
+
+    ZipArchive archive_;
+    std::vector<SheetPart> sheets_;
+    std::vector<CellText> sharedStrings_;
+    std::vector<char> dateStyles_;     // per cellXfs index: number format is a date
+    bool isoDates_;
+    bool date1904_;
+    size_t parseThreads_;              // 0 = one per core
+    size_t schemaRows_;
+    size_t schemaStartRow_;
+    std::vector<ColumnDecoder> decoders_;  // per column of the sheet being read; empty = generic
+    ReadLimits limits_;
+    ReadControl* control_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // LEAN_WORKBOOK_H
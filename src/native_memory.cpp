@@ -0,0 +1,37 @@
+#include "native_memory.h"
+#include <atomic>
+
+namespace baja_xlsx {
+
+static std::atomic<int64_t> currentBytes{0};
+static std::atomic<int64_t> peakBytes{0};
+static std::atomic<int64_t> externalBytes{0};
+
+void NativeMemory::add(int64_t bytes) {
+    if (bytes == 0) return;
+
+    int64_t now = currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (bytes > 0) {
+        int64_t seen = peakBytes.load(std::memory_order_relaxed);
+        while (now > seen && !peakBytes.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void NativeMemory::addExternal(int64_t bytes) {
+    externalBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+int64_t NativeMemory::current() {
+    return currentBytes.load(std::memory_order_relaxed);
+}
+
+int64_t NativeMemory::peak() {
+    return peakBytes.load(std::memory_order_relaxed);
+}
+
+int64_t NativeMemory::external() {
+    return externalBytes.load(std::memory_order_relaxed);
+}
+
+} // namespace baja_xlsx
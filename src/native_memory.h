@@ -0,0 +1,58 @@
+#ifndef NATIVE_MEMORY_H
+#define NATIVE_MEMORY_H
+
+#include <cstdint>
+
+namespace baja_xlsx {
+
+// Process-wide gauge of native memory held by the addon: read arenas, image
+// bytes waiting to be handed to JS, export buffers and writer state. Updated
+// from any thread; read by nativeMemoryUsage() in JS.
+class NativeMemory {
+public:
+    // Record an allocation (positive) or a release (negative)
+    static void add(int64_t bytes);
+
+    // Record a change in what has been reported to V8 as external memory
+    static void addExternal(int64_t bytes);
+
+    static int64_t current();
+    static int64_t peak();
+    static int64_t external();
+};
+
+// Charge held for as long as the object lives; released on destruction.
+// Movable so it can sit inside result structs that are moved around.
+class NativeMemoryCharge {
+public:
+    NativeMemoryCharge() : bytes_(0) {}
+    explicit NativeMemoryCharge(int64_t bytes) : bytes_(0) { add(bytes); }
+    ~NativeMemoryCharge() { NativeMemory::add(-bytes_); }
+
+    NativeMemoryCharge(const NativeMemoryCharge&) = delete;
+    NativeMemoryCharge& operator=(const NativeMemoryCharge&) = delete;
+
+    NativeMemoryCharge(NativeMemoryCharge&& other) noexcept : bytes_(other.bytes_) { other.bytes_ = 0; }
+    NativeMemoryCharge& operator=(NativeMemoryCharge&& other) noexcept {
+        if (this != &other) {
+            NativeMemory::add(-bytes_);
+            bytes_ = other.bytes_;
+            other.bytes_ = 0;
+        }
+        return *this;
+    }
+
+    void add(int64_t bytes) {
+        bytes_ += bytes;
+        NativeMemory::add(bytes);
+    }
+
+    int64_t bytes() const { return bytes_; }
+
+private:
+    int64_t bytes_;
+};
+
+} // namespace baja_xlsx
+
+#endif // NATIVE_MEMORY_H
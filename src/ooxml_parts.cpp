@@ -0,0 +1,275 @@
+#include "ooxml_parts.h"
+#include <cstdlib>
+
+namespace baja_xlsx {
+
+static bool isXmlSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+size_t findStartTag(std::string_view xml, std::string_view localName, size_t from, size_t& tagEnd) {
+    size_t pos = from;
+    while ((pos = xml.find('<', pos)) != std::string_view::npos) {
+        size_t nameStart = pos + 1;
+        if (nameStart >= xml.size()) break;
+
+        // Skip end tags, processing instructions and comments
+        char first = xml[nameStart];
+        if (first == '/' || first == '?' || first == '!') {
+            pos = nameStart;
+            continue;
+        }
+
+        size_t nameEnd = nameStart;
+        while (nameEnd < xml.size() && !isXmlSpace(xml[nameEnd]) &&
+               xml[nameEnd] != '>' && xml[nameEnd] != '/') {
+            nameEnd++;
+        }
+
+        std::string_view name = xml.substr(nameStart, nameEnd - nameStart);
+        size_t colon = name.find(':');
+        if (colon != std::string_view::npos) {
+            name = name.substr(colon + 1);
+        }
+
+        if (name == localName) {
+            tagEnd = xml.find('>', nameEnd);
+            if (tagEnd == std::string_view::npos) return std::string_view::npos;
+            return pos;
+        }
+        pos = nameEnd;
+    }
+    return std::string_view::npos;
+}
+
+// "#65" or "#x41" naming a code point XML allows; anything else is left as written
+static bool isCharacterReference(std::string_view entity) {
+    if (entity.size() < 2 || entity[0] != '#') return false;
+    bool hex = entity[1] == 'x' || entity[1] == 'X';
+    std::string_view digits = entity.substr(hex ? 2 : 1);
+    if (digits.empty() || digits.size() > 8) return false;
+
+    unsigned long cp = 0;
+    for (char c : digits) {
+        int value;
+        if (c >= '0' && c <= '9') value = c - '0';
+        else if (hex && c >= 'a' && c <= 'f') value = c - 'a' + 10;
+        else if (hex && c >= 'A' && c <= 'F') value = c - 'A' + 10;
+        else return false;
+        cp = cp * (hex ? 16 : 10) + static_cast<unsigned long>(value);
+    }
+    return cp != 0 && cp <= 0x10FFFF && (cp < 0xD800 || cp > 0xDFFF);
+}
+
+std::string decodeXmlEntities(std::string_view text) {
+    if (text.find('&') == std::string_view::npos) {
+        return std::string(text);
+    }
+
+    std::string result;
+    result.reserve(text.size());
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '&') {
+            result += text[i];
+            continue;
+        }
+
+        size_t semi = text.find(';', i);
+        if (semi == std::string_view::npos) {
+            result += text[i];
+            continue;
+        }
+
+        std::string_view entity = text.substr(i + 1, semi - i - 1);
+        if (entity == "amp") result += '&';
+        else if (entity == "lt") result += '<';
+        else if (entity == "gt") result += '>';
+        else if (entity == "quot") result += '"';
+        else if (entity == "apos") result += '\'';
+        else if (isCharacterReference(entity)) {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            std::string digits(entity.substr(hex ? 2 : 1));
+            unsigned long cp = std::strtoul(digits.c_str(), nullptr, hex ? 16 : 10);
+
+            // Encode the code point as UTF-8
+            if (cp < 0x80) {
+                result += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                result += static_cast<char>(0xC0 | (cp >> 6));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                result += static_cast<char>(0xE0 | (cp >> 12));
+                result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                result += static_cast<char>(0xF0 | (cp >> 18));
+                result += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        } else {
+            // Unknown entity, keep it verbatim
+            result.append(text.data() + i, semi - i + 1);
+        }
+        i = semi;
+    }
+
+    return result;
+}
+
+std::string getXmlAttribute(std::string_view tag, std::string_view attrName) {
+    size_t pos = 0;
+    while ((pos = tag.find(attrName, pos)) != std::string_view::npos) {
+        size_t afterName = pos + attrName.size();
+
+        // Attribute name must be a whole token: preceded by whitespace, followed by '='
+        bool wholeName = pos > 0 && isXmlSpace(tag[pos - 1]);
+        size_t eq = afterName;
+        while (eq < tag.size() && isXmlSpace(tag[eq])) eq++;
+
+        if (wholeName && eq < tag.size() && tag[eq] == '=') {
+            size_t quote = eq + 1;
+            while (quote < tag.size() && isXmlSpace(tag[quote])) quote++;
+            if (quote < tag.size() && (tag[quote] == '"' || tag[quote] == '\'')) {
+                size_t valueEnd = tag.find(tag[quote], quote + 1);
+                if (valueEnd == std::string_view::npos) break;
+                return decodeXmlEntities(tag.substr(quote + 1, valueEnd - quote - 1));
+            }
+        }
+        pos = afterName;
+    }
+    return "";
+}
+
+std::vector<PartRelationship> parseRelationshipList(std::string_view xmlContent) {
+    std::vector<PartRelationship> rels;
+
+    size_t tagEnd = 0;
+    size_t pos = 0;
+    while ((pos = findStartTag(xmlContent, "Relationship", pos, tagEnd)) != std::string_view::npos) {
+        std::string_view tag = xmlContent.substr(pos, tagEnd - pos + 1);
+
+        PartRelationship rel;
+        rel.id = getXmlAttribute(tag, "Id");
+        rel.type = getXmlAttribute(tag, "Type");
+        rel.target = getXmlAttribute(tag, "Target");
+
+        if (!rel.id.empty() && !rel.target.empty()) {
+            rels.push_back(std::move(rel));
+        }
+        pos = tagEnd;
+    }
+
+    return rels;
+}
+
+std::vector<WorkbookSheetEntry> parseWorkbookSheets(std::string_view xmlContent) {
+    std::vector<WorkbookSheetEntry> sheets;
+
+    size_t tagEnd = 0;
+    size_t pos = 0;
+    while ((pos = findStartTag(xmlContent, "sheet", pos, tagEnd)) != std::string_view::npos) {
+        std::string_view tag = xmlContent.substr(pos, tagEnd - pos + 1);
+
+        WorkbookSheetEntry entry;
+        entry.name = getXmlAttribute(tag, "name");
+        entry.relId = getXmlAttribute(tag, "r:id");
+        entry.state = getXmlAttribute(tag, "state");
+        if (entry.state.empty()) {
+            entry.state = "visible";
+        }
+
+        sheets.push_back(std::move(entry));
+        pos = tagEnd;
+    }
+
+    return sheets;
+}
+
+std::string resolvePartTarget(const std::string& sourcePart, const std::string& target) {
+    // Absolute targets are relative to the package root
+    if (!target.empty() && target[0] == '/') {
+        return target.substr(1);
+    }
+
+    // Start from the directory of the source part
+    std::vector<std::string> segments;
+    size_t lastSlash = sourcePart.find_last_of('/');
+    if (lastSlash != std::string::npos) {
+        size_t start = 0;
+        while (start < lastSlash) {
+            size_t slash = sourcePart.find('/', start);
+            if (slash == std::string::npos || slash > lastSlash) slash = lastSlash;
+            if (slash > start) segments.push_back(sourcePart.substr(start, slash - start));
+            start = slash + 1;
+        }
+    }
+
+    size_t start = 0;
+    while (start <= target.size()) {
+        size_t slash = target.find('/', start);
+        if (slash == std::string::npos) slash = target.size();
+        std::string segment = target.substr(start, slash - start);
+
+        if (segment == "..") {
+            if (!segments.empty()) segments.pop_back();
+        } else if (!segment.empty() && segment != ".") {
+            segments.push_back(segment);
+        }
+        start = slash + 1;
+    }
+
+    std::string resolved;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (i > 0) resolved += '/';
+        resolved += segments[i];
+    }
+    return resolved;
+}
+
+std::string relationshipsPartFor(const std::string& partName) {
+    size_t lastSlash = partName.find_last_of('/');
+    if (lastSlash == std::string::npos) {
+        return "_rels/" + partName + ".rels";
+    }
+    return partName.substr(0, lastSlash) + "/_rels/" + partName.substr(lastSlash + 1) + ".rels";
+}
+
+bool relationshipTypeIs(const std::string& type, std::string_view name) {
+    size_t lastSlash = type.find_last_of('/');
+    std::string_view last = (lastSlash != std::string::npos)
+        ? std::string_view(type).substr(lastSlash + 1)
+        : std::string_view(type);
+    return last == name;
+}
+
+bool parseCellReference(std::string_view ref, int& col, int& row) {
+    size_t i = 0;
+    if (i < ref.size() && ref[i] == '$') i++;
+
+    col = 0;
+    size_t letters = 0;
+    while (i < ref.size()) {
+        char c = ref[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c < 'A' || c > 'Z') break;
+        col = col * 26 + (c - 'A' + 1);
+        i++;
+        letters++;
+    }
+
+    if (i < ref.size() && ref[i] == '$') i++;
+
+    row = 0;
+    size_t digits = 0;
+    while (i < ref.size() && ref[i] >= '0' && ref[i] <= '9') {
+        row = row * 10 + (ref[i] - '0');
+        i++;
+        digits++;
+    }
+
+    return letters > 0 && letters <= 3 && digits > 0 && i == ref.size();
+}
+
+} // namespace baja_xlsx
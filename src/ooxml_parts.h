@@ -0,0 +1,57 @@
+#ifndef OOXML_PARTS_H
+#define OOXML_PARTS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace baja_xlsx {
+
+// One <Relationship> entry from a .rels part
+struct PartRelationship {
+    std::string id;       // e.g., "rId1"
+    std::string type;     // e.g., "http://.../relationships/worksheet"
+    std::string target;   // e.g., "worksheets/sheet1.xml" (unresolved)
+};
+
+// One <sheet> entry from xl/workbook.xml
+struct WorkbookSheetEntry {
+    std::string name;
+    std::string relId;    // r:id, resolved through xl/_rels/workbook.xml.rels
+    std::string state;    // "visible", "hidden" or "veryHidden"
+};
+
+// Find the next start tag whose local name is localName (namespace prefix is ignored).
+// Returns the position of '<', or npos. tagEnd receives the position of the closing '>'.
+size_t findStartTag(std::string_view xml, std::string_view localName, size_t from, size_t& tagEnd);
+
+// Read an attribute from a single start tag, e.g. getXmlAttribute("<sheet name=\"A\"/>", "name") -> "A"
+// Entities (&amp; &lt; ...) are decoded.
+std::string getXmlAttribute(std::string_view tag, std::string_view attrName);
+
+// Decode the five predefined XML entities and numeric character references
+std::string decodeXmlEntities(std::string_view text);
+
+// Parse all <Relationship> entries of a .rels part
+std::vector<PartRelationship> parseRelationshipList(std::string_view xmlContent);
+
+// Parse the <sheets> list of xl/workbook.xml, in workbook order
+std::vector<WorkbookSheetEntry> parseWorkbookSheets(std::string_view xmlContent);
+
+// Resolve a relationship target against the part that owns the .rels file
+// e.g. ("xl/workbook.xml", "worksheets/sheet1.xml") -> "xl/worksheets/sheet1.xml"
+//      ("xl/worksheets/sheet1.xml", "../drawings/drawing1.xml") -> "xl/drawings/drawing1.xml"
+std::string resolvePartTarget(const std::string& sourcePart, const std::string& target);
+
+// "xl/worksheets/sheet1.xml" -> "xl/worksheets/_rels/sheet1.xml.rels"
+std::string relationshipsPartFor(const std::string& partName);
+
+// Check a relationship type by its last path segment, e.g. relationshipTypeIs(type, "image")
+bool relationshipTypeIs(const std::string& type, std::string_view name);
+
+// Parse an A1-style reference ("$AB$12" allowed) into 1-based column and row
+bool parseCellReference(std::string_view ref, int& col, int& row);
+
+} // namespace baja_xlsx
+
+#endif // OOXML_PARTS_H
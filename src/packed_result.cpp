@@ -0,0 +1,197 @@
+#include "packed_result.h"
+#include "table_export.h"
+#include <algorithm>
+#include <cstring>
+
+namespace baja_xlsx {
+
+static const size_t kHeaderSize = 32;
+static const uint64_t kMaxPackedSize = 0xFFFFFFFFull;
+
+static size_t alignTo8(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+static void appendJsonNumber(std::string& out, uint64_t value) {
+    out += std::to_string(value);
+}
+
+PackedResult::PackedResult()
+    : cellCount_(0), metaOffset_(0), cellsOffset_(0), textOffset_(0),
+      textLength_(0), mediaOffset_(0), totalLength_(0) {
+}
+
+bool PackedResult::prepare(const ExcelData& data) {
+    meta_.clear();
+    sheetColumns_.clear();
+    cellCount_ = 0;
+    textLength_ = 0;
+
+    // Rows are padded to the widest one, so a cell is found by row * columns + col
+    meta_ += "{\"sheets\":[";
+    for (size_t s = 0; s < data.sheets.size(); ++s) {
+        const SheetData& sheet = data.sheets[s];
+        size_t columns = 0;
+        for (const auto& row : sheet.data) {
+            columns = std::max(columns, row.size());
+            for (const auto& cell : row) textLength_ += cell.size();
+        }
+        sheetColumns_.push_back(columns);
+
+        if (s > 0) meta_ += ',';
+        meta_ += "{\"name\":";
+        appendJsonString(meta_, sheet.name);
+        meta_ += ",\"rows\":";
+        appendJsonNumber(meta_, sheet.data.size());
+        meta_ += ",\"columns\":";
+        appendJsonNumber(meta_, columns);
+        meta_ += ",\"cells\":";
+        appendJsonNumber(meta_, cellCount_);
+        meta_ += ",\"rowIndex\":";
+        if (sheet.rowIndex.empty()) {
+            meta_ += "null";
+        } else {
+            meta_ += '[';
+            for (size_t i = 0; i < sheet.rowIndex.size(); ++i) {
+                if (i > 0) meta_ += ',';
+                appendJsonNumber(meta_, sheet.rowIndex[i]);
+            }
+            meta_ += ']';
+        }
+        meta_ += ",\"schema\":";
+        if (sheet.columns.empty()) {
+            meta_ += "null";
+        } else {
+            meta_ += '[';
+            for (size_t i = 0; i < sheet.columns.size(); ++i) {
+                if (i > 0) meta_ += ',';
+                meta_ += "{\"type\":\"";
+                meta_ += columnTypeName(sheet.columns[i].type);
+                meta_ += "\",\"samples\":";
+                appendJsonNumber(meta_, sheet.columns[i].samples);
+                meta_ += ",\"fallbacks\":";
+                appendJsonNumber(meta_, sheet.columns[i].fallbacks);
+                meta_ += '}';
+            }
+            meta_ += ']';
+        }
+        meta_ += '}';
+        cellCount_ += sheet.data.size() * columns;
+    }
+
+    meta_ += "],\"images\":[";
+    size_t mediaLength = 0;
+    for (size_t i = 0; i < data.images.size(); ++i) {
+        const ImageData& img = data.images[i];
+        if (i > 0) meta_ += ',';
+        meta_ += "{\"name\":";
+        appendJsonString(meta_, img.name);
+        meta_ += ",\"type\":";
+        appendJsonString(meta_, img.type);
+        meta_ += ",\"width\":";
+        meta_ += std::to_string(img.width);
+        meta_ += ",\"height\":";
+        meta_ += std::to_string(img.height);
+        meta_ += ",\"hash\":";
+        appendJsonString(meta_, img.hash);
+        if (!img.sha256.empty()) {
+            meta_ += ",\"sha256\":";
+            appendJsonString(meta_, img.sha256);
+        }
+        meta_ += img.known ? ",\"known\":true" : ",\"known\":false";
+        meta_ += ",\"offset\":";
+        appendJsonNumber(meta_, mediaLength);
+        meta_ += ",\"size\":";
+        appendJsonNumber(meta_, img.data.size());
+        meta_ += '}';
+        mediaLength += img.data.size();
+    }
+
+    // Same shape as the imagePositions of readExcel
+    meta_ += "],\"imagePositions\":[";
+    for (size_t i = 0; i < data.imagePositions.size(); ++i) {
+        const ImagePosition& pos = data.imagePositions[i];
+        if (i > 0) meta_ += ',';
+        meta_ += "{\"image\":";
+        appendJsonString(meta_, pos.imageName);
+        meta_ += ",\"sheet\":";
+        appendJsonString(meta_, pos.sheetName);
+        meta_ += ",\"from\":{\"col\":" + std::to_string(pos.fromCol) + ",\"row\":" + std::to_string(pos.fromRow) +
+                 ",\"colOff\":" + std::to_string(pos.fromColOff) + ",\"rowOff\":" + std::to_string(pos.fromRowOff) + "}";
+        meta_ += ",\"to\":{\"col\":" + std::to_string(pos.toCol) + ",\"row\":" + std::to_string(pos.toRow) +
+                 ",\"colOff\":" + std::to_string(pos.toColOff) + ",\"rowOff\":" + std::to_string(pos.toRowOff) + "}}";
+    }
+
+    meta_ += "],\"cellImageMappings\":[";
+    for (size_t i = 0; i < data.cellImageMappings.size(); ++i) {
+        if (i > 0) meta_ += ',';
+        meta_ += "{\"imageId\":";
+        appendJsonString(meta_, data.cellImageMappings[i].imageId);
+        meta_ += ",\"imageName\":";
+        appendJsonString(meta_, data.cellImageMappings[i].imageName);
+        meta_ += '}';
+    }
+    meta_ += "]}";
+
+    metaOffset_ = kHeaderSize;
+    cellsOffset_ = alignTo8(metaOffset_ + meta_.size());
+    textOffset_ = alignTo8(cellsOffset_ + (static_cast<uint64_t>(cellCount_) + 1) * sizeof(uint32_t));
+    mediaOffset_ = alignTo8(textOffset_ + textLength_);
+    uint64_t total = static_cast<uint64_t>(mediaOffset_) + mediaLength;
+    if (total > kMaxPackedSize) {
+        lastError_ = "Packed result exceeds 4 GB (" + std::to_string(total) + " bytes)";
+        return false;
+    }
+    totalLength_ = static_cast<size_t>(total);
+    lastError_.clear();
+    return true;
+}
+
+void PackedResult::write(const ExcelData& data, uint8_t* out) const {
+    std::memset(out, 0, textOffset_);
+    putU32(out, kMagic);
+    putU32(out + 4, kVersion);
+    putU32(out + 8, static_cast<uint32_t>(metaOffset_));
+    putU32(out + 12, static_cast<uint32_t>(meta_.size()));
+    putU32(out + 16, static_cast<uint32_t>(cellsOffset_));
+    putU32(out + 20, static_cast<uint32_t>(textOffset_));
+    putU32(out + 24, static_cast<uint32_t>(mediaOffset_));
+    putU32(out + 28, static_cast<uint32_t>(totalLength_));
+    std::memcpy(out + metaOffset_, meta_.data(), meta_.size());
+
+    // Short rows leave empty cells: their start repeats the next offset
+    uint8_t* cells = out + cellsOffset_;
+    uint8_t* text = out + textOffset_;
+    size_t textPos = 0;
+    for (size_t s = 0; s < data.sheets.size(); ++s) {
+        size_t columns = sheetColumns_[s];
+        for (const auto& row : data.sheets[s].data) {
+            for (size_t col = 0; col < columns; ++col) {
+                putU32(cells, static_cast<uint32_t>(textPos));
+                cells += sizeof(uint32_t);
+                if (col < row.size() && !row[col].empty()) {
+                    std::memcpy(text + textPos, row[col].data(), row[col].size());
+                    textPos += row[col].size();
+                }
+            }
+        }
+    }
+    putU32(cells, static_cast<uint32_t>(textPos));
+    std::memset(text + textPos, 0, mediaOffset_ - textOffset_ - textPos);
+
+    uint8_t* media = out + mediaOffset_;
+    for (const auto& img : data.images) {
+        if (img.data.empty()) continue;
+        std::memcpy(media, img.data.data(), img.data.size());
+        media += img.data.size();
+    }
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,57 @@
+#ifndef PACKED_RESULT_H
+#define PACKED_RESULT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+// Packs a read result into one contiguous block, so it can cross threads as a
+// single transferable ArrayBuffer instead of being structured-cloned cell by
+// cell. All integers are little-endian uint32; sections start 8-byte aligned.
+//
+//   header   magic "BXPK", version, metaOffset, metaLength,
+//            cellsOffset, textOffset, mediaOffset, totalLength
+//   meta     UTF-8 JSON: sheets {name, rows, columns, cells, rowIndex},
+//            images {name, type, width, height, hash, sha256, known, offset, size},
+//            imagePositions, cellImageMappings
+//   cells    one offset into text per cell, row-major per sheet, plus a final end
+//            offset; a sheet's cells start at its "cells" entry
+//   text     cell text, UTF-8, back to back
+//   media    image bytes; offsets in meta are relative to mediaOffset
+class PackedResult {
+public:
+    static const uint32_t kMagic = 0x4B505842;   // "BXPK"
+    static const uint32_t kVersion = 1;
+
+    PackedResult();
+
+    // Lay out data; false when it does not fit 32-bit offsets
+    bool prepare(const ExcelData& data);
+
+    // Bytes the packed block needs, valid after prepare()
+    size_t size() const { return totalLength_; }
+
+    // Write the block into out, which holds size() bytes
+    void write(const ExcelData& data, uint8_t* out) const;
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    std::string meta_;
+    std::vector<size_t> sheetColumns_;
+    size_t cellCount_;
+    size_t metaOffset_;
+    size_t cellsOffset_;
+    size_t textOffset_;
+    size_t textLength_;
+    size_t mediaOffset_;
+    size_t totalLength_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // PACKED_RESULT_H
@@ -0,0 +1,352 @@
+#include "parse_cache.h"
+#include "content_hash.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace baja_xlsx {
+
+namespace fs = std::filesystem;
+
+static const char kSnapshotMagic[8] = {'B', 'A', 'J', 'A', 'X', 'L', 'S', 'C'};
+
+// Bump when the snapshot layout or the text produced by the readers changes
+static const uint32_t kSnapshotVersion = 4;
+
+// Buffered little helpers over an ofstream; the layout is host-endian, entries
+// are only read back by the machine that wrote them
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::ofstream& out) : out_(out), written_(0) {}
+
+    void bytes(const void* data, size_t size) {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        written_ += size;
+    }
+    void u8(uint8_t value) { bytes(&value, sizeof(value)); }
+    void u32(uint32_t value) { bytes(&value, sizeof(value)); }
+    void i32(int32_t value) { bytes(&value, sizeof(value)); }
+    void u64(uint64_t value) { bytes(&value, sizeof(value)); }
+    void i64(int64_t value) { bytes(&value, sizeof(value)); }
+    void str(std::string_view text) {
+        u32(static_cast<uint32_t>(text.size()));
+        bytes(text.data(), text.size());
+    }
+
+    uint64_t written() const { return written_; }
+
+private:
+    std::ofstream& out_;
+    uint64_t written_;
+};
+
+// Bounds-checked cursor over a loaded snapshot; any overrun marks it failed
+class SnapshotReader {
+public:
+    SnapshotReader(const char* data, size_t size) : data_(data), size_(size), pos_(0), ok_(true) {}
+
+    bool ok() const { return ok_; }
+
+    const char* take(size_t size) {
+        if (!ok_ || size > size_ - pos_) {
+            ok_ = false;
+            return nullptr;
+        }
+        const char* at = data_ + pos_;
+        pos_ += size;
+        return at;
+    }
+    template <class T>
+    T read() {
+        T value{};
+        const char* at = take(sizeof(T));
+        if (at) std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+    std::string_view view() {
+        uint32_t size = read<uint32_t>();
+        const char* at = take(size);
+        return at ? std::string_view(at, size) : std::string_view();
+    }
+    std::string str() {
+        return std::string(view());
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_;
+    bool ok_;
+};
+
+ParseCache::ParseCache(const std::string& directory) : directory_(directory) {
+}
+
+std::string ParseCache::entryPath(const std::string& key) const {
+    return (fs::path(directory_) / (key + ".bin")).string();
+}
+
+bool ParseCache::computeKey(const std::string& xlsxPath, const ReadOptions& options, std::string& outKey) {
+    std::ifstream file(xlsxPath, std::ios::binary);
+    if (!file) {
+        lastError_ = "Failed to open file for hashing: " + xlsxPath;
+        return false;
+    }
+
+    Xxh64Hasher content;
+    std::vector<char> buffer(1 << 20);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        content.update(reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(file.gcount()));
+    }
+
+    char variant[128];
+    std::snprintf(variant, sizeof(variant), "v%u;valuesOnly=%d;iso=%d;sha256=%d;schema=%zu@%zu", kSnapshotVersion,
+                  options.valuesOnly ? 1 : 0, options.isoDates ? 1 : 0, options.computeSha256 ? 1 : 0,
+                  options.schemaRows, options.schemaRows > 0 ? options.schemaStartRow : 0);
+    Xxh64Hasher optionsHash;
+    optionsHash.update(reinterpret_cast<const uint8_t*>(variant), std::strlen(variant));
+
+    outKey = content.hexDigest() + "-" + optionsHash.hexDigest();
+    return true;
+}
+
+bool ParseCache::load(const std::string& key, ExcelData& data) {
+    std::string path = entryPath(key);
+    std::error_code ec;
+    uint64_t size = fs::file_size(path, ec);
+    if (ec || size < sizeof(kSnapshotMagic) + 16) {
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    // Header: magic, version, reserved, offset of the trailing media section
+    char header[sizeof(kSnapshotMagic) + 16];
+    if (!file.read(header, sizeof(header))) return false;
+    SnapshotReader head(header, sizeof(header));
+    const char* magic = head.take(sizeof(kSnapshotMagic));
+    if (!magic || std::memcmp(magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        head.read<uint32_t>() != kSnapshotVersion) {
+        return false;
+    }
+    head.read<uint32_t>();  // reserved
+    uint64_t mediaOffset = head.read<uint64_t>();
+    if (mediaOffset < sizeof(header) || mediaOffset > size) return false;
+
+    // Metadata and cell text live in the arena, where cell text points straight
+    // into them; media bytes are read into each image below, so they are held once
+    auto arena = std::make_shared<Arena>();
+    size_t metaSize = static_cast<size_t>(mediaOffset - sizeof(header));
+    char* buffer = static_cast<char*>(arena->allocate(metaSize, 8));
+    if (!file.read(buffer, static_cast<std::streamsize>(metaSize))) {
+        return false;
+    }
+
+    SnapshotReader in(buffer, metaSize);
+    uint32_t sheetCount = in.read<uint32_t>();
+    if (sheetCount > size) return false;
+    std::vector<SheetData> sheets(sheetCount);
+    for (auto& sheet : sheets) {
+        if (!in.ok()) return false;
+        sheet.name = in.str();
+        sheet.data = ArenaVector<SheetRow>(ArenaAllocator<SheetRow>(arena.get()));
+        uint32_t rows = in.read<uint32_t>();
+        sheet.data.reserve(std::min<uint64_t>(rows, size));
+        for (uint32_t row = 0; row < rows && in.ok(); ++row) {
+            uint32_t cells = in.read<uint32_t>();
+            SheetRow rowData{ArenaAllocator<CellText>(arena.get())};
+            rowData.reserve(std::min<uint64_t>(cells, size));
+            for (uint32_t col = 0; col < cells && in.ok(); ++col) {
+                rowData.push_back(in.view());
+            }
+            sheet.data.push_back(std::move(rowData));
+        }
+        uint32_t columns = in.read<uint32_t>();
+        if (columns > size) return false;
+        sheet.columns.resize(columns);
+        for (auto& column : sheet.columns) {
+            uint8_t type = in.read<uint8_t>();
+            if (type > static_cast<uint8_t>(ColumnType::Mixed)) return false;
+            column.type = static_cast<ColumnType>(type);
+            column.samples = in.read<uint32_t>();
+            column.fallbacks = in.read<uint64_t>();
+        }
+    }
+
+    uint32_t imageCount = in.read<uint32_t>();
+    if (imageCount > size) return false;
+    std::vector<ImageData> images(imageCount);
+    std::vector<std::pair<uint64_t, uint64_t>> mediaRanges;   // offset, length in the media section
+    mediaRanges.reserve(imageCount);
+    for (auto& image : images) {
+        if (!in.ok()) return false;
+        image.name = in.str();
+        image.type = in.str();
+        image.width = in.read<int32_t>();
+        image.height = in.read<int32_t>();
+        image.hash = in.str();
+        image.sha256 = in.str();
+        image.known = false;
+        uint64_t offset = in.read<uint64_t>();
+        uint64_t length = in.read<uint64_t>();
+        if (offset > size - mediaOffset || length > size - mediaOffset - offset) return false;
+        mediaRanges.emplace_back(offset, length);
+    }
+
+    uint32_t positionCount = in.read<uint32_t>();
+    if (positionCount > size) return false;
+    std::vector<ImagePosition> positions(positionCount);
+    for (auto& pos : positions) {
+        if (!in.ok()) return false;
+        pos.imageName = in.str();
+        pos.sheetName = in.str();
+        pos.fromCol = in.read<int32_t>();
+        pos.fromRow = in.read<int32_t>();
+        pos.toCol = in.read<int32_t>();
+        pos.toRow = in.read<int32_t>();
+        pos.fromColOff = in.read<int64_t>();
+        pos.fromRowOff = in.read<int64_t>();
+        pos.toColOff = in.read<int64_t>();
+        pos.toRowOff = in.read<int64_t>();
+    }
+
+    uint32_t mappingCount = in.read<uint32_t>();
+    if (mappingCount > size) return false;
+    std::vector<CellImageMapping> mappings(mappingCount);
+    for (auto& mapping : mappings) {
+        if (!in.ok()) return false;
+        mapping.imageId = in.str();
+        mapping.imageName = in.str();
+    }
+    if (!in.ok()) return false;
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        std::vector<uint8_t>& bytes = images[i].data;
+        bytes.resize(static_cast<size_t>(mediaRanges[i].second));
+        file.seekg(static_cast<std::streamoff>(mediaOffset + mediaRanges[i].first));
+        if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            return false;
+        }
+    }
+
+    data.arena = std::move(arena);
+    data.sheets = std::move(sheets);
+    data.images = std::move(images);
+    data.imagePositions = std::move(positions);
+    data.cellImageMappings = std::move(mappings);
+    return true;
+}
+
+bool ParseCache::store(const std::string& key, const ExcelData& data) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec) {
+        lastError_ = "Failed to create cache directory: " + ec.message();
+        return false;
+    }
+
+    std::random_device rd;
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), ".tmp-%08x", rd());
+    std::string finalPath = entryPath(key);
+    std::string tempPath = finalPath + suffix;
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            lastError_ = "Failed to create cache entry: " + tempPath;
+            return false;
+        }
+        SnapshotWriter out(file);
+
+        // Header; the media offset is patched once the metadata size is known
+        out.bytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+        out.u32(kSnapshotVersion);
+        out.u32(0);
+        std::streampos mediaOffsetPos = file.tellp();
+        out.u64(0);
+
+        out.u32(static_cast<uint32_t>(data.sheets.size()));
+        for (const auto& sheet : data.sheets) {
+            out.str(sheet.name);
+            out.u32(static_cast<uint32_t>(sheet.data.size()));
+            for (const auto& row : sheet.data) {
+                out.u32(static_cast<uint32_t>(row.size()));
+                for (CellText cell : row) {
+                    out.str(cell);
+                }
+            }
+            out.u32(static_cast<uint32_t>(sheet.columns.size()));
+            for (const auto& column : sheet.columns) {
+                out.u8(static_cast<uint8_t>(column.type));
+                out.u32(column.samples);
+                out.u64(column.fallbacks);
+            }
+        }
+
+        uint64_t mediaSize = 0;
+        out.u32(static_cast<uint32_t>(data.images.size()));
+        for (const auto& image : data.images) {
+            out.str(image.name);
+            out.str(image.type);
+            out.i32(image.width);
+            out.i32(image.height);
+            out.str(image.hash);
+            out.str(image.sha256);
+            out.u64(mediaSize);
+            out.u64(image.data.size());
+            mediaSize += image.data.size();
+        }
+
+        out.u32(static_cast<uint32_t>(data.imagePositions.size()));
+        for (const auto& pos : data.imagePositions) {
+            out.str(pos.imageName);
+            out.str(pos.sheetName);
+            out.i32(pos.fromCol);
+            out.i32(pos.fromRow);
+            out.i32(pos.toCol);
+            out.i32(pos.toRow);
+            out.i64(pos.fromColOff);
+            out.i64(pos.fromRowOff);
+            out.i64(pos.toColOff);
+            out.i64(pos.toRowOff);
+        }
+
+        out.u32(static_cast<uint32_t>(data.cellImageMappings.size()));
+        for (const auto& mapping : data.cellImageMappings) {
+            out.str(mapping.imageId);
+            out.str(mapping.imageName);
+        }
+
+        // Media section, 8-byte aligned
+        static const char padding[8] = {};
+        out.bytes(padding, (8 - out.written() % 8) % 8);
+        uint64_t mediaOffset = out.written();
+        for (const auto& image : data.images) {
+            out.bytes(image.data.data(), image.data.size());
+        }
+
+        file.seekp(mediaOffsetPos);
+        file.write(reinterpret_cast<const char*>(&mediaOffset), sizeof(mediaOffset));
+        file.close();
+        if (!file) {
+            lastError_ = "Failed to write cache entry: " + tempPath;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, finalPath, ec);
+    if (ec) {
+        lastError_ = "Failed to store cache entry: " + ec.message();
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace baja_xlsx
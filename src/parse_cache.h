@@ -0,0 +1,43 @@
+#ifndef PARSE_CACHE_H
+#define PARSE_CACHE_H
+
+#include <string>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+// On-disk cache of parsed workbooks. Entries are keyed by the XXH64 of the file
+// bytes plus the options that change the parsed result (valuesOnly, dates,
+// sha256); filters and knownHashes are applied after loading, so they share entries.
+//
+// An entry is one binary snapshot: sheets as length-prefixed cell text in row
+// order, image metadata with offsets into a trailing media section, anchors and
+// WPS cell image mappings. Loading reads everything before the media section
+// into the result's arena in one go and points cell text straight into it; media
+// bytes are read directly into their images.
+class ParseCache {
+public:
+    explicit ParseCache(const std::string& directory);
+
+    // Cache key for a file read with options; false when the file cannot be read
+    bool computeKey(const std::string& xlsxPath, const ReadOptions& options, std::string& outKey);
+
+    // Fill data from the entry for key; false on a miss or an unreadable entry
+    bool load(const std::string& key, ExcelData& data);
+
+    // Write the entry for key. The snapshot goes to a temporary name first and is
+    // renamed into place, so concurrent readers never see a partial entry.
+    bool store(const std::string& key, const ExcelData& data);
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    std::string entryPath(const std::string& key) const;
+
+    std::string directory_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // PARSE_CACHE_H
@@ -0,0 +1,79 @@
+#include "read_control.h"
+#include <algorithm>
+
+namespace baja_xlsx {
+
+ReadControl::ReadControl()
+    : cancelled_(false), phase_(ReadProgress::Load), bytesRead_(0), sheetsDone_(0), sheetCount_(0),
+      rowsDone_(0), bytesInflated_(0), interval_(std::chrono::milliseconds(100)), nextReport_(0) {
+}
+
+void ReadControl::setProgressCallback(ProgressCallback callback, std::chrono::milliseconds interval) {
+    callback_ = std::move(callback);
+    interval_ = interval;
+}
+
+void ReadControl::setPhase(ReadProgress::Phase phase) {
+    phase_.store(phase, std::memory_order_relaxed);
+    report(true);
+}
+
+void ReadControl::report(bool force) {
+    if (!callback_) {
+        return;
+    }
+
+    int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    if (!force && now < nextReport_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Whoever holds the lock reports and other threads just keep working; a
+    // forced report (phase change, final flush) waits so it is never lost
+    std::unique_lock<std::mutex> lock(reportMutex_, std::defer_lock);
+    if (force) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return;
+    }
+    nextReport_.store(now + interval_.count(), std::memory_order_relaxed);
+
+    ReadProgress progress;
+    progress.phase = static_cast<ReadProgress::Phase>(phase_.load(std::memory_order_relaxed));
+    progress.bytesRead = bytesRead_.load(std::memory_order_relaxed);
+    progress.sheetsDone = sheetsDone_.load(std::memory_order_relaxed);
+    progress.sheetCount = sheetCount_.load(std::memory_order_relaxed);
+    progress.rowsDone = rowsDone_.load(std::memory_order_relaxed);
+    progress.bytesInflated = bytesInflated_.load(std::memory_order_relaxed);
+    callback_(progress);
+}
+
+ControlledFileBuf::int_type ControlledFileBuf::underflow() {
+    if (control_ && control_->cancelled()) {
+        return traits_type::eof();
+    }
+
+    int_type result = std::filebuf::underflow();
+    if (control_ && result != traits_type::eof()) {
+        control_->addBytesRead(static_cast<uint64_t>(egptr() - gptr()));
+    }
+    return result;
+}
+
+std::streamsize ControlledFileBuf::xsgetn(char_type* s, std::streamsize n) {
+    // std::filebuf may read large requests straight from the file; copying out
+    // of the buffer instead keeps every byte going through underflow()
+    std::streamsize done = 0;
+    while (done < n) {
+        if (gptr() == egptr() && traits_type::eq_int_type(underflow(), traits_type::eof())) {
+            break;
+        }
+        std::streamsize chunk = std::min<std::streamsize>(n - done, egptr() - gptr());
+        traits_type::copy(s + done, gptr(), static_cast<size_t>(chunk));
+        gbump(static_cast<int>(chunk));
+        done += chunk;
+    }
+    return done;
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,90 @@
+#ifndef READ_CONTROL_H
+#define READ_CONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <streambuf>
+#include <fstream>
+#include <string>
+
+namespace baja_xlsx {
+
+// Error text used by every component when a read stops because of cancel()
+constexpr const char* kReadAbortedError = "Read aborted";
+
+struct ReadProgress {
+    enum Phase { Load, Sheets, Images };
+
+    Phase phase;
+    uint64_t bytesRead;       // package bytes consumed while loading the workbook
+    int sheetsDone;
+    int sheetCount;
+    uint64_t rowsDone;        // rows converted across all sheets
+    uint64_t bytesInflated;   // media bytes inflated by the image extractor
+};
+
+// Shared between the JS thread and the threads doing one read: carries the
+// cancel flag and collects progress counters. Counters are updated from the
+// hot loops with relaxed atomics; the callback is throttled to one call per
+// interval and is never called concurrently with itself.
+class ReadControl {
+public:
+    using ProgressCallback = std::function<void(const ReadProgress& progress)>;
+
+    ReadControl();
+
+    void setProgressCallback(ProgressCallback callback, std::chrono::milliseconds interval);
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    void setPhase(ReadProgress::Phase phase);
+    void setSheetCount(int count) { sheetCount_.store(count, std::memory_order_relaxed); }
+    void sheetDone() { sheetsDone_.fetch_add(1, std::memory_order_relaxed); report(false); }
+    void addBytesRead(uint64_t n) { bytesRead_.fetch_add(n, std::memory_order_relaxed); report(false); }
+    void addRows(uint64_t n) { rowsDone_.fetch_add(n, std::memory_order_relaxed); report(false); }
+    void addBytesInflated(uint64_t n) { bytesInflated_.fetch_add(n, std::memory_order_relaxed); report(false); }
+
+    // Deliver the current counters now, regardless of the interval; waits for
+    // a report in progress on another thread rather than dropping this one
+    void flush() { report(true); }
+
+private:
+    void report(bool force);
+
+    std::atomic<bool> cancelled_;
+    std::atomic<int> phase_;
+    std::atomic<uint64_t> bytesRead_;
+    std::atomic<int> sheetsDone_;
+    std::atomic<int> sheetCount_;
+    std::atomic<uint64_t> rowsDone_;
+    std::atomic<uint64_t> bytesInflated_;
+
+    ProgressCallback callback_;
+    std::chrono::steady_clock::duration interval_;
+    std::atomic<int64_t> nextReport_;   // steady_clock ticks
+    std::mutex reportMutex_;
+};
+
+// File buffer handed to xlnt's loader: every refill counts toward bytesRead
+// and returns EOF once the read is cancelled, which makes xlnt abandon the
+// load with an exception instead of running to completion. Bulk reads are
+// served through the same refills, so none of them bypass the check.
+class ControlledFileBuf : public std::filebuf {
+public:
+    explicit ControlledFileBuf(ReadControl* control) : control_(control) {}
+
+protected:
+    int_type underflow() override;
+    std::streamsize xsgetn(char_type* s, std::streamsize n) override;
+
+private:
+    ReadControl* control_;
+};
+
+} // namespace baja_xlsx
+
+#endif // READ_CONTROL_H
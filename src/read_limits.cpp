@@ -0,0 +1,87 @@
+#include "read_limits.h"
+#include "zip_archive.h"
+
+namespace baja_xlsx {
+
+// Entries smaller than this are never a memory threat, whatever their ratio
+static const uint64_t kRatioCheckFloor = 1024 * 1024;
+
+static const char* kLimitPrefix = "Read limit exceeded: ";
+
+bool checkEntrySize(const std::string& name, uint64_t size, const ReadLimits& limits, std::string& outError) {
+    if (limits.maxEntrySize && size > limits.maxEntrySize) {
+        outError = std::string(kLimitPrefix) + name + " inflates to " + std::to_string(size) +
+                   " bytes (maxEntrySize " + std::to_string(limits.maxEntrySize) + ")";
+        return false;
+    }
+    return true;
+}
+
+bool checkArchiveLimits(const ZipArchive& archive, const ReadLimits& limits, std::string& outError) {
+    if (!limits.enabled()) {
+        return true;
+    }
+
+    uint64_t totalSize = 0;
+    uint64_t mediaCount = 0;
+
+    int64_t count = archive.entryCount();
+    for (int64_t i = 0; i < count; ++i) {
+        ZipEntryInfo info;
+        if (!archive.entryInfo(i, info)) continue;
+
+        if (!checkEntrySize(info.name, info.uncompressedSize, limits, outError)) {
+            return false;
+        }
+
+        if (limits.maxCompressionRatio > 0 && info.uncompressedSize >= kRatioCheckFloor) {
+            double ratio = info.compressedSize > 0
+                ? static_cast<double>(info.uncompressedSize) / static_cast<double>(info.compressedSize)
+                : static_cast<double>(info.uncompressedSize);
+            if (ratio > limits.maxCompressionRatio) {
+                outError = std::string(kLimitPrefix) + info.name + " has compression ratio " +
+                           std::to_string(static_cast<uint64_t>(ratio)) + ":1 (maxCompressionRatio " +
+                           std::to_string(static_cast<uint64_t>(limits.maxCompressionRatio)) + ")";
+                return false;
+            }
+        }
+
+        totalSize += info.uncompressedSize;
+        if (limits.maxUncompressedSize && totalSize > limits.maxUncompressedSize) {
+            outError = std::string(kLimitPrefix) + "archive inflates to more than " +
+                       std::to_string(limits.maxUncompressedSize) + " bytes (maxUncompressedSize)";
+            return false;
+        }
+
+        if (info.name.compare(0, 9, "xl/media/") == 0 && info.name.size() > 9) {
+            if (!checkImageCount(++mediaCount, limits, outError)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool checkImageCount(uint64_t count, const ReadLimits& limits, std::string& outError) {
+    if (limits.maxImages && count > limits.maxImages) {
+        outError = std::string(kLimitPrefix) + "more than " + std::to_string(limits.maxImages) +
+                   " images (maxImages)";
+        return false;
+    }
+    return true;
+}
+
+bool checkCellCount(const std::string& sheetName, uint64_t rows, uint64_t columns,
+                    uint64_t& totalCells, const ReadLimits& limits, std::string& outError) {
+    // rows and columns are bounded by Excel's 1048576 x 16384 grid, so this cannot overflow
+    totalCells += rows * columns;
+    if (limits.maxCells && totalCells > limits.maxCells) {
+        outError = std::string(kLimitPrefix) + "sheet \"" + sheetName + "\" brings the cell count to " +
+                   std::to_string(totalCells) + " (maxCells " + std::to_string(limits.maxCells) + ")";
+        return false;
+    }
+    return true;
+}
+
+} // namespace baja_xlsx
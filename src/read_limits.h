@@ -0,0 +1,44 @@
+#ifndef READ_LIMITS_H
+#define READ_LIMITS_H
+
+#include <cstdint>
+#include <string>
+
+namespace baja_xlsx {
+
+class ZipArchive;
+
+// Resource limits for one read. Zero means unlimited (the default for every field).
+struct ReadLimits {
+    uint64_t maxUncompressedSize;   // sum of all entries once inflated
+    uint64_t maxEntrySize;          // any single entry once inflated
+    double maxCompressionRatio;     // uncompressed / compressed, per entry of 1 MB or more
+    uint64_t maxCells;              // rows x columns across all sheets
+    uint64_t maxImages;             // media parts under xl/media/
+
+    ReadLimits()
+        : maxUncompressedSize(0), maxEntrySize(0), maxCompressionRatio(0), maxCells(0), maxImages(0) {}
+
+    bool enabled() const {
+        return maxUncompressedSize || maxEntrySize || maxCompressionRatio > 0 || maxCells || maxImages;
+    }
+};
+
+// Check the central directory against the limits before anything is inflated.
+// Entry sizes are bounded again when entries are actually read, since readers
+// never inflate more than the declared size.
+bool checkArchiveLimits(const ZipArchive& archive, const ReadLimits& limits, std::string& outError);
+
+// Check one entry's declared size before allocating room for it
+bool checkEntrySize(const std::string& name, uint64_t size, const ReadLimits& limits, std::string& outError);
+
+// Check the number of media parts against maxImages
+bool checkImageCount(uint64_t count, const ReadLimits& limits, std::string& outError);
+
+// Check a sheet's grid before it is allocated; totalCells accumulates across sheets
+bool checkCellCount(const std::string& sheetName, uint64_t rows, uint64_t columns,
+                    uint64_t& totalCells, const ReadLimits& limits, std::string& outError);
+
+} // namespace baja_xlsx
+
+#endif // READ_LIMITS_H
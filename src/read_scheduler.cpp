@@ -0,0 +1,112 @@
+#include "read_scheduler.h"
+#include "read_control.h"
+#include <algorithm>
+
+namespace baja_xlsx {
+
+// xlnt keeps a cell model several times the size of the sheet XML; the values
+// only reader holds roughly the XML plus the arena it decodes into
+static const uint64_t kFullModelFactor = 4;
+static const uint64_t kValuesOnlyFactor = 2;
+
+// How often a queued read looks at its cancel flag
+static const std::chrono::milliseconds kCancelPollInterval(50);
+
+ReadScheduler& ReadScheduler::instance() {
+    static ReadScheduler scheduler;
+    return scheduler;
+}
+
+ReadScheduler::ReadScheduler() : stats_() {
+}
+
+void ReadScheduler::configure(const SchedulerLimits& limits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limits_ = limits;
+    // A larger budget may let queued reads start right away
+    admitWaiting();
+}
+
+SchedulerLimits ReadScheduler::limits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limits_;
+}
+
+SchedulerStats ReadScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SchedulerStats stats = stats_;
+    stats.queued = queue_.size();
+    return stats;
+}
+
+uint64_t ReadScheduler::estimateReadBytes(uint64_t uncompressedBytes, bool valuesOnly) {
+    return uncompressedBytes * (valuesOnly ? kValuesOnlyFactor : kFullModelFactor);
+}
+
+bool ReadScheduler::fits(uint64_t estimate) const {
+    if (limits_.maxConcurrent && stats_.running >= limits_.maxConcurrent) {
+        return false;
+    }
+    return !limits_.memoryBudget || stats_.running == 0 ||
+           stats_.reservedBytes + estimate <= limits_.memoryBudget;
+}
+
+void ReadScheduler::admit(uint64_t estimate) {
+    stats_.running++;
+    stats_.reservedBytes += estimate;
+    stats_.admitted++;
+}
+
+// Strict arrival order: a large read at the head is not overtaken by small ones
+void ReadScheduler::admitWaiting() {
+    bool any = false;
+    while (!queue_.empty() && fits(queue_.front()->estimate)) {
+        Waiter* waiter = queue_.front();
+        queue_.pop_front();
+        admit(waiter->estimate);
+        waiter->admitted = true;
+        any = true;
+    }
+    if (any) {
+        admittedCv_.notify_all();
+    }
+}
+
+bool ReadScheduler::acquire(uint64_t estimate, ReadControl* control) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queue_.empty() && fits(estimate)) {
+        admit(estimate);
+        return true;
+    }
+
+    Waiter waiter{estimate, false};
+    queue_.push_back(&waiter);
+    stats_.peakQueued = std::max(stats_.peakQueued, queue_.size());
+    auto start = std::chrono::steady_clock::now();
+
+    while (!waiter.admitted) {
+        if (control && control->cancelled()) {
+            queue_.erase(std::find(queue_.begin(), queue_.end(), &waiter));
+            // The head may have changed
+            admitWaiting();
+            return false;
+        }
+        admittedCv_.wait_for(lock, kCancelPollInterval);
+    }
+
+    uint64_t waitedMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    stats_.waited++;
+    stats_.totalWaitMs += waitedMs;
+    stats_.maxWaitMs = std::max(stats_.maxWaitMs, waitedMs);
+    return true;
+}
+
+void ReadScheduler::release(uint64_t estimate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.running--;
+    stats_.reservedBytes -= estimate;
+    admitWaiting();
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,104 @@
+#ifndef READ_SCHEDULER_H
+#define READ_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace baja_xlsx {
+
+class ReadControl;
+
+// Global admission budget for reads; 0 means unlimited
+struct SchedulerLimits {
+    size_t maxConcurrent;     // reads parsing at the same time
+    uint64_t memoryBudget;    // sum of the memory estimates of running reads
+
+    SchedulerLimits() : maxConcurrent(0), memoryBudget(0) {}
+};
+
+struct SchedulerStats {
+    size_t running;
+    size_t queued;
+    uint64_t reservedBytes;   // estimates of the running reads
+    uint64_t admitted;        // reads started since process start
+    uint64_t waited;          // of those, reads that had to queue
+    uint64_t totalWaitMs;
+    uint64_t maxWaitMs;
+    size_t peakQueued;
+};
+
+// Process-wide gate in front of every workbook parse. A read reserves an
+// estimate of the memory it will need and is admitted while the running reads
+// stay within the budget; the rest wait in arrival order, so a burst of
+// uploads degrades into a queue instead of adding up to one large peak. A read
+// whose estimate alone exceeds the budget runs once nothing else is running.
+// Waiting blocks the calling thread; async reads and readMany run on their
+// own native threads, so only synchronous calls block the JS thread.
+class ReadScheduler {
+public:
+    static ReadScheduler& instance();
+
+    void configure(const SchedulerLimits& limits);
+    SchedulerLimits limits() const;
+    SchedulerStats stats() const;
+
+    // Memory a read is expected to need, from the uncompressed package size
+    static uint64_t estimateReadBytes(uint64_t uncompressedBytes, bool valuesOnly);
+
+    // Wait until the read may start; false when control is cancelled first
+    bool acquire(uint64_t estimate, ReadControl* control);
+    void release(uint64_t estimate);
+
+private:
+    struct Waiter {
+        uint64_t estimate;
+        bool admitted;
+    };
+
+    ReadScheduler();
+
+    bool fits(uint64_t estimate) const;
+    void admitWaiting();
+    void admit(uint64_t estimate);
+
+    mutable std::mutex mutex_;
+    std::condition_variable admittedCv_;
+    std::deque<Waiter*> queue_;
+    SchedulerLimits limits_;
+    SchedulerStats stats_;
+};
+
+// Scheduler admission held for the lifetime of the object
+class ScheduledRead {
+public:
+    ScheduledRead() : estimate_(0), admitted_(false) {}
+    ~ScheduledRead() { release(); }
+
+    ScheduledRead(const ScheduledRead&) = delete;
+    ScheduledRead& operator=(const ScheduledRead&) = delete;
+
+    bool acquire(uint64_t estimate, ReadControl* control) {
+        release();
+        admitted_ = ReadScheduler::instance().acquire(estimate, control);
+        estimate_ = estimate;
+        return admitted_;
+    }
+
+    void release() {
+        if (admitted_) {
+            ReadScheduler::instance().release(estimate_);
+            admitted_ = false;
+        }
+    }
+
+private:
+    uint64_t estimate_;
+    bool admitted_;
+};
+
+} // namespace baja_xlsx
+
+#endif // READ_SCHEDULER_H
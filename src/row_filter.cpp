@@ -0,0 +1,125 @@
+#include "row_filter.h"
+#include "cell_format.h"
+
+namespace baja_xlsx {
+
+// Whole cell text as a number; "", "12abc" and image markers are not numbers
+static bool parseNumber(CellText text, double& out) {
+    return !text.empty() && parseDecimal(text, out) == text.size();
+}
+
+static bool matches(CellText text, const FilterValue& value) {
+    if (!value.isNumber) {
+        return text == value.text;
+    }
+    double number = 0;
+    return parseNumber(text, number) && number == value.number;
+}
+
+// -1 when text is below value, 1 when above, 0 when equal; false when not comparable
+static bool compare(CellText text, const FilterValue& value, int& outOrder) {
+    if (!value.isNumber) {
+        if (text.empty()) return false;
+        int order = text.compare(value.text);
+        outOrder = order < 0 ? -1 : (order > 0 ? 1 : 0);
+        return true;
+    }
+    double number = 0;
+    if (!parseNumber(text, number)) return false;
+    outOrder = number < value.number ? -1 : (number > value.number ? 1 : 0);
+    return true;
+}
+
+static bool evaluate(const RowCondition& condition, CellText text) {
+    switch (condition.op) {
+        case RowCondition::NonEmpty:
+            return !text.empty();
+        case RowCondition::Equals:
+        case RowCondition::In:
+            for (const auto& value : condition.values) {
+                if (matches(text, value)) return true;
+            }
+            return false;
+        case RowCondition::Range: {
+            int order = 0;
+            if (condition.hasMin && (!compare(text, condition.min, order) || order < 0)) return false;
+            if (condition.hasMax && (!compare(text, condition.max, order) || order > 0)) return false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool applyRowFilter(std::vector<SheetData>& sheets, const RowFilter& filter, std::string& outError) {
+    if (!filter.enabled() || sheets.empty()) return true;
+
+    SheetData* sheet = nullptr;
+    if (filter.sheetName.empty()) {
+        sheet = &sheets[0];
+    } else {
+        for (auto& candidate : sheets) {
+            if (candidate.name == filter.sheetName) {
+                sheet = &candidate;
+                break;
+            }
+        }
+    }
+    // A missing sheet or header row is reported by the table conversion, as without a filter
+    if (!sheet || filter.headerRow < 0 || sheet->data.size() <= static_cast<size_t>(filter.headerRow)) {
+        return true;
+    }
+
+    // Resolve names against the header row; like a JS object key, a repeated
+    // header refers to its last column
+    const SheetRow& header = sheet->data[filter.headerRow];
+    std::vector<size_t> columns;
+    columns.reserve(filter.conditions.size());
+    for (const auto& condition : filter.conditions) {
+        if (condition.columnIndex >= 0) {
+            columns.push_back(static_cast<size_t>(condition.columnIndex));
+            continue;
+        }
+        size_t found = header.size();
+        for (size_t col = 0; col < header.size(); ++col) {
+            std::string name(header[col]);
+            auto mapped = filter.headerMap.find(name);
+            if (name == condition.column ||
+                (mapped != filter.headerMap.end() && mapped->second == condition.column)) {
+                found = col;
+            }
+        }
+        if (found == header.size()) {
+            outError = "Filter column not found: " + condition.column;
+            return false;
+        }
+        columns.push_back(found);
+    }
+
+    // Compact in place; rows keep their arena storage, only the row vectors move
+    size_t kept = 0;
+    std::vector<uint32_t> rowIndex;
+    for (size_t row = 0; row < sheet->data.size(); ++row) {
+        bool pass = static_cast<int>(row) == filter.headerRow;
+        if (!pass) {
+            const SheetRow& cells = sheet->data[row];
+            pass = true;
+            for (size_t i = 0; pass && i < filter.conditions.size(); ++i) {
+                CellText text = columns[i] < cells.size() ? cells[columns[i]] : CellText();
+                pass = evaluate(filter.conditions[i], text);
+            }
+        }
+        if (!pass) continue;
+
+        if (kept != row) {
+            sheet->data[kept] = std::move(sheet->data[row]);
+        }
+        rowIndex.push_back(static_cast<uint32_t>(row));
+        kept++;
+    }
+
+    sheet->data.erase(sheet->data.begin() + kept, sheet->data.end());
+    sheet->rowIndex = std::move(rowIndex);
+    return true;
+}
+
+} // namespace baja_xlsx
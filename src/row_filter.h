@@ -0,0 +1,55 @@
+#ifndef ROW_FILTER_H
+#define ROW_FILTER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+// A literal in a filter condition; numbers compare numerically, strings as text
+struct FilterValue {
+    bool isNumber;
+    double number;
+    std::string text;
+
+    FilterValue() : isNumber(false), number(0) {}
+};
+
+// One condition on one column; a row passes the filter when all conditions hold
+struct RowCondition {
+    enum Op { Equals, In, Range, NonEmpty };
+
+    std::string column;                // header text, or its headerMap name
+    int columnIndex;                   // 0-based; >= 0 takes precedence over column
+    Op op;
+    std::vector<FilterValue> values;   // Equals: one value, In: the set
+    bool hasMin;
+    bool hasMax;
+    FilterValue min;                   // Range bounds, inclusive
+    FilterValue max;
+
+    RowCondition() : columnIndex(-1), op(NonEmpty), hasMin(false), hasMax(false) {}
+};
+
+// Row predicate evaluated natively, before any JS value is created for the sheet
+struct RowFilter {
+    std::vector<RowCondition> conditions;
+    std::string sheetName;                         // sheet the filter applies to; empty: first sheet
+    int headerRow;                                 // column names are resolved against this row
+    std::map<std::string, std::string> headerMap;  // names may also be the mapped header
+
+    RowFilter() : headerRow(0) {}
+
+    bool enabled() const { return !conditions.empty(); }
+};
+
+// Drop the rows of the filter's sheet that fail it. The header row is always kept and
+// the original index of every kept row is recorded in SheetData::rowIndex.
+// Fails when a named column is not in the header row.
+bool applyRowFilter(std::vector<SheetData>& sheets, const RowFilter& filter, std::string& outError);
+
+} // namespace baja_xlsx
+
+#endif // ROW_FILTER_H
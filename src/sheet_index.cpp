@@ -0,0 +1,267 @@
+#include "sheet_index.h"
+#include "ooxml_parts.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace baja_xlsx {
+
+namespace fs = std::filesystem;
+
+IndexedWorkbook::IndexedWorkbook() : indexedCells_(0), opened_(false) {
+}
+
+IndexedWorkbook::~IndexedWorkbook() {
+    close();
+}
+
+bool IndexedWorkbook::open(const std::string& xlsxPath, const ReadOptions& options) {
+    close();
+
+    // Page reads are synchronous and short; progress and cancellation do not apply
+    ReadOptions handleOptions = options;
+    handleOptions.control.reset();
+    limits_ = options.limits;
+
+    if (limits_.enabled()) {
+        ZipArchive archive;
+        if (!archive.open(xlsxPath)) {
+            lastError_ = archive.getLastError();
+            return false;
+        }
+        if (!checkArchiveLimits(archive, limits_, lastError_)) {
+            return false;
+        }
+    }
+
+    stringArena_ = std::make_unique<Arena>();
+    if (!reader_.open(xlsxPath, handleOptions, *stringArena_)) {
+        lastError_ = reader_.getLastError();
+        stringArena_.reset();
+        return false;
+    }
+
+    opened_ = true;
+    lastError_ = "";
+    return true;
+}
+
+void IndexedWorkbook::close() {
+    reader_.archive().close();
+    indexes_.clear();
+    indexedCells_ = 0;
+    stringArena_.reset();
+    removeSpool();
+    opened_ = false;
+}
+
+std::vector<std::string> IndexedWorkbook::sheetNames() const {
+    std::vector<std::string> names;
+    for (const auto& sheet : reader_.sheets()) {
+        names.push_back(sheet.name);
+    }
+    return names;
+}
+
+bool IndexedWorkbook::sheetSize(const std::string& sheetName, uint32_t& outRows, uint32_t& outColumns) {
+    std::string name;
+    const SheetIndex* index = indexFor(sheetName, name);
+    if (!index) return false;
+
+    outRows = index->maxRow;
+    outColumns = index->maxColumn;
+    return true;
+}
+
+bool IndexedWorkbook::readRows(const std::string& sheetName, uint32_t firstRow, uint32_t count,
+                               Arena& arena, SheetData& out) {
+    const SheetIndex* index = indexFor(sheetName, out.name);
+    if (!index) return false;
+
+    out.data = ArenaVector<SheetRow>(ArenaAllocator<SheetRow>(&arena));
+    out.rowIndex.clear();
+    if (firstRow >= index->maxRow || count == 0) {
+        return true;
+    }
+    uint32_t lastRow = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(firstRow) + count, index->maxRow));
+
+    // <row> elements for file rows firstRow + 1 .. lastRow
+    size_t lo = std::lower_bound(index->rowNumbers.begin(), index->rowNumbers.end(), firstRow + 1) - index->rowNumbers.begin();
+    size_t hi = std::lower_bound(index->rowNumbers.begin(), index->rowNumbers.end(), lastRow + 1) - index->rowNumbers.begin();
+
+    LeanWorkbookReader::RowChunk chunk;
+    std::string piece;
+    if (lo < hi) {
+        uint64_t begin = index->offsets[lo];
+        uint64_t end = hi < index->offsets.size() ? index->offsets[hi] : index->endOffset;
+
+        std::ifstream spool(index->spoolPath, std::ios::binary);
+        piece.resize(static_cast<size_t>(end - begin));
+        if (!spool || !spool.seekg(static_cast<std::streamoff>(begin)) ||
+            !spool.read(&piece[0], static_cast<std::streamsize>(piece.size()))) {
+            lastError_ = "Failed to read sheet index spool: " + index->spoolPath;
+            return false;
+        }
+
+        if (!reader_.parseRows(piece, arena, chunk)) {
+            lastError_ = reader_.getLastError();
+            return false;
+        }
+
+        // Rows before the first explicit row number count from the first row read
+        for (size_t i = 0; i < chunk.relativeCells; ++i) {
+            chunk.cells[i].row += index->rowNumbers[lo] - 1;
+        }
+    }
+
+    out.data.reserve(lastRow - firstRow);
+    for (uint32_t row = firstRow; row < lastRow; ++row) {
+        out.data.emplace_back(index->maxColumn, CellText(), ArenaAllocator<CellText>(&arena));
+    }
+    for (const auto& cell : chunk.cells) {
+        if (cell.row > firstRow && cell.row <= lastRow && cell.col >= 1 && cell.col <= index->maxColumn) {
+            out.data[cell.row - firstRow - 1][cell.col - 1] = cell.text;
+        }
+    }
+
+    lastError_ = "";
+    return true;
+}
+
+const IndexedWorkbook::SheetIndex* IndexedWorkbook::indexFor(const std::string& sheetName, std::string& outName) {
+    if (!opened_) {
+        lastError_ = "Workbook is closed";
+        return nullptr;
+    }
+
+    const auto& sheets = reader_.sheets();
+    const LeanWorkbookReader::SheetPart* sheet = nullptr;
+    if (sheetName.empty()) {
+        if (!sheets.empty()) sheet = &sheets[0];
+    } else {
+        for (const auto& candidate : sheets) {
+            if (candidate.name == sheetName) {
+                sheet = &candidate;
+                break;
+            }
+        }
+    }
+    if (!sheet) {
+        lastError_ = sheetName.empty() ? "Workbook has no sheets" : "Sheet not found: " + sheetName;
+        return nullptr;
+    }
+    outName = sheet->name;
+
+    auto it = indexes_.find(sheet->name);
+    if (it != indexes_.end()) {
+        return &it->second;
+    }
+
+    SheetIndex index;
+    if (!sheet->part.empty() && !buildIndex(sheet->name, sheet->part, index)) {
+        return nullptr;
+    }
+    return &indexes_.emplace(sheet->name, std::move(index)).first->second;
+}
+
+bool IndexedWorkbook::buildIndex(const std::string& sheetName, const std::string& part, SheetIndex& index) {
+    std::vector<uint8_t> data;
+    if (!reader_.archive().readEntry(part, data, limits_.maxEntrySize)) {
+        lastError_ = reader_.archive().getLastError();
+        return false;
+    }
+    std::string_view body = LeanWorkbookReader::sheetDataBody(
+        std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+
+    // One pass over the start tags: offset and number of every row, widest row
+    uint32_t currentRow = 0;
+    size_t tagEnd = 0;
+    size_t rowPos = findStartTag(body, "row", 0, tagEnd);
+    while (rowPos != std::string_view::npos) {
+        std::string r = getXmlAttribute(body.substr(rowPos, tagEnd - rowPos + 1), "r");
+        currentRow = r.empty() ? currentRow + 1 : static_cast<uint32_t>(std::strtoul(r.c_str(), nullptr, 10));
+        index.rowNumbers.push_back(currentRow);
+        index.offsets.push_back(rowPos);
+
+        size_t nextEnd = 0;
+        size_t nextRow = findStartTag(body, "row", tagEnd + 1, nextEnd);
+        std::string_view cells = body.substr(0, nextRow == std::string_view::npos ? body.size() : nextRow);
+
+        uint32_t col = 0;
+        bool hasCells = false;
+        size_t cellEnd = 0;
+        size_t cellPos = findStartTag(cells, "c", tagEnd + 1, cellEnd);
+        while (cellPos != std::string_view::npos) {
+            int refCol = 0;
+            int refRow = 0;
+            if (parseCellReference(getXmlAttribute(cells.substr(cellPos, cellEnd - cellPos + 1), "r"), refCol, refRow)) {
+                col = static_cast<uint32_t>(refCol);
+            } else {
+                col++;
+            }
+            hasCells = true;
+            cellPos = findStartTag(cells, "c", cellEnd + 1, cellEnd);
+        }
+        // Like the full read, the sheet ends at its last row holding a cell
+        if (hasCells) {
+            index.maxRow = std::max(index.maxRow, currentRow);
+            index.maxColumn = std::max(index.maxColumn, col);
+        }
+
+        rowPos = nextRow;
+        tagEnd = nextEnd;
+    }
+    index.endOffset = body.size();
+
+    // maxCells counts every sheet indexed through this handle, like a full read counts every sheet
+    uint64_t totalCells = indexedCells_;
+    if (!checkCellCount(sheetName, index.maxRow, index.maxColumn, totalCells, limits_, lastError_)) {
+        return false;
+    }
+
+    if (!ensureSpoolDir()) {
+        return false;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "sheet%zu.xml", indexes_.size() + 1);
+    index.spoolPath = (fs::path(spoolDir_) / name).string();
+
+    std::ofstream spool(index.spoolPath, std::ios::binary);
+    if (!spool.write(body.data(), static_cast<std::streamsize>(body.size()))) {
+        lastError_ = "Failed to write sheet index spool: " + index.spoolPath;
+        return false;
+    }
+    indexedCells_ = totalCells;
+    return true;
+}
+
+bool IndexedWorkbook::ensureSpoolDir() {
+    if (!spoolDir_.empty()) return true;
+
+    try {
+        std::random_device rd;
+        char suffix[17];
+        std::snprintf(suffix, sizeof(suffix), "%08x%08x", rd(), rd());
+
+        fs::path dir = fs::temp_directory_path() / (std::string("baja-xlsx-") + suffix);
+        fs::create_directories(dir);
+        spoolDir_ = dir.string();
+    } catch (const std::exception& e) {
+        lastError_ = std::string("Failed to create spool directory: ") + e.what();
+        return false;
+    }
+    return true;
+}
+
+void IndexedWorkbook::removeSpool() {
+    if (spoolDir_.empty()) return;
+
+    std::error_code ec;
+    fs::remove_all(spoolDir_, ec);
+    spoolDir_.clear();
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,71 @@
+#ifndef SHEET_INDEX_H
+#define SHEET_INDEX_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lean_workbook.h"
+
+namespace baja_xlsx {
+
+// Workbook handle for paging through large sheets. The first access to a sheet
+// inflates it once, spools its <sheetData> to a temporary file and records the
+// byte offset of every <row>. Later page reads seek straight to the rows they
+// need and parse only those, instead of rescanning the sheet from the top.
+class IndexedWorkbook {
+public:
+    IndexedWorkbook();
+    ~IndexedWorkbook();
+
+    IndexedWorkbook(const IndexedWorkbook&) = delete;
+    IndexedWorkbook& operator=(const IndexedWorkbook&) = delete;
+
+    // Load workbook metadata and shared strings (values-only; isoDates and limits apply)
+    bool open(const std::string& xlsxPath, const ReadOptions& options);
+
+    // Release the package, shared strings and spool files
+    void close();
+
+    std::vector<std::string> sheetNames() const;
+
+    // Highest row and column of a sheet (1-based counts); builds its index. Empty name: first sheet
+    bool sheetSize(const std::string& sheetName, uint32_t& outRows, uint32_t& outColumns);
+
+    // Rows [firstRow, firstRow + count) of a sheet, 0-based like readExcel's data and
+    // padded to the sheet's width; fewer rows when the range runs past the end.
+    // Cell text points into arena, or into the handle's shared strings.
+    bool readRows(const std::string& sheetName, uint32_t firstRow, uint32_t count,
+                  Arena& arena, SheetData& out);
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    struct SheetIndex {
+        std::string spoolPath;
+        std::vector<uint32_t> rowNumbers;   // 1-based row of each <row>, in document order
+        std::vector<uint64_t> offsets;      // its byte offset in the spool file
+        uint64_t endOffset = 0;
+        uint32_t maxRow = 0;
+        uint32_t maxColumn = 0;
+    };
+
+    // Index of a sheet, building it on first use; null on error
+    const SheetIndex* indexFor(const std::string& sheetName, std::string& outName);
+    bool buildIndex(const std::string& sheetName, const std::string& part, SheetIndex& index);
+    bool ensureSpoolDir();
+    void removeSpool();
+
+    std::unique_ptr<Arena> stringArena_;   // shared strings, alive as long as the handle
+    LeanWorkbookReader reader_;
+    std::map<std::string, SheetIndex> indexes_;
+    std::string spoolDir_;
+    ReadLimits limits_;
+    uint64_t indexedCells_;                // cells of the sheets indexed so far, for maxCells
+    bool opened_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // SHEET_INDEX_H
@@ -0,0 +1,360 @@
+#include "table_export.h"
+#include "anchor_index.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace baja_xlsx {
+
+static const size_t kFlushThreshold = 64 * 1024;
+
+static void appendBase64(std::string& out, const std::vector<uint8_t>& data) {
+    static const char* kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    size_t i = 0;
+    for (; i + 3 <= data.size(); i += 3) {
+        uint32_t n = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        out += kAlphabet[(n >> 18) & 63];
+        out += kAlphabet[(n >> 12) & 63];
+        out += kAlphabet[(n >> 6) & 63];
+        out += kAlphabet[n & 63];
+    }
+
+    size_t rest = data.size() - i;
+    if (rest > 0) {
+        uint32_t n = data[i] << 16;
+        if (rest == 2) n |= data[i + 1] << 8;
+        out += kAlphabet[(n >> 18) & 63];
+        out += kAlphabet[(n >> 12) & 63];
+        out += rest == 2 ? kAlphabet[(n >> 6) & 63] : '=';
+        out += '=';
+    }
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+TableExporter::TableExporter(const ExportOptions& options) : options_(options) {
+}
+
+bool TableExporter::exportToString(const ExcelData& data, std::string& out) {
+    size_t written = 0;
+    return run(data, out, -1, written);
+}
+
+bool TableExporter::exportToFd(const ExcelData& data, int fd, size_t& outBytesWritten) {
+    std::string buffer;
+    buffer.reserve(kFlushThreshold * 2);
+    outBytesWritten = 0;
+    return run(data, buffer, fd, outBytesWritten) && flush(buffer, fd, outBytesWritten);
+}
+
+bool TableExporter::flush(std::string& out, int fd, size_t& outBytesWritten) {
+    if (fd < 0) {
+        return true;
+    }
+
+    size_t offset = 0;
+    while (offset < out.size()) {
+#ifdef _WIN32
+        int n = _write(fd, out.data() + offset, static_cast<unsigned int>(out.size() - offset));
+#else
+        ssize_t n = ::write(fd, out.data() + offset, out.size() - offset);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            lastError_ = std::string("Failed to write export: ") + std::strerror(errno);
+            return false;
+        }
+        offset += static_cast<size_t>(n);
+    }
+
+    outBytesWritten += out.size();
+    out.clear();
+    return true;
+}
+
+void TableExporter::appendCsvField(std::string& out, std::string_view text) const {
+    bool needsQuotes = text.find_first_of("\"\r\n") != std::string_view::npos ||
+                       text.find(options_.delimiter) != std::string_view::npos;
+    if (!needsQuotes) {
+        out.append(text.data(), text.size());
+        return;
+    }
+
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+// CSV image cell: the image name, or a data: URI in base64 mode
+void TableExporter::appendImageText(std::string& out, const ImageData& image) const {
+    if (options_.images == ExportOptions::ImageBase64 && !image.known) {
+        out += "data:";
+        out += image.type;
+        out += ";base64,";
+        appendBase64(out, image.data);
+    } else {
+        out += image.name;
+    }
+}
+
+// NDJSON image cell: the fields of readTableAsJSON's image object; data is
+// base64 in base64 mode and omitted otherwise
+void TableExporter::appendImageJson(std::string& out, const ImageData& image) const {
+    out += "{\"name\":";
+    appendJsonString(out, image.name);
+    out += ",\"type\":";
+    appendJsonString(out, image.type);
+    out += ",\"width\":" + std::to_string(image.width);
+    out += ",\"height\":" + std::to_string(image.height);
+    out += ",\"hash\":";
+    appendJsonString(out, image.hash);
+    if (!image.sha256.empty()) {
+        out += ",\"sha256\":";
+        appendJsonString(out, image.sha256);
+    }
+    if (image.known) {
+        out += ",\"known\":true";
+    } else if (options_.images == ExportOptions::ImageBase64) {
+        out += ",\"data\":\"";
+        appendBase64(out, image.data);
+        out += '"';
+    }
+    out += '}';
+}
+
+bool TableExporter::run(const ExcelData& data, std::string& out, int fd, size_t& outBytesWritten) {
+    lastError_ = "";
+
+    // Select the sheet the same way readTableAsJSON does
+    const SheetData* sheet = nullptr;
+    if (!options_.sheetName.empty()) {
+        for (const auto& candidate : data.sheets) {
+            if (candidate.name == options_.sheetName) {
+                sheet = &candidate;
+                break;
+            }
+        }
+        if (!sheet) {
+            lastError_ = "未找到名为 \"" + options_.sheetName + "\" 的Sheet";
+            return false;
+        }
+    } else {
+        if (data.sheets.empty()) {
+            lastError_ = "Excel文件中没有Sheet";
+            return false;
+        }
+        sheet = &data.sheets[0];
+    }
+
+    // Row numbers in the options are file rows; a filtered sheet maps them through rowIndex
+    const auto& rows = sheet->data;
+    int headerPos = sheet->findRow(options_.headerRow);
+    if (headerPos < 0) {
+        lastError_ = "表头行索引 " + std::to_string(options_.headerRow) +
+                     " 超出数据范围（共 " + std::to_string(rows.size()) + " 行）";
+        return false;
+    }
+
+    // Columns as a JS object would hold them: empty headers dropped, a repeated
+    // key keeps its first position and takes the value of its last column
+    std::vector<Column> columns;
+    const SheetRow& headerCells = rows[headerPos];
+    for (size_t col = 0; col < headerCells.size(); ++col) {
+        std::string header(headerCells[col]);
+        if (header.find("__IMAGE_CELL__") == 0) {
+            header.clear();
+        }
+        auto mapped = options_.headerMap.find(header);
+        if (mapped != options_.headerMap.end() && !mapped->second.empty()) {
+            header = mapped->second;
+        }
+        if (header.empty()) continue;
+
+        bool seen = false;
+        for (auto& column : columns) {
+            if (column.key == header) {
+                column.source = col;
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            columns.push_back(Column{header, col});
+        }
+    }
+
+    // Image lookup tables, resolved the same way as the readExcel result
+    std::unordered_map<std::string, const ImageData*> imagesByName;
+    for (const auto& image : data.images) {
+        imagesByName.emplace(image.name, &image);
+    }
+
+    auto findImage = [&](const std::string& name) -> const ImageData* {
+        auto it = imagesByName.find(name);
+        if (it != imagesByName.end()) {
+            return it->second;
+        }
+        if (name.empty()) return nullptr;
+        for (const auto& image : data.images) {
+            if (!image.name.empty() &&
+                (image.name.find(name) != std::string::npos || name.find(image.name) != std::string::npos)) {
+                return &image;
+            }
+        }
+        return nullptr;
+    };
+
+    // Floating images attach to their top-left cell
+    std::map<std::pair<size_t, size_t>, std::vector<const ImageData*>> floatingImages;
+    for (const auto& pos : data.imagePositions) {
+        if (pos.sheetName != sheet->name) continue;
+        if (pos.fromRow == pos.toRow && pos.fromCol == pos.toCol) continue;
+        int row = sheet->findRow(pos.fromRow);
+        if (row < 0) continue;
+        if (pos.fromCol < 0 || pos.fromCol >= static_cast<int>(rows[row].size())) continue;
+
+        const ImageData* image = findImage(pos.imageName);
+        if (image) {
+            floatingImages[std::make_pair(static_cast<size_t>(row), static_cast<size_t>(pos.fromCol))].push_back(image);
+        }
+    }
+
+    AnchorIndex anchorIndex(data.imagePositions);
+    std::vector<const ImageData*> cellImages;
+    std::string_view cellText;
+
+    // Resolve one cell to either text or a list of images
+    auto resolveCell = [&](size_t row, size_t col) {
+        cellImages.clear();
+        cellText = std::string_view();
+
+        const SheetRow& cells = rows[row];
+        if (col >= cells.size()) return;
+
+        CellText value = cells[col];
+        if (value.find("__IMAGE_CELL__") == 0) {
+            std::string imageName;
+            if (value.find("__IMAGE_CELL__:") == 0) {
+                CellText imageId = value.substr(15);
+                for (const auto& mapping : data.cellImageMappings) {
+                    if (mapping.imageId == imageId) {
+                        imageName = mapping.imageName;
+                        break;
+                    }
+                }
+            } else {
+                long anchor = anchorIndex.findAt(sheet->name, static_cast<int>(sheet->originalRow(row)),
+                                                 static_cast<int>(col));
+                if (anchor >= 0) {
+                    imageName = data.imagePositions[anchor].imageName;
+                }
+            }
+            auto it = imagesByName.find(imageName);
+            if (!imageName.empty() && it != imagesByName.end()) {
+                cellImages.push_back(it->second);
+            }
+        } else {
+            cellText = value;
+        }
+
+        auto floating = floatingImages.find(std::make_pair(row, col));
+        if (floating != floatingImages.end()) {
+            cellImages.insert(cellImages.end(), floating->second.begin(), floating->second.end());
+        }
+    };
+
+    if (options_.format == ExportOptions::CSV && options_.includeHeader) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) out += options_.delimiter;
+            appendCsvField(out, columns[i].key);
+        }
+        out += '\n';
+    }
+
+    std::string imageText;
+    for (size_t row = 0; row < rows.size(); ++row) {
+        int rowIndex = static_cast<int>(sheet->originalRow(row));
+        if (rowIndex == options_.headerRow || options_.skipRows.count(rowIndex)) {
+            continue;
+        }
+
+        if (options_.format == ExportOptions::CSV) {
+            for (size_t i = 0; i < columns.size(); ++i) {
+                if (i > 0) out += options_.delimiter;
+                resolveCell(row, columns[i].source);
+                if (cellImages.empty()) {
+                    appendCsvField(out, cellText);
+                    continue;
+                }
+                // Several images in one cell are separated by spaces
+                imageText.clear();
+                for (size_t k = 0; k < cellImages.size(); ++k) {
+                    if (k > 0) imageText += ' ';
+                    appendImageText(imageText, *cellImages[k]);
+                }
+                appendCsvField(out, imageText);
+            }
+        } else {
+            out += '{';
+            for (size_t i = 0; i < columns.size(); ++i) {
+                if (i > 0) out += ',';
+                appendJsonString(out, columns[i].key);
+                out += ':';
+                resolveCell(row, columns[i].source);
+                if (cellImages.empty()) {
+                    appendJsonString(out, cellText);
+                } else if (cellImages.size() == 1) {
+                    appendImageJson(out, *cellImages[0]);
+                } else {
+                    out += '[';
+                    for (size_t k = 0; k < cellImages.size(); ++k) {
+                        if (k > 0) out += ',';
+                        appendImageJson(out, *cellImages[k]);
+                    }
+                    out += ']';
+                }
+            }
+            out += '}';
+        }
+        out += '\n';
+
+        if (fd >= 0 && out.size() >= kFlushThreshold && !flush(out, fd, outBytesWritten)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace baja_xlsx
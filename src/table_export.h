@@ -0,0 +1,66 @@
+#ifndef TABLE_EXPORT_H
+#define TABLE_EXPORT_H
+
+#include <map>
+#include <set>
+#include <string>
+#include "xlsx_reader.h"
+
+namespace baja_xlsx {
+
+// Append text as a quoted JSON string
+void appendJsonString(std::string& out, std::string_view text);
+
+// Table options shared with readTableAsJSON, plus output format settings
+struct ExportOptions {
+    enum Format { CSV, NDJSON };
+    enum ImageMode { ImageRef, ImageBase64 };
+
+    Format format;
+    std::string sheetName;                         // empty: first sheet
+    int headerRow;
+    std::set<int> skipRows;
+    std::map<std::string, std::string> headerMap;
+    ImageMode images;
+    char delimiter;                                // CSV only
+    bool includeHeader;                            // CSV only
+
+    ExportOptions()
+        : format(CSV), headerRow(0), images(ImageRef), delimiter(','), includeHeader(true) {}
+};
+
+// Serializes one sheet of an ExcelData as CSV or NDJSON with the same row and
+// column selection as readTableAsJSON, without building any JS objects.
+// Output goes either to a string or, in 64 KB chunks, to a file descriptor.
+class TableExporter {
+public:
+    explicit TableExporter(const ExportOptions& options);
+
+    // Append the export to out
+    bool exportToString(const ExcelData& data, std::string& out);
+
+    // Write the export to fd; outBytesWritten is the total written
+    bool exportToFd(const ExcelData& data, int fd, size_t& outBytesWritten);
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    struct Column {
+        std::string key;    // mapped header
+        size_t source;      // column index the value is taken from
+    };
+
+    bool run(const ExcelData& data, std::string& out, int fd, size_t& outBytesWritten);
+    bool flush(std::string& out, int fd, size_t& outBytesWritten);
+
+    void appendCsvField(std::string& out, std::string_view text) const;
+    void appendImageText(std::string& out, const ImageData& image) const;
+    void appendImageJson(std::string& out, const ImageData& image) const;
+
+    ExportOptions options_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // TABLE_EXPORT_H
@@ -0,0 +1,166 @@
+#include "workbook_probe.h"
+#include "ooxml_parts.h"
+#include "zip_archive.h"
+#include <map>
+
+namespace baja_xlsx {
+
+// Worksheet headers (sheetPr, dimension, sheetViews, sheetFormatPr, cols) are tiny;
+// never inflate more than this while looking for <dimension>
+static const size_t kSheetHeadLimit = 256 * 1024;
+
+// workbook.xml and relationship parts are metadata; anything bigger is not a sane package
+static const uint64_t kMetadataPartLimit = 16 * 1024 * 1024;
+
+static std::string readPartAsString(ZipArchive& archive, const std::string& partName) {
+    std::vector<uint8_t> data;
+    if (!archive.readEntry(partName, data, kMetadataPartLimit)) {
+        return "";
+    }
+    return std::string(data.begin(), data.end());
+}
+
+static int countOccurrences(const std::string& text, const std::string& needle) {
+    int count = 0;
+    size_t pos = 0;
+    while ((pos = text.find(needle, pos)) != std::string::npos) {
+        count++;
+        pos += needle.size();
+    }
+    return count;
+}
+
+WorkbookProbe::WorkbookProbe() {
+}
+
+WorkbookProbe::~WorkbookProbe() {
+}
+
+bool WorkbookProbe::probe(const std::string& xlsxPath, WorkbookProbeResult& outResult) {
+    ZipArchive archive;
+    if (!archive.open(xlsxPath)) {
+        lastError_ = archive.getLastError();
+        return false;
+    }
+
+    outResult.sheets.clear();
+    outResult.imageCount = 0;
+    outResult.cellImageCount = 0;
+    outResult.compressedSize = 0;
+    outResult.uncompressedSize = 0;
+    outResult.mediaSize = 0;
+    outResult.entryCount = archive.entryCount();
+
+    // ZIP central directory: sizes only, nothing is inflated here
+    std::map<std::string, ZipEntryInfo> entries;
+    for (int64_t i = 0; i < outResult.entryCount; i++) {
+        ZipEntryInfo info;
+        if (!archive.entryInfo(i, info)) continue;
+
+        outResult.compressedSize += info.compressedSize;
+        outResult.uncompressedSize += info.uncompressedSize;
+
+        if (info.name.find("xl/media/") == 0) {
+            outResult.imageCount++;
+            outResult.mediaSize += info.uncompressedSize;
+        }
+
+        entries[info.name] = info;
+    }
+
+    // Locate the workbook part through the package relationships
+    std::string workbookPart = "xl/workbook.xml";
+    for (const auto& rel : parseRelationshipList(readPartAsString(archive, "_rels/.rels"))) {
+        if (relationshipTypeIs(rel.type, "officeDocument")) {
+            workbookPart = resolvePartTarget("", rel.target);
+            break;
+        }
+    }
+
+    std::string workbookXml = readPartAsString(archive, workbookPart);
+    if (workbookXml.empty()) {
+        lastError_ = "Workbook part not found: " + workbookPart;
+        return false;
+    }
+
+    std::map<std::string, std::string> workbookTargets;
+    for (const auto& rel : parseRelationshipList(readPartAsString(archive, relationshipsPartFor(workbookPart)))) {
+        workbookTargets[rel.id] = resolvePartTarget(workbookPart, rel.target);
+    }
+
+    for (const auto& entry : parseWorkbookSheets(workbookXml)) {
+        SheetProbe sheet;
+        sheet.name = entry.name;
+        sheet.state = entry.state;
+        sheet.rowCount = 0;
+        sheet.columnCount = 0;
+        sheet.imageCount = 0;
+        sheet.compressedSize = 0;
+        sheet.uncompressedSize = 0;
+
+        auto targetIt = workbookTargets.find(entry.relId);
+        if (targetIt == workbookTargets.end()) {
+            outResult.sheets.push_back(sheet);
+            continue;
+        }
+        const std::string& sheetPart = targetIt->second;
+
+        auto entryIt = entries.find(sheetPart);
+        if (entryIt != entries.end()) {
+            sheet.compressedSize = entryIt->second.compressedSize;
+            sheet.uncompressedSize = entryIt->second.uncompressedSize;
+        }
+
+        // Inflate only up to <sheetData>; <dimension> is required to precede it
+        std::string head;
+        if (archive.readEntryHead(sheetPart, "sheetData", kSheetHeadLimit, head)) {
+            size_t tagEnd = 0;
+            size_t tagPos = findStartTag(head, "dimension", 0, tagEnd);
+            size_t sheetDataPos = head.find("sheetData");
+            if (tagPos != std::string::npos && (sheetDataPos == std::string::npos || tagPos < sheetDataPos)) {
+                sheet.dimension = getXmlAttribute(std::string_view(head).substr(tagPos, tagEnd - tagPos + 1), "ref");
+
+                // "A1:D120" -> 4 columns, 120 rows; "C5:F9" -> 4 columns, 5 rows;
+                // a single reference like "A1" covers one cell
+                std::string firstRef = sheet.dimension;
+                std::string lastRef = sheet.dimension;
+                size_t colon = firstRef.find(':');
+                if (colon != std::string::npos) {
+                    lastRef = firstRef.substr(colon + 1);
+                    firstRef.resize(colon);
+                }
+                int firstCol = 0;
+                int firstRow = 0;
+                int lastCol = 0;
+                int lastRow = 0;
+                if (parseCellReference(firstRef, firstCol, firstRow) &&
+                    parseCellReference(lastRef, lastCol, lastRow) &&
+                    lastCol >= firstCol && lastRow >= firstRow) {
+                    sheet.columnCount = lastCol - firstCol + 1;
+                    sheet.rowCount = lastRow - firstRow + 1;
+                }
+            }
+        }
+
+        // Count pictures through sheet -> drawing relationships
+        std::string sheetRels = readPartAsString(archive, relationshipsPartFor(sheetPart));
+        for (const auto& rel : parseRelationshipList(sheetRels)) {
+            if (!relationshipTypeIs(rel.type, "drawing")) continue;
+
+            std::string drawingXml = readPartAsString(archive, resolvePartTarget(sheetPart, rel.target));
+            sheet.imageCount += countOccurrences(drawingXml, "r:embed=\"");
+        }
+
+        outResult.sheets.push_back(sheet);
+    }
+
+    // WPS Excel embedded cell images
+    if (entries.count("xl/cellimages.xml")) {
+        outResult.cellImageCount = countOccurrences(readPartAsString(archive, "xl/cellimages.xml"), "<etc:cellImage>");
+    }
+
+    lastError_ = "";
+    return true;
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,48 @@
+#ifndef WORKBOOK_PROBE_H
+#define WORKBOOK_PROBE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace baja_xlsx {
+
+struct SheetProbe {
+    std::string name;
+    std::string state;            // "visible", "hidden" or "veryHidden"
+    std::string dimension;        // <dimension ref>, e.g. "A1:D120" (empty if not declared)
+    int rowCount;                 // rows the dimension spans (last - first + 1), 0 if unknown
+    int columnCount;              // columns the dimension spans, 0 if unknown
+    int imageCount;               // pictures in the sheet's drawing parts
+    uint64_t compressedSize;      // worksheet part size inside the ZIP
+    uint64_t uncompressedSize;    // worksheet part size once inflated
+};
+
+struct WorkbookProbeResult {
+    std::vector<SheetProbe> sheets;
+    int imageCount;               // entries under xl/media/
+    int cellImageCount;           // WPS Excel cell images (xl/cellimages.xml)
+    int64_t entryCount;
+    uint64_t compressedSize;      // sum over all ZIP entries
+    uint64_t uncompressedSize;    // sum over all ZIP entries, as declared by the archive
+    uint64_t mediaSize;           // uncompressed size of xl/media/*
+};
+
+// Reads workbook metadata without loading any cell data: the ZIP central directory,
+// xl/workbook.xml, relationship parts, and each worksheet up to <sheetData>.
+class WorkbookProbe {
+public:
+    WorkbookProbe();
+    ~WorkbookProbe();
+
+    bool probe(const std::string& xlsxPath, WorkbookProbeResult& outResult);
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // WORKBOOK_PROBE_H
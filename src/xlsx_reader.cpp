@@ -1,11 +1,21 @@
 #include "xlsx_reader.h"
 #include "image_extractor.h"
+#include "lean_workbook.h"
+#include "cell_format.h"
+#include "row_filter.h"
+#include "parse_cache.h"
+#include "read_scheduler.h"
+#include "zip_archive.h"
 #include <algorithm>
 #include <sstream>
 
 namespace baja_xlsx {
 
-XlsxReader::XlsxReader() : loaded_(false) {
+// Rows converted between two progress updates / cancellation checks
+static const uint64_t kRowReportInterval = 256;
+
+XlsxReader::XlsxReader()
+    : loaded_(false), control_(nullptr), isoDates_(false), date1904_(false), schemaRows_(0), schemaStartRow_(0) {
 }
 
 XlsxReader::~XlsxReader() {
@@ -13,12 +23,26 @@ XlsxReader::~XlsxReader() {
 
 bool XlsxReader::load(const std::string& filepath) {
     try {
-        workbook_.load(filepath);
+        if (control_) {
+            // Load through a buffer that reports bytes and stops on cancel
+            ControlledFileBuf buffer(control_);
+            if (!buffer.open(filepath, std::ios::in | std::ios::binary)) {
+                lastError_ = "Failed to load file: cannot open " + filepath;
+                loaded_ = false;
+                return false;
+            }
+            std::istream stream(&buffer);
+            workbook_.load(stream);
+        } else {
+            workbook_.load(filepath);
+        }
         loaded_ = true;
         lastError_ = "";
         return true;
     } catch (const std::exception& e) {
-        lastError_ = std::string("Failed to load file: ") + e.what();
+        lastError_ = (control_ && control_->cancelled())
+            ? std::string(kReadAbortedError)
+            : std::string("Failed to load file: ") + e.what();
         loaded_ = false;
         return false;
     }
@@ -29,7 +53,10 @@ std::string XlsxReader::cellToString(const xlnt::cell& cell) {
         try {
             switch (cell.data_type()) {
                 case xlnt::cell_type::number:
-                    return std::to_string(cell.value<double>());
+                    if (isoDates_ && cell.is_date()) {
+                        return serialToIsoDate(cell.value<double>(), date1904_);
+                    }
+                    return formatNumber(cell.value<double>());
                 case xlnt::cell_type::boolean:
                     return cell.value<bool>() ? "true" : "false";
                 case xlnt::cell_type::shared_string:
@@ -71,7 +98,53 @@ std::string XlsxReader::cellToString(const xlnt::cell& cell) {
     return "";
 }
 
-std::vector<SheetData> XlsxReader::readSheetData() {
+ColumnType XlsxReader::cellColumnType(const xlnt::cell& cell) {
+    try {
+        switch (cell.data_type()) {
+            case xlnt::cell_type::number:
+                return isoDates_ && cell.is_date() ? ColumnType::Date : ColumnType::Number;
+            case xlnt::cell_type::boolean:
+                return ColumnType::Boolean;
+            case xlnt::cell_type::formula_string:
+                return ColumnType::Formula;
+            case xlnt::cell_type::date:
+                return ColumnType::Date;
+            default:
+                return ColumnType::String;
+        }
+    } catch (...) {
+        return ColumnType::Mixed;
+    }
+}
+
+bool XlsxReader::decodeColumnCell(const xlnt::cell& cell, ColumnType decoder, Arena& arena, CellText& outText) {
+    try {
+        xlnt::cell_type type = cell.data_type();
+        switch (decoder) {
+            case ColumnType::Number: {
+                // Only chosen without ISO dates, so no date format lookup
+                if (type != xlnt::cell_type::number) return false;
+                char buffer[kMaxNumberChars];
+                outText = arena.copyString(std::string_view(buffer, formatNumber(cell.value<double>(), buffer)));
+                return true;
+            }
+            case ColumnType::String:
+                if (type != xlnt::cell_type::shared_string && type != xlnt::cell_type::inline_string) return false;
+                outText = arena.copyString(cell.to_string());
+                return true;
+            case ColumnType::Boolean:
+                if (type != xlnt::cell_type::boolean) return false;
+                outText = cell.value<bool>() ? CellText("true") : CellText("false");
+                return true;
+            default:
+                return false;
+        }
+    } catch (...) {
+        return false;
+    }
+}
+
+std::vector<SheetData> XlsxReader::readSheetData(Arena& arena) {
     std::vector<SheetData> sheets;
     
     if (!loaded_) {
@@ -80,14 +153,27 @@ std::vector<SheetData> XlsxReader::readSheetData() {
     }
     
     try {
+        uint64_t totalCells = 0;
+        if (control_) {
+            int sheetCount = 0;
+            for (auto ws : workbook_) {
+                (void)ws;
+                sheetCount++;
+            }
+            control_->setSheetCount(sheetCount);
+            control_->setPhase(ReadProgress::Sheets);
+        }
+        
         for (auto ws : workbook_) {
             SheetData sheetData;
             sheetData.name = ws.title();
+            sheetData.data = ArenaVector<SheetRow>(ArenaAllocator<SheetRow>(&arena));
             
             // Check if sheet has any cells
             if (!ws.has_cell(xlnt::cell_reference("A1"))) {
                 // Empty sheet
-                sheets.push_back(sheetData);
+                sheets.push_back(std::move(sheetData));
+                if (control_) control_->sheetDone();
                 continue;
             }
             
@@ -95,22 +181,89 @@ std::vector<SheetData> XlsxReader::readSheetData() {
             auto maxRow = ws.highest_row();
             auto maxCol = ws.highest_column();
             
+            // A single far-away cell makes the dense grid huge; refuse before allocating it
+            if (!checkCellCount(sheetData.name, maxRow, maxCol.index, totalCells, limits_, lastError_)) {
+                sheets.clear();
+                return sheets;
+            }
+            sheetData.data.reserve(maxRow);
+            
+            // Sample rows [schemaStartRow_, schemaStartRow_ + schemaRows_) first (the
+            // rule is documented on ColumnSchema): numbers (unless dates must be told
+            // apart), strings and booleans get a decoder, everything else stays generic (Mixed)
+            std::vector<ColumnType> decoders;
+            if (schemaRows_ > 0) {
+                sheetData.columns.resize(maxCol.index);
+                const xlnt::row_t sampleEnd = static_cast<xlnt::row_t>(
+                    std::min<size_t>(schemaStartRow_ + schemaRows_, maxRow));
+                for (xlnt::row_t row = static_cast<xlnt::row_t>(schemaStartRow_) + 1; row <= sampleEnd; ++row) {
+                    for (xlnt::column_t::index_t col = 1; col <= maxCol.index; ++col) {
+                        try {
+                            auto cell = ws.cell(xlnt::column_t(col), row);
+                            if (cell.has_value()) {
+                                sheetData.columns[col - 1].observe(cellColumnType(cell));
+                            }
+                        } catch (...) {
+                            // Cell doesn't exist or error accessing it
+                        }
+                    }
+                }
+                decoders.resize(maxCol.index, ColumnType::Mixed);
+                for (size_t c = 0; c < decoders.size(); ++c) {
+                    ColumnType type = sheetData.columns[c].type;
+                    if ((type == ColumnType::Number && !isoDates_) ||
+                        type == ColumnType::String || type == ColumnType::Boolean) {
+                        decoders[c] = type;
+                    }
+                }
+            }
+            
             // Start from row 1, column 1 (Excel is 1-based)
             for (xlnt::row_t row = 1; row <= maxRow; ++row) {
-                std::vector<std::string> rowData;
+                if (control_ && row % kRowReportInterval == 0) {
+                    if (control_->cancelled()) {
+                        lastError_ = kReadAbortedError;
+                        sheets.clear();
+                        return sheets;
+                    }
+                    control_->addRows(kRowReportInterval);
+                }
+                
+                SheetRow rowData{ArenaAllocator<CellText>(&arena)};
+                rowData.reserve(maxCol.index);
                 for (xlnt::column_t::index_t col = 1; col <= maxCol.index; ++col) {
                     try {
                         auto cell = ws.cell(xlnt::column_t(col), row);
-                        rowData.push_back(cellToString(cell));
+                        if (!decoders.empty() && decoders[col - 1] != ColumnType::Mixed && cell.has_value()) {
+                            CellText text;
+                            if (decodeColumnCell(cell, decoders[col - 1], arena, text)) {
+                                rowData.push_back(text);
+                                continue;
+                            }
+                            // Rows above the sample (the header) are expected not to fit
+                            if (row > schemaStartRow_) {
+                                sheetData.columns[col - 1].fallbacks++;
+                            }
+                        }
+                        rowData.push_back(arena.copyString(cellToString(cell)));
                     } catch (...) {
                         // Cell doesn't exist or error accessing it
-                        rowData.push_back("");
+                        rowData.push_back(CellText());
                     }
                 }
-                sheetData.data.push_back(rowData);
+                sheetData.data.push_back(std::move(rowData));
+            }
+            
+            // One entry per grid column, the same width every row was padded to
+            if (schemaRows_ > 0) {
+                sheetData.columns.resize(sheetData.width());
             }
             
-            sheets.push_back(sheetData);
+            sheets.push_back(std::move(sheetData));
+            if (control_) {
+                control_->addRows(maxRow % kRowReportInterval);
+                control_->sheetDone();
+            }
         }
     } catch (const std::exception& e) {
         lastError_ = std::string("Failed to read sheet data: ") + e.what();
@@ -119,28 +272,6 @@ std::vector<SheetData> XlsxReader::readSheetData() {
     return sheets;
 }
 
-std::string XlsxReader::getImageType(const std::string& filename) {
-    std::string lower_filename = filename;
-    std::transform(lower_filename.begin(), lower_filename.end(), 
-                   lower_filename.begin(), ::tolower);
-    
-    if (lower_filename.find(".png") != std::string::npos) {
-        return "image/png";
-    } else if (lower_filename.find(".jpg") != std::string::npos || 
-               lower_filename.find(".jpeg") != std::string::npos) {
-        return "image/jpeg";
-    } else if (lower_filename.find(".gif") != std::string::npos) {
-        return "image/gif";
-    } else if (lower_filename.find(".bmp") != std::string::npos) {
-        return "image/bmp";
-    } else if (lower_filename.find(".emf") != std::string::npos) {
-        return "image/x-emf";
-    } else if (lower_filename.find(".wmf") != std::string::npos) {
-        return "image/x-wmf";
-    }
-    return "application/octet-stream";
-}
-
 std::vector<ImageData> XlsxReader::extractImages() {
     std::vector<ImageData> images;
     
@@ -170,54 +301,183 @@ std::vector<ImagePosition> XlsxReader::getImagePositions() {
     return positions;
 }
 
-ExcelData XlsxReader::readExcel(const std::string& filepath) {
-    ExcelData data;
-    
-    try {
+bool XlsxReader::parseWorkbook(const std::string& filepath, const ReadOptions& options, ExcelData& data) {
+    // Everything the sheets allocate is released with the arena
+    data.arena = std::make_shared<Arena>();
+    if (options.valuesOnly) {
+        // Values only: parse shared strings and sheet XML directly, no xlnt model
+        LeanWorkbookReader lean;
+        if (!lean.read(filepath, options, *data.arena, data.sheets)) {
+            lastError_ = lean.getLastError();
+            return false;
+        }
+    } else {
         if (!load(filepath)) {
-            return data;
+            return false;
         }
         
         // Read sheet data using xlnt
-        data.sheets = readSheetData();
+        isoDates_ = options.isoDates;
+        schemaRows_ = options.schemaRows;
+        schemaStartRow_ = options.schemaStartRow;
+        date1904_ = workbook_.base_date() == xlnt::calendar::mac_1904;
+        data.sheets = readSheetData(*data.arena);
+        if (!lastError_.empty()) {
+            return false;
+        }
+    }
+    
+    // Extract images using ImageExtractor (direct ZIP parsing)
+    ImageExtractor extractor;
+    extractor.setComputeSha256(options.computeSha256);
+    extractor.setLimits(limits_);
+    extractor.setControl(control_);
+    if (control_) control_->setPhase(ReadProgress::Images);
+    std::vector<ImageInfo> imageInfos;
+    std::vector<DrawingAnchor> anchors;
+    
+    if (extractor.extractFromXlsx(filepath, imageInfos, anchors)) {
+        // Convert ImageInfo to ImageData (media bytes are moved, not copied)
+        data.images.reserve(imageInfos.size());
+        for (auto& info : imageInfos) {
+            ImageData img;
+            img.name = std::move(info.filename);
+            img.data = std::move(info.data);
+            img.type = std::move(info.contentType);
+            img.width = info.width;
+            img.height = info.height;
+            img.hash = std::move(info.hash);
+            img.sha256 = std::move(info.sha256);
+            img.known = false;
+            data.images.push_back(std::move(img));
+        }
+        
+        // Convert DrawingAnchor to ImagePosition
+        for (const auto& anchor : anchors) {
+            ImagePosition pos;
+            pos.imageName = anchor.imageName;
+            pos.sheetName = anchor.sheetName;
+            pos.fromCol = anchor.fromCol;
+            pos.fromRow = anchor.fromRow;
+            pos.toCol = anchor.toCol;
+            pos.toRow = anchor.toRow;
+            pos.fromColOff = anchor.fromColOff;
+            pos.fromRowOff = anchor.fromRowOff;
+            pos.toColOff = anchor.toColOff;
+            pos.toRowOff = anchor.toRowOff;
+            data.imagePositions.push_back(pos);
+        }
+        
+        // Convert CellImageInfo to CellImageMapping (WPS Excel)
+        const auto& cellImages = extractor.getCellImageMappings();
+        for (const auto& cellImg : cellImages) {
+            CellImageMapping mapping;
+            mapping.imageId = cellImg.imageId;
+            mapping.imageName = cellImg.imageName;
+            data.cellImageMappings.push_back(mapping);
+        }
+        
+        if (control_) control_->flush();
+    } else {
+        lastError_ = extractor.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool XlsxReader::checkLoadedLimits(const ExcelData& data) {
+    // A cached snapshot skips the parse that enforces these as it goes; the
+    // archive-wide sizes were already checked from the central directory
+    uint64_t totalCells = 0;
+    for (const auto& sheet : data.sheets) {
+        if (!checkCellCount(sheet.name, sheet.data.size(), sheet.width(), totalCells, limits_, lastError_)) {
+            return false;
+        }
+    }
+    if (!checkImageCount(data.images.size(), limits_, lastError_)) {
+        return false;
+    }
+    for (const auto& img : data.images) {
+        if (!checkEntrySize("xl/media/" + img.name, img.data.size(), limits_, lastError_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ExcelData XlsxReader::readExcel(const std::string& filepath, const ReadOptions& options) {
+    ExcelData data;
+    
+    try {
+        // Reject oversized or bomb-like packages from the central directory alone,
+        // before xlnt inflates anything
+        limits_ = options.limits;
+        control_ = options.control.get();
+        ReadScheduler& scheduler = ReadScheduler::instance();
+        uint64_t uncompressedBytes = 0;
+        if (limits_.enabled() || scheduler.limits().memoryBudget) {
+            ZipArchive archive;
+            if (!archive.open(filepath)) {
+                lastError_ = archive.getLastError();
+                return data;
+            }
+            if (limits_.enabled() && !checkArchiveLimits(archive, limits_, lastError_)) {
+                return data;
+            }
+            ZipEntryInfo info;
+            for (int64_t i = 0; i < archive.entryCount(); ++i) {
+                if (archive.entryInfo(i, info)) uncompressedBytes += info.uncompressedSize;
+            }
+        }
         
-        // Extract images using ImageExtractor (direct ZIP parsing)
-        ImageExtractor extractor;
-        std::vector<ImageInfo> imageInfos;
-        std::vector<DrawingAnchor> anchors;
+        // Wait for the process-wide read budget; held until this read returns
+        ScheduledRead slot;
+        if (!slot.acquire(ReadScheduler::estimateReadBytes(uncompressedBytes, options.valuesOnly), control_)) {
+            lastError_ = kReadAbortedError;
+            return data;
+        }
         
-        if (extractor.extractFromXlsx(filepath, imageInfos, anchors)) {
-            // Convert ImageInfo to ImageData
-            for (const auto& info : imageInfos) {
-                ImageData img;
-                img.name = info.filename;
-                img.data = info.data;
-                img.type = info.contentType;
-                data.images.push_back(img);
+        // Repeat reads of the same file load the cached snapshot instead of parsing
+        std::unique_ptr<ParseCache> cache;
+        std::string cacheKey;
+        if (!options.cacheDir.empty()) {
+            cache = std::make_unique<ParseCache>(options.cacheDir);
+            if (!cache->computeKey(filepath, options, cacheKey)) {
+                cache.reset();
             }
-            
-            // Convert DrawingAnchor to ImagePosition
-            for (const auto& anchor : anchors) {
-                ImagePosition pos;
-                pos.imageName = anchor.imageName;
-                pos.sheetName = anchor.sheetName;
-                pos.fromCol = anchor.fromCol;
-                pos.fromRow = anchor.fromRow;
-                pos.toCol = anchor.toCol;
-                pos.toRow = anchor.toRow;
-                data.imagePositions.push_back(pos);
+        }
+        
+        if (cache && cache->load(cacheKey, data)) {
+            if (!checkLoadedLimits(data)) {
+                return data;
             }
-            
-            // Convert CellImageInfo to CellImageMapping (WPS Excel)
-            const auto& cellImages = extractor.getCellImageMappings();
-            for (const auto& cellImg : cellImages) {
-                CellImageMapping mapping;
-                mapping.imageId = cellImg.imageId;
-                mapping.imageName = cellImg.imageName;
-                data.cellImageMappings.push_back(mapping);
+            if (control_) {
+                control_->setSheetCount(static_cast<int>(data.sheets.size()));
+                for (size_t i = 0; i < data.sheets.size(); ++i) control_->sheetDone();
+                control_->flush();
             }
         } else {
-            lastError_ = extractor.getLastError();
+            if (!parseWorkbook(filepath, options, data)) {
+                return data;
+            }
+            // Best effort: a cache that cannot be written only costs the next read a parse
+            if (cache) {
+                cache->store(cacheKey, data);
+            }
+        }
+        
+        // Drop filtered-out rows before anything is converted to JS
+        if (options.filter && !applyRowFilter(data.sheets, *options.filter, lastError_)) {
+            return data;
+        }
+        
+        // Payloads the caller already has are not handed back
+        for (auto& img : data.images) {
+            img.known = options.knownHashes.count(img.hash) > 0;
+            if (img.known) {
+                std::vector<uint8_t>().swap(img.data);
+            }
+            data.imageBytes.add(static_cast<int64_t>(img.data.size()));
         }
     } catch (const std::exception& e) {
         lastError_ = std::string("Exception in readExcel: ") + e.what();
@@ -1,17 +1,33 @@
 #ifndef XLSX_READER_H
 #define XLSX_READER_H
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <memory>
+#include <set>
+#include <utility>
 #include <xlnt/xlnt.hpp>
+#include "arena.h"
+#include "read_limits.h"
+#include "read_control.h"
+#include "native_memory.h"
+#include "column_schema.h"
 
 namespace baja_xlsx {
 
 struct ImageData {
     std::string name;
     std::vector<uint8_t> data;
-    std::string type;
+    std::string type;     // MIME type sniffed from header bytes
+    int width;            // pixels, 0 if unknown
+    int height;
+    std::string hash;     // XXH64 hex digest of the bytes
+    std::string sha256;   // SHA-256 hex digest, only when requested
+    bool known;           // hash was in ReadOptions::knownHashes; data was dropped
 };
 
 struct ImagePosition {
@@ -21,6 +37,10 @@ struct ImagePosition {
     int fromRow;
     int toCol;
     int toRow;
+    int64_t fromColOff;    // offsets into the from/to cells, in EMU
+    int64_t fromRowOff;
+    int64_t toColOff;
+    int64_t toRowOff;
 };
 
 // WPS Excel embedded image ID to filename mapping
@@ -29,16 +49,87 @@ struct CellImageMapping {
     std::string imageName;    // e.g., "image1.png"
 };
 
+// Cell text and row storage live in the per-read Arena owned by ExcelData
+using CellText = std::string_view;
+using SheetRow = ArenaVector<CellText>;
+
 struct SheetData {
     std::string name;
-    std::vector<std::vector<std::string>> data;
+    ArenaVector<SheetRow> data;
+    std::vector<uint32_t> rowIndex;   // original row of each entry in data; empty when no rows were filtered out
+    std::vector<ColumnSchema> columns; // inferred column types; empty unless ReadOptions::schemaRows is set
+    
+    // Columns of the padded grid: every row of data has this many cells
+    size_t width() const {
+        return data.empty() ? 0 : data.front().size();
+    }
+    
+    // Original (file) row of data[i]
+    size_t originalRow(size_t i) const {
+        return rowIndex.empty() ? i : rowIndex[i];
+    }
+    
+    // Position in data of an original row, or -1 when that row was filtered out
+    int findRow(int originalRow) const {
+        if (rowIndex.empty()) {
+            return originalRow >= 0 && originalRow < static_cast<int>(data.size()) ? originalRow : -1;
+        }
+        auto it = std::lower_bound(rowIndex.begin(), rowIndex.end(), static_cast<uint32_t>(originalRow));
+        return (originalRow >= 0 && it != rowIndex.end() && *it == static_cast<uint32_t>(originalRow))
+            ? static_cast<int>(it - rowIndex.begin()) : -1;
+    }
 };
 
 struct ExcelData {
+    // Declared first so it is destroyed last: sheets point into it
+    std::shared_ptr<Arena> arena;
     std::vector<SheetData> sheets;
     std::vector<ImageData> images;
     std::vector<ImagePosition> imagePositions;
     std::vector<CellImageMapping> cellImageMappings;  // WPS Excel support
+    NativeMemoryCharge imageBytes;    // image payloads counted in the native memory gauge
+    
+    ExcelData() = default;
+    ExcelData(ExcelData&&) = default;
+    
+    // The old sheets are destroyed while their arena is still alive, so the
+    // arena is replaced last (member-wise assignment would free it first)
+    ExcelData& operator=(ExcelData&& other) noexcept {
+        if (this != &other) {
+            sheets = std::move(other.sheets);
+            images = std::move(other.images);
+            imagePositions = std::move(other.imagePositions);
+            cellImageMappings = std::move(other.cellImageMappings);
+            imageBytes = std::move(other.imageBytes);
+            arena = std::move(other.arena);
+        }
+        return *this;
+    }
+    
+    // Native bytes held by this result (arena blocks + image payloads)
+    int64_t nativeBytes() const {
+        return (arena ? static_cast<int64_t>(arena->bytesReserved()) : 0) + imageBytes.bytes();
+    }
+};
+
+struct RowFilter;
+
+// Options for one read, parsed from the JS options object
+struct ReadOptions {
+    bool computeSha256;                  // also compute SHA-256 for every media part
+    std::set<std::string> knownHashes;   // media with these XXH64 digests is returned without bytes
+    ReadLimits limits;                   // decompression / size limits, checked as the read proceeds
+    std::shared_ptr<ReadControl> control; // optional progress reporting and cancellation
+    bool valuesOnly;                     // skip xlnt: read values without styles, themes or metadata
+    bool isoDates;                       // date-formatted numbers become ISO 8601 text
+    size_t parseThreads;                 // values-only sheet parsing threads, 0 = one per core
+    std::shared_ptr<const RowFilter> filter; // rows of the table sheet to keep; null keeps all
+    std::string cacheDir;                // parse cache directory; empty disables the cache
+    size_t schemaRows;                   // rows sampled per sheet to pick column decoders, 0 = off
+    size_t schemaStartRow;               // first (0-based) row sampled, e.g. the row below the header
+    
+    ReadOptions() : computeSha256(false), valuesOnly(false), isoDates(false), parseThreads(0),
+                    schemaRows(0), schemaStartRow(0) {}
 };
 
 class XlsxReader {
@@ -49,8 +140,14 @@ public:
     // Load Excel file
     bool load(const std::string& filepath);
     
-    // Read all sheet data
-    std::vector<SheetData> readSheetData();
+    // Limits applied by readSheetData (cell count) and readExcel (archive sizes)
+    void setLimits(const ReadLimits& limits) { limits_ = limits; }
+    
+    // Progress / cancellation for load, readSheetData and readExcel; may be null
+    void setControl(ReadControl* control) { control_ = control; }
+    
+    // Read all sheet data; cell text and rows are allocated from arena
+    std::vector<SheetData> readSheetData(Arena& arena);
     
     // Extract all images from the workbook
     std::vector<ImageData> extractImages();
@@ -59,7 +156,7 @@ public:
     std::vector<ImagePosition> getImagePositions();
     
     // Read complete Excel data (sheets + images + positions)
-    ExcelData readExcel(const std::string& filepath);
+    ExcelData readExcel(const std::string& filepath, const ReadOptions& options = ReadOptions());
     
     // Get last error message
     std::string getLastError() const { return lastError_; }
@@ -68,12 +165,28 @@ private:
     xlnt::workbook workbook_;
     std::string lastError_;
     bool loaded_;
+    ReadLimits limits_;
+    ReadControl* control_;
+    bool isoDates_;
+    bool date1904_;
+    size_t schemaRows_;
+    size_t schemaStartRow_;
     
     // Helper function to convert cell value to string
     std::string cellToString(const xlnt::cell& cell);
     
-    // Helper function to determine image type from extension
-    std::string getImageType(const std::string& filename);
+    // Column type of a non-empty cell, for schema inference
+    ColumnType cellColumnType(const xlnt::cell& cell);
+    
+    // Text for a cell of a column whose decoder is decoder (Number, String or
+    // Boolean); false when the cell does not fit it
+    bool decodeColumnCell(const xlnt::cell& cell, ColumnType decoder, Arena& arena, CellText& outText);
+    
+    // Sheets, images (with all payloads) and anchors, before filters and knownHashes apply
+    bool parseWorkbook(const std::string& filepath, const ReadOptions& options, ExcelData& data);
+    
+    // Cell, image count and media size limits for a result loaded from the parse cache
+    bool checkLoadedLimits(const ExcelData& data);
 };
 
 } // namespace baja_xlsx
@@ -0,0 +1,540 @@
+#include "xlsx_writer.h"
+#include "image_format.h"
+#include "cell_format.h"
+#include <zip.h>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+namespace baja_xlsx {
+
+namespace fs = std::filesystem;
+
+static const char* kXmlHeader = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+static const char* kMainNs = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+static const char* kRelNs = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+static const char* kPackageRelNs = "http://schemas.openxmlformats.org/package/2006/relationships";
+
+// Pixels to EMU at 96 DPI
+static const long long kEmuPerPixel = 9525;
+
+// "A", "B", ..., "Z", "AA", ... for a 0-based column index
+static std::string columnName(int col) {
+    std::string name;
+    int n = col + 1;
+    while (n > 0) {
+        int rem = (n - 1) % 26;
+        name.insert(name.begin(), static_cast<char>('A' + rem));
+        n = (n - 1) / 26;
+    }
+    return name;
+}
+
+// Escape text for element content / attribute values and drop characters XML 1.0 forbids
+static void appendXmlEscaped(std::string& out, const std::string& text) {
+    for (unsigned char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            default:
+                if (c < 0x20 && c != '\t' && c != '\n' && c != '\r') {
+                    break;
+                }
+                out += static_cast<char>(c);
+        }
+    }
+}
+
+static std::string xmlEscape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    appendXmlEscaped(out, text);
+    return out;
+}
+
+static std::string extensionForContentType(const std::string& contentType) {
+    if (contentType == "image/png") return "png";
+    if (contentType == "image/jpeg") return "jpeg";
+    if (contentType == "image/gif") return "gif";
+    if (contentType == "image/bmp") return "bmp";
+    if (contentType == "image/x-emf") return "emf";
+    if (contentType == "image/x-wmf") return "wmf";
+    if (contentType == "image/webp") return "webp";
+    return "";
+}
+
+XlsxWriter::XlsxWriter() : opened_(false), sheetOpen_(false), rowCount_(0), internedBytes_(0) {
+}
+
+XlsxWriter::~XlsxWriter() {
+    // Abandoned writer: nothing is written, spool files are removed
+    if (opened_) {
+        sheetStream_.close();
+        sharedStringsStream_.close();
+        removeSpool();
+    }
+}
+
+bool XlsxWriter::open(const std::string& path) {
+    if (opened_) {
+        lastError_ = "Writer is already open";
+        return false;
+    }
+
+    try {
+        std::random_device rd;
+        char suffix[17];
+        std::snprintf(suffix, sizeof(suffix), "%08x%08x", rd(), rd());
+
+        fs::path dir = fs::temp_directory_path() / (std::string("baja-xlsx-") + suffix);
+        fs::create_directories(dir);
+        spoolDir_ = dir.string();
+    } catch (const std::exception& e) {
+        lastError_ = std::string("Failed to create spool directory: ") + e.what();
+        return false;
+    }
+
+    sharedStringsStream_.open((fs::path(spoolDir_) / "sharedStrings.xml").string(), std::ios::binary);
+    if (!sharedStringsStream_) {
+        lastError_ = "Failed to create spool file for shared strings";
+        removeSpool();
+        return false;
+    }
+    sharedStringsStream_ << kXmlHeader << "<sst xmlns=\"" << kMainNs << "\">";
+
+    outputPath_ = path;
+    opened_ = true;
+    lastError_ = "";
+    return true;
+}
+
+bool XlsxWriter::addSheet(const std::string& name) {
+    if (!opened_) {
+        lastError_ = "Writer is not open";
+        return false;
+    }
+
+    // Excel's sheet name rules
+    if (name.empty() || name.size() > 31 || name.find_first_of("[]:*?/\\") != std::string::npos) {
+        lastError_ = "Invalid sheet name: " + name;
+        return false;
+    }
+    for (const auto& sheet : sheets_) {
+        if (sheet.name == name) {
+            lastError_ = "Duplicate sheet name: " + name;
+            return false;
+        }
+    }
+
+    if (!finishSheet()) {
+        return false;
+    }
+
+    SheetState sheet;
+    sheet.name = name;
+    sheet.spoolPath = (fs::path(spoolDir_) / ("sheet" + std::to_string(sheets_.size() + 1) + ".xml")).string();
+
+    sheetStream_.open(sheet.spoolPath, std::ios::binary);
+    if (!sheetStream_) {
+        lastError_ = "Failed to create spool file for sheet: " + name;
+        return false;
+    }
+    sheetStream_ << kXmlHeader
+                 << "<worksheet xmlns=\"" << kMainNs << "\" xmlns:r=\"" << kRelNs << "\"><sheetData>";
+
+    sheets_.push_back(std::move(sheet));
+    sheetOpen_ = true;
+    rowCount_ = 0;
+    return true;
+}
+
+uint32_t XlsxWriter::internString(const std::string& text, bool& outInterned) {
+    auto it = sharedStrings_.find(text);
+    if (it != sharedStrings_.end()) {
+        outInterned = true;
+        return it->second;
+    }
+
+    if (sharedStrings_.size() >= kMaxInternedStrings) {
+        outInterned = false;
+        return 0;
+    }
+
+    uint32_t index = static_cast<uint32_t>(sharedStrings_.size());
+    sharedStrings_.emplace(text, index);
+    // Key bytes plus a rough per-node overhead (node, hash bucket, std::string header)
+    internedBytes_ += text.size() + 64;
+
+    std::string si = "<si><t xml:space=\"preserve\">";
+    appendXmlEscaped(si, text);
+    si += "</t></si>";
+    sharedStringsStream_ << si;
+
+    outInterned = true;
+    return index;
+}
+
+bool XlsxWriter::writeRow(const std::vector<WriteCell>& cells) {
+    if (!opened_) {
+        lastError_ = "Writer is not open";
+        return false;
+    }
+    if (!sheetOpen_ && !addSheet("Sheet" + std::to_string(sheets_.size() + 1))) {
+        return false;
+    }
+
+    if (rowCount_ >= kMaxRows) {
+        lastError_ = "Sheet " + sheets_.back().name + " is full: Excel allows at most " +
+                     std::to_string(kMaxRows) + " rows";
+        return false;
+    }
+    if (cells.size() > static_cast<size_t>(kMaxColumns)) {
+        lastError_ = "Row has " + std::to_string(cells.size()) + " cells: Excel allows at most " +
+                     std::to_string(kMaxColumns) + " columns";
+        return false;
+    }
+
+    std::string rowNumber = std::to_string(rowCount_ + 1);
+
+    for (size_t col = 0; col < cells.size(); ++col) {
+        double number = cells[col].number;
+        if (cells[col].type == WriteCell::Number && !std::isfinite(number)) {
+            lastError_ = "Cell " + columnName(static_cast<int>(col)) + rowNumber + ": " +
+                         (std::isnan(number) ? "NaN" : number > 0 ? "Infinity" : "-Infinity") +
+                         " is not a finite number";
+            return false;
+        }
+    }
+
+    std::string xml;
+    xml.reserve(64 + cells.size() * 24);
+    xml += "<row r=\"";
+    xml += rowNumber;
+    xml += "\">";
+
+    for (size_t col = 0; col < cells.size(); ++col) {
+        const WriteCell& cell = cells[col];
+        if (cell.type == WriteCell::Empty) continue;
+
+        std::string ref = columnName(static_cast<int>(col)) + rowNumber;
+
+        switch (cell.type) {
+            case WriteCell::String: {
+                bool interned = false;
+                uint32_t index = internString(cell.text, interned);
+                if (interned) {
+                    xml += "<c r=\"" + ref + "\" t=\"s\"><v>" + std::to_string(index) + "</v></c>";
+                } else {
+                    xml += "<c r=\"" + ref + "\" t=\"inlineStr\"><is><t xml:space=\"preserve\">";
+                    appendXmlEscaped(xml, cell.text);
+                    xml += "</t></is></c>";
+                }
+                break;
+            }
+            case WriteCell::Number:
+                xml += "<c r=\"" + ref + "\"><v>" + formatNumber(cell.number) + "</v></c>";
+                break;
+            case WriteCell::Boolean:
+                xml += "<c r=\"" + ref + "\" t=\"b\"><v>" + (cell.boolean ? "1" : "0") + "</v></c>";
+                break;
+            default:
+                break;
+        }
+    }
+    xml += "</row>";
+
+    sheetStream_ << xml;
+    if (!sheetStream_) {
+        lastError_ = "Failed to write row to spool file";
+        return false;
+    }
+
+    rowCount_++;
+    return true;
+}
+
+bool XlsxWriter::addImage(const uint8_t* data, size_t size, const WriteImageAnchor& anchor) {
+    if (!opened_) {
+        lastError_ = "Writer is not open";
+        return false;
+    }
+    if (!sheetOpen_ && !addSheet("Sheet" + std::to_string(sheets_.size() + 1))) {
+        return false;
+    }
+
+    // An omitted (negative) to cell is from + 1, which must fit as well
+    if (anchor.fromCol >= kMaxColumns || anchor.toCol > kMaxColumns ||
+        anchor.fromRow >= kMaxRows || anchor.toRow > kMaxRows) {
+        lastError_ = "Image anchor is outside the sheet (at most " + std::to_string(kMaxRows) +
+                     " rows and " + std::to_string(kMaxColumns) + " columns)";
+        return false;
+    }
+
+    ImageFormatInfo format;
+    std::string extension;
+    if (sniffImageFormat(data, size, format)) {
+        extension = extensionForContentType(format.contentType);
+    }
+    if (extension.empty()) {
+        lastError_ = "Unsupported image format";
+        return false;
+    }
+
+    MediaState media;
+    media.extension = extension;
+    media.contentType = format.contentType;
+    media.width = format.width;
+    media.height = format.height;
+    media.spoolPath = (fs::path(spoolDir_) / ("image" + std::to_string(media_.size() + 1) + "." + extension)).string();
+
+    std::ofstream out(media.spoolPath, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) {
+        lastError_ = "Failed to write image to spool file";
+        return false;
+    }
+
+    WriteImageAnchor placed = anchor;
+    if (placed.toCol < 0) placed.toCol = placed.fromCol + 1;
+    if (placed.toRow < 0) placed.toRow = placed.fromRow + 1;
+
+    sheets_.back().images.emplace_back(placed, media_.size());
+    media_.push_back(std::move(media));
+    return true;
+}
+
+bool XlsxWriter::finishSheet() {
+    if (!sheetOpen_) {
+        return true;
+    }
+
+    sheetStream_ << "</sheetData>";
+    if (!sheets_.back().images.empty()) {
+        sheetStream_ << "<drawing r:id=\"rId1\"/>";
+    }
+    sheetStream_ << "</worksheet>";
+    sheetStream_.close();
+    sheetOpen_ = false;
+
+    if (sheetStream_.fail()) {
+        lastError_ = "Failed to finish sheet: " + sheets_.back().name;
+        return false;
+    }
+    return true;
+}
+
+std::string XlsxWriter::buildDrawingXml(const SheetState& sheet) const {
+    std::string xml = kXmlHeader;
+    xml += "<xdr:wsDr xmlns:xdr=\"http://schemas.openxmlformats.org/drawingml/2006/spreadsheetDrawing\""
+           " xmlns:a=\"http://schemas.openxmlformats.org/drawingml/2006/main\""
+           " xmlns:r=\"";
+    xml += kRelNs;
+    xml += "\">";
+
+    for (size_t i = 0; i < sheet.images.size(); ++i) {
+        const WriteImageAnchor& anchor = sheet.images[i].first;
+        const MediaState& media = media_[sheet.images[i].second];
+        std::string id = std::to_string(i + 1);
+
+        xml += "<xdr:twoCellAnchor editAs=\"oneCell\">";
+        xml += "<xdr:from><xdr:col>" + std::to_string(anchor.fromCol) + "</xdr:col><xdr:colOff>0</xdr:colOff>"
+               "<xdr:row>" + std::to_string(anchor.fromRow) + "</xdr:row><xdr:rowOff>0</xdr:rowOff></xdr:from>";
+        xml += "<xdr:to><xdr:col>" + std::to_string(anchor.toCol) + "</xdr:col><xdr:colOff>0</xdr:colOff>"
+               "<xdr:row>" + std::to_string(anchor.toRow) + "</xdr:row><xdr:rowOff>0</xdr:rowOff></xdr:to>";
+        xml += "<xdr:pic><xdr:nvPicPr><xdr:cNvPr id=\"" + std::to_string(i + 2) + "\" name=\"Picture " + id + "\"/>"
+               "<xdr:cNvPicPr><a:picLocks noChangeAspect=\"1\"/></xdr:cNvPicPr></xdr:nvPicPr>";
+        xml += "<xdr:blipFill><a:blip r:embed=\"rId" + id + "\"/><a:stretch><a:fillRect/></a:stretch></xdr:blipFill>";
+        xml += "<xdr:spPr><a:xfrm><a:off x=\"0\" y=\"0\"/><a:ext cx=\"" + std::to_string(media.width * kEmuPerPixel) +
+               "\" cy=\"" + std::to_string(media.height * kEmuPerPixel) + "\"/></a:xfrm>"
+               "<a:prstGeom prst=\"rect\"><a:avLst/></a:prstGeom></xdr:spPr></xdr:pic>";
+        xml += "<xdr:clientData/></xdr:twoCellAnchor>";
+    }
+
+    xml += "</xdr:wsDr>";
+    return xml;
+}
+
+bool XlsxWriter::addBufferEntry(void* zipArchive, const std::string& name, std::string content) {
+    zip_t* za = static_cast<zip_t*>(zipArchive);
+
+    pendingBuffers_.push_back(std::move(content));
+    const std::string& stored = pendingBuffers_.back();
+
+    zip_source_t* source = zip_source_buffer(za, stored.data(), stored.size(), 0);
+    if (!source || zip_file_add(za, name.c_str(), source, ZIP_FL_ENC_UTF_8) < 0) {
+        if (source) zip_source_free(source);
+        lastError_ = "Failed to add " + name + ": " + zip_strerror(za);
+        return false;
+    }
+    return true;
+}
+
+bool XlsxWriter::addFileEntry(void* zipArchive, const std::string& name, const std::string& spoolPath) {
+    zip_t* za = static_cast<zip_t*>(zipArchive);
+
+    // The file is read and deflated in chunks when the archive is closed
+    zip_source_t* source = zip_source_file(za, spoolPath.c_str(), 0, 0);
+    if (!source || zip_file_add(za, name.c_str(), source, ZIP_FL_ENC_UTF_8) < 0) {
+        if (source) zip_source_free(source);
+        lastError_ = "Failed to add " + name + ": " + zip_strerror(za);
+        return false;
+    }
+    return true;
+}
+
+bool XlsxWriter::close() {
+    if (!opened_) {
+        lastError_ = "Writer is not open";
+        return false;
+    }
+
+    if (sheets_.empty() && !addSheet("Sheet1")) {
+        return false;
+    }
+    if (!finishSheet()) {
+        return false;
+    }
+
+    sharedStringsStream_ << "</sst>";
+    sharedStringsStream_.close();
+    if (sharedStringsStream_.fail()) {
+        lastError_ = "Failed to finish shared strings";
+        return false;
+    }
+
+    int errorp;
+    zip_t* za = zip_open(outputPath_.c_str(), ZIP_CREATE | ZIP_TRUNCATE, &errorp);
+    if (!za) {
+        zip_error_t error;
+        zip_error_init_with_code(&error, errorp);
+        lastError_ = std::string("Failed to create XLSX file: ") + zip_error_strerror(&error);
+        zip_error_fini(&error);
+        return false;
+    }
+
+    // [Content_Types].xml
+    std::string contentTypes = kXmlHeader;
+    contentTypes += "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                    "<Default Extension=\"xml\" ContentType=\"application/xml\"/>";
+    std::vector<std::string> mediaExtensions;
+    for (const auto& media : media_) {
+        bool seen = false;
+        for (const auto& ext : mediaExtensions) {
+            if (ext == media.extension) seen = true;
+        }
+        if (!seen) {
+            mediaExtensions.push_back(media.extension);
+            contentTypes += "<Default Extension=\"" + media.extension + "\" ContentType=\"" + media.contentType + "\"/>";
+        }
+    }
+    contentTypes += "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+                    "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+                    "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>";
+    for (size_t i = 0; i < sheets_.size(); ++i) {
+        std::string n = std::to_string(i + 1);
+        contentTypes += "<Override PartName=\"/xl/worksheets/sheet" + n + ".xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>";
+        if (!sheets_[i].images.empty()) {
+            contentTypes += "<Override PartName=\"/xl/drawings/drawing" + n + ".xml\" ContentType=\"application/vnd.openxmlformats-officedocument.drawing+xml\"/>";
+        }
+    }
+    contentTypes += "</Types>";
+
+    // Package and workbook relationships
+    std::string rootRels = kXmlHeader;
+    rootRels += std::string("<Relationships xmlns=\"") + kPackageRelNs + "\">"
+                "<Relationship Id=\"rId1\" Type=\"" + kRelNs + "/officeDocument\" Target=\"xl/workbook.xml\"/>"
+                "</Relationships>";
+
+    std::string workbook = kXmlHeader;
+    workbook += std::string("<workbook xmlns=\"") + kMainNs + "\" xmlns:r=\"" + kRelNs + "\"><sheets>";
+    std::string workbookRels = kXmlHeader;
+    workbookRels += std::string("<Relationships xmlns=\"") + kPackageRelNs + "\">";
+    for (size_t i = 0; i < sheets_.size(); ++i) {
+        std::string n = std::to_string(i + 1);
+        workbook += "<sheet name=\"" + xmlEscape(sheets_[i].name) + "\" sheetId=\"" + n + "\" r:id=\"rId" + n + "\"/>";
+        workbookRels += "<Relationship Id=\"rId" + n + "\" Type=\"" + kRelNs + "/worksheet\" Target=\"worksheets/sheet" + n + ".xml\"/>";
+    }
+    workbook += "</sheets></workbook>";
+    workbookRels += "<Relationship Id=\"rId" + std::to_string(sheets_.size() + 1) + "\" Type=\"" + kRelNs + "/styles\" Target=\"styles.xml\"/>";
+    workbookRels += "<Relationship Id=\"rId" + std::to_string(sheets_.size() + 2) + "\" Type=\"" + kRelNs + "/sharedStrings\" Target=\"sharedStrings.xml\"/>";
+    workbookRels += "</Relationships>";
+
+    // Minimal stylesheet: one font, the two mandatory fills, one border, one cell format
+    std::string styles = kXmlHeader;
+    styles += std::string("<styleSheet xmlns=\"") + kMainNs + "\">"
+              "<fonts count=\"1\"><font><sz val=\"11\"/><name val=\"Calibri\"/></font></fonts>"
+              "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+              "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+              "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+              "<cellXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/></cellXfs>"
+              "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+              "</styleSheet>";
+
+    bool ok = addBufferEntry(za, "[Content_Types].xml", contentTypes) &&
+              addBufferEntry(za, "_rels/.rels", rootRels) &&
+              addBufferEntry(za, "xl/workbook.xml", workbook) &&
+              addBufferEntry(za, "xl/_rels/workbook.xml.rels", workbookRels) &&
+              addBufferEntry(za, "xl/styles.xml", styles) &&
+              addFileEntry(za, "xl/sharedStrings.xml", (fs::path(spoolDir_) / "sharedStrings.xml").string());
+
+    for (size_t i = 0; ok && i < sheets_.size(); ++i) {
+        const SheetState& sheet = sheets_[i];
+        std::string n = std::to_string(i + 1);
+
+        ok = addFileEntry(za, "xl/worksheets/sheet" + n + ".xml", sheet.spoolPath);
+        if (!ok || sheet.images.empty()) continue;
+
+        // sheet -> drawing -> media, the chain ImageExtractor follows when reading
+        std::string sheetRels = kXmlHeader;
+        sheetRels += std::string("<Relationships xmlns=\"") + kPackageRelNs + "\">"
+                     "<Relationship Id=\"rId1\" Type=\"" + kRelNs + "/drawing\" Target=\"../drawings/drawing" + n + ".xml\"/>"
+                     "</Relationships>";
+
+        std::string drawingRels = kXmlHeader;
+        drawingRels += std::string("<Relationships xmlns=\"") + kPackageRelNs + "\">";
+        for (size_t j = 0; j < sheet.images.size(); ++j) {
+            size_t mediaIndex = sheet.images[j].second;
+            drawingRels += "<Relationship Id=\"rId" + std::to_string(j + 1) + "\" Type=\"" + kRelNs +
+                           "/image\" Target=\"../media/image" + std::to_string(mediaIndex + 1) + "." +
+                           media_[mediaIndex].extension + "\"/>";
+        }
+        drawingRels += "</Relationships>";
+
+        ok = addBufferEntry(za, "xl/worksheets/_rels/sheet" + n + ".xml.rels", sheetRels) &&
+             addBufferEntry(za, "xl/drawings/drawing" + n + ".xml", buildDrawingXml(sheet)) &&
+             addBufferEntry(za, "xl/drawings/_rels/drawing" + n + ".xml.rels", drawingRels);
+    }
+
+    for (size_t i = 0; ok && i < media_.size(); ++i) {
+        ok = addFileEntry(za, "xl/media/image" + std::to_string(i + 1) + "." + media_[i].extension, media_[i].spoolPath);
+    }
+
+    if (!ok) {
+        zip_discard(za);
+    } else if (zip_close(za) != 0) {
+        lastError_ = std::string("Failed to write XLSX file: ") + zip_strerror(za);
+        zip_discard(za);
+        ok = false;
+    }
+
+    pendingBuffers_.clear();
+    std::unordered_map<std::string, uint32_t>().swap(sharedStrings_);
+    internedBytes_ = 0;
+    removeSpool();
+    opened_ = false;
+    return ok;
+}
+
+void XlsxWriter::removeSpool() {
+    if (spoolDir_.empty()) return;
+
+    std::error_code ec;
+    fs::remove_all(spoolDir_, ec);
+    spoolDir_.clear();
+}
+
+} // namespace baja_xlsx
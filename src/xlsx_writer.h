@@ -0,0 +1,122 @@
+#ifndef XLSX_WRITER_H
+#define XLSX_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace baja_xlsx {
+
+struct WriteCell {
+    enum Type { Empty, String, Number, Boolean };
+
+    Type type;
+    std::string text;
+    double number;
+    bool boolean;
+
+    WriteCell() : type(Empty), number(0), boolean(false) {}
+};
+
+// Where a picture goes, as a twoCellAnchor. A negative toCol/toRow means
+// "fit the from cell" (to = from + 1), which is how pictures placed in a cell
+// by writeRow() are anchored. Coordinates are 0-based, as in the drawing XML
+// read by ImageExtractor.
+struct WriteImageAnchor {
+    int fromCol;
+    int fromRow;
+    int toCol;
+    int toRow;
+
+    WriteImageAnchor() : fromCol(0), fromRow(0), toCol(-1), toRow(-1) {}
+};
+
+// Streaming .xlsx writer. Sheet XML and media are spooled to temporary files
+// as rows arrive and are deflated into the archive by libzip on close(), so
+// memory use does not grow with the number of rows.
+class XlsxWriter {
+public:
+    // Excel's worksheet size
+    static constexpr int kMaxRows = 1048576;
+    static constexpr int kMaxColumns = 16384;
+
+    XlsxWriter();
+    ~XlsxWriter();
+
+    XlsxWriter(const XlsxWriter&) = delete;
+    XlsxWriter& operator=(const XlsxWriter&) = delete;
+
+    bool open(const std::string& path);
+
+    // Start a new worksheet; finishes the previous one
+    bool addSheet(const std::string& name);
+
+    // Append one row to the current sheet. Fails without writing anything when
+    // the sheet already has kMaxRows rows, the row has more than kMaxColumns
+    // cells, or a number is NaN or infinite (Excel cannot open such files)
+    bool writeRow(const std::vector<WriteCell>& cells);
+
+    // Place a picture on the current sheet; the anchor must lie within the sheet limits
+    bool addImage(const uint8_t* data, size_t size, const WriteImageAnchor& anchor);
+
+    // Number of rows written to the current sheet
+    int currentRow() const { return rowCount_; }
+
+    // Approximate heap held between calls (the shared string table); spooled data is on disk
+    size_t memoryUsage() const { return internedBytes_; }
+
+    // Write the package and remove the spool files
+    bool close();
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    struct SheetState {
+        std::string name;
+        std::string spoolPath;
+        std::vector<std::pair<WriteImageAnchor, size_t>> images;  // anchor, media index
+    };
+
+    struct MediaState {
+        std::string spoolPath;
+        std::string extension;
+        std::string contentType;
+        int width;
+        int height;
+    };
+
+    bool finishSheet();
+    uint32_t internString(const std::string& text, bool& outInterned);
+    std::string buildDrawingXml(const SheetState& sheet) const;
+    bool addBufferEntry(void* za, const std::string& name, std::string content);
+    bool addFileEntry(void* za, const std::string& name, const std::string& spoolPath);
+    void removeSpool();
+
+    std::string outputPath_;
+    std::string spoolDir_;
+    bool opened_;
+    bool sheetOpen_;
+    int rowCount_;
+    std::string lastError_;
+
+    std::ofstream sheetStream_;
+    std::vector<SheetState> sheets_;
+    std::vector<MediaState> media_;
+
+    // Shared strings: interned up to kMaxInternedStrings distinct values, after
+    // which new strings are written inline so memory stays bounded.
+    std::ofstream sharedStringsStream_;
+    std::unordered_map<std::string, uint32_t> sharedStrings_;
+    size_t internedBytes_;
+    static constexpr size_t kMaxInternedStrings = 1 << 20;
+
+    // Small parts handed to libzip by pointer must outlive zip_close()
+    std::list<std::string> pendingBuffers_;
+};
+
+} // namespace baja_xlsx
+
+#endif // XLSX_WRITER_H
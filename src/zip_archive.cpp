@@ -0,0 +1,191 @@
+#include "zip_archive.h"
+#include "inflate.h"
+#include <zip.h>
+#include <algorithm>
+
+namespace baja_xlsx {
+
+// Raw compressed bytes through the one-shot backend; false means "use libzip"
+static bool inflateOneShot(zip_t* za, zip_int64_t index, const struct zip_stat& sb,
+                           std::vector<uint8_t>& outData) {
+    const zip_uint64_t needed = ZIP_STAT_COMP_METHOD | ZIP_STAT_ENCRYPTION_METHOD |
+                                ZIP_STAT_COMP_SIZE | ZIP_STAT_CRC;
+    if ((sb.valid & needed) != needed || sb.comp_method != ZIP_CM_DEFLATE ||
+        sb.encryption_method != ZIP_EM_NONE) {
+        return false;
+    }
+    
+    // The one-shot buffer is allocated from the declared size before anything is
+    // inflated: skip sizes deflate cannot produce (over 1032:1) and very large
+    // entries, which stream through libzip into a growing buffer instead
+    if (sb.size > kEntryReserveLimit || sb.size / 1032 > sb.comp_size + 1) {
+        return false;
+    }
+
+    zip_file_t* zf = zip_fopen_index(za, index, ZIP_FL_COMPRESSED);
+    if (!zf) {
+        return false;
+    }
+    std::vector<uint8_t> compressed(sb.comp_size);
+    zip_int64_t bytesRead = zip_fread(zf, compressed.data(), sb.comp_size);
+    zip_fclose(zf);
+    if (bytesRead != static_cast<zip_int64_t>(sb.comp_size)) {
+        return false;
+    }
+
+    outData.resize(sb.size);
+    return inflateRaw(compressed.data(), compressed.size(), outData.data(), outData.size()) &&
+           inflateCrc32(outData.data(), outData.size()) == sb.crc;
+}
+
+bool inflateZipEntry(void* zipArchive, int64_t index, std::vector<uint8_t>& outData) {
+    zip_t* za = static_cast<zip_t*>(zipArchive);
+
+    struct zip_stat sb;
+    zip_stat_init(&sb);
+    if (zip_stat_index(za, index, 0, &sb) != 0 || !(sb.valid & ZIP_STAT_SIZE)) {
+        return false;
+    }
+
+    if (inflateAvailable() && inflateOneShot(za, index, sb, outData)) {
+        return true;
+    }
+
+    zip_file_t* zf = zip_fopen_index(za, index, 0);
+    if (!zf) {
+        return false;
+    }
+
+    // Grow with the inflated bytes instead of trusting the declared size
+    const zip_uint64_t chunkSize = 1024 * 1024;
+    outData.clear();
+    outData.reserve(static_cast<size_t>(std::min<zip_uint64_t>(sb.size, kEntryReserveLimit)));
+    while (outData.size() < sb.size) {
+        size_t offset = outData.size();
+        zip_uint64_t want = std::min<zip_uint64_t>(chunkSize, sb.size - offset);
+        outData.resize(offset + static_cast<size_t>(want));
+        zip_int64_t n = zip_fread(zf, outData.data() + offset, want);
+        outData.resize(offset + static_cast<size_t>(n > 0 ? n : 0));
+        if (n <= 0) break;
+    }
+    zip_fclose(zf);
+
+    return outData.size() == sb.size;
+}
+
+ZipArchive::ZipArchive() : za_(nullptr) {
+}
+
+ZipArchive::~ZipArchive() {
+    close();
+}
+
+bool ZipArchive::open(const std::string& path) {
+    close();
+
+    int errorp;
+    zip_t* za = zip_open(path.c_str(), ZIP_RDONLY, &errorp);
+    if (!za) {
+        zip_error_t error;
+        zip_error_init_with_code(&error, errorp);
+        lastError_ = std::string("Failed to open XLSX file as ZIP: ") + zip_error_strerror(&error);
+        zip_error_fini(&error);
+        return false;
+    }
+
+    za_ = za;
+    lastError_ = "";
+    return true;
+}
+
+void ZipArchive::close() {
+    if (za_) {
+        zip_discard(static_cast<zip_t*>(za_));
+        za_ = nullptr;
+    }
+}
+
+int64_t ZipArchive::entryCount() const {
+    if (!za_) return 0;
+    return zip_get_num_entries(static_cast<zip_t*>(za_), 0);
+}
+
+bool ZipArchive::entryInfo(int64_t index, ZipEntryInfo& outInfo) const {
+    if (!za_) return false;
+
+    struct zip_stat sb;
+    zip_stat_init(&sb);
+    if (zip_stat_index(static_cast<zip_t*>(za_), index, 0, &sb) != 0 || !sb.name) {
+        return false;
+    }
+
+    outInfo.name = sb.name;
+    outInfo.compressedSize = (sb.valid & ZIP_STAT_COMP_SIZE) ? sb.comp_size : 0;
+    outInfo.uncompressedSize = (sb.valid & ZIP_STAT_SIZE) ? sb.size : 0;
+    return true;
+}
+
+int64_t ZipArchive::locate(const std::string& name) const {
+    if (!za_) return -1;
+    return zip_name_locate(static_cast<zip_t*>(za_), name.c_str(), 0);
+}
+
+bool ZipArchive::readEntry(const std::string& name, std::vector<uint8_t>& outData, uint64_t maxBytes) {
+    zip_t* za = static_cast<zip_t*>(za_);
+    if (!za) return false;
+
+    zip_int64_t index = zip_name_locate(za, name.c_str(), 0);
+    if (index < 0) {
+        return false;
+    }
+
+    struct zip_stat sb;
+    if (zip_stat_index(za, index, 0, &sb) != 0) {
+        return false;
+    }
+
+    if (maxBytes && sb.size > maxBytes) {
+        lastError_ = name + " is too large (" + std::to_string(sb.size) + " bytes)";
+        return false;
+    }
+
+    return inflateZipEntry(za, index, outData);
+}
+
+bool ZipArchive::readEntryHead(const std::string& name, std::string_view stopMarker,
+                               size_t maxBytes, std::string& outData) {
+    zip_t* za = static_cast<zip_t*>(za_);
+    if (!za) return false;
+
+    zip_int64_t index = zip_name_locate(za, name.c_str(), 0);
+    if (index < 0) {
+        return false;
+    }
+
+    zip_file_t* zf = zip_fopen_index(za, index, 0);
+    if (!zf) {
+        return false;
+    }
+
+    outData.clear();
+    const size_t chunkSize = 16 * 1024;
+    char buffer[chunkSize];
+
+    while (outData.size() < maxBytes) {
+        zip_int64_t n = zip_fread(zf, buffer, chunkSize);
+        if (n <= 0) break;
+
+        // Only the tail of the previous chunk can contain the start of the marker
+        size_t searchFrom = outData.size() >= stopMarker.size() ? outData.size() - stopMarker.size() : 0;
+        outData.append(buffer, static_cast<size_t>(n));
+
+        if (!stopMarker.empty() && outData.find(stopMarker, searchFrom) != std::string::npos) {
+            break;
+        }
+    }
+
+    zip_fclose(zf);
+    return true;
+}
+
+} // namespace baja_xlsx
@@ -0,0 +1,67 @@
+#ifndef ZIP_ARCHIVE_H
+#define ZIP_ARCHIVE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace baja_xlsx {
+
+struct ZipEntryInfo {
+    std::string name;
+    uint64_t compressedSize;
+    uint64_t uncompressedSize;
+};
+
+// Most bytes allocated up front from an entry's declared (unverified) size;
+// past this, buffers grow with the bytes actually inflated
+constexpr uint64_t kEntryReserveLimit = 64ull * 1024 * 1024;
+
+// Inflate a whole entry of a libzip handle; the declared size bounds how much
+// is inflated, not how much is allocated before inflating. Deflated entries up
+// to kEntryReserveLimit are decoded in one shot by the inflate backend when one
+// is compiled in, and checked against the stored CRC; other entries, and any
+// the backend rejects, stream through libzip.
+bool inflateZipEntry(void* zipArchive, int64_t index, std::vector<uint8_t>& outData);
+
+// Read-only view of an .xlsx package (RAII wrapper around a libzip handle)
+class ZipArchive {
+public:
+    ZipArchive();
+    ~ZipArchive();
+
+    ZipArchive(const ZipArchive&) = delete;
+    ZipArchive& operator=(const ZipArchive&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return za_ != nullptr; }
+
+    // Central directory access (no decompression involved)
+    int64_t entryCount() const;
+    bool entryInfo(int64_t index, ZipEntryInfo& outInfo) const;
+    int64_t locate(const std::string& name) const;
+
+    // Inflate a whole entry. With maxBytes set, entries declaring a larger
+    // uncompressed size are refused before any memory is allocated for them.
+    bool readEntry(const std::string& name, std::vector<uint8_t>& outData, uint64_t maxBytes = 0);
+
+    // Inflate only the beginning of an entry, stopping once stopMarker has been
+    // seen or maxBytes have been produced. Used to read sheet headers cheaply.
+    bool readEntryHead(const std::string& name, std::string_view stopMarker,
+                       size_t maxBytes, std::string& outData);
+
+    // Underlying zip_t* for code that still talks to libzip directly
+    void* handle() const { return za_; }
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    void* za_;
+    std::string lastError_;
+};
+
+} // namespace baja_xlsx
+
+#endif // ZIP_ARCHIVE_H
@@ -0,0 +1,120 @@
+/**
+ * 图片位置查询：readTableAsJSON 结果与 PackedWorkbook 上的 imagesInRange / imageCells
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, makePng } = require('./fixtures');
+const { readTableAsJSON, readPacked, PackedWorkbook } = require('..');
+
+// Sheet1：A 覆盖 1-3 行 6-7 列（to 偏移为0，不计入 to 所在行列）；
+// B 的 to 行有偏移，覆盖 10-12 行；C 只覆盖 (2, 9)。Sheet2 另有一张
+const anchorsFixture = () => fixture('anchors', () => ({
+  sheets: [
+    {
+      name: 'Sheet1',
+      rows: [['name', 'value'], ['a', 1], ['b', 2]],
+      images: [
+        { png: makePng(8, 1), from: { col: 6, row: 1 }, to: { col: 8, row: 4 } },
+        { png: makePng(8, 2), from: { col: 6, row: 10 }, to: { col: 7, row: 12, rowOff: 5000 } },
+        { png: makePng(8, 3), from: { col: 9, row: 2, colOff: 100 }, to: { col: 10, row: 3 } }
+      ]
+    },
+    {
+      name: 'Sheet2',
+      rows: [['x'], [1]],
+      images: [{ png: makePng(8, 4), from: { col: 0, row: 0 }, to: { col: 2, row: 2 } }]
+    }
+  ]
+}));
+
+// 400 张图片，位置由固定种子决定，用于与逐个比较的结果对照
+const manyFixture = () => fixture('anchors-many', () => {
+  let state = 12345;
+  const next = limit => {
+    state = (Math.imul(state, 1664525) + 1013904223) >>> 0;
+    return state % limit;
+  };
+  const images = [];
+  for (let i = 0; i < 400; i++) {
+    const row = next(2000);
+    const col = next(20);
+    images.push({
+      png: makePng(2, 100 + i),
+      from: { col, row },
+      to: { col: col + next(4), row: row + next(60), rowOff: next(2) * 100 }
+    });
+  }
+  return { sheets: [{ name: 'Many', rows: [['id'], [1]], images }] };
+});
+
+function corners(positions) {
+  return positions.map(p => [p.from.row, p.from.col]);
+}
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`结果上的 imagePositions 只含目标 Sheet（${mode}）`, () => {
+    const rows = readTableAsJSON(anchorsFixture(), { valuesOnly });
+    assert.deepStrictEqual(corners(rows.imagePositions), [[1, 6], [10, 6], [2, 9]]);
+    assert.ok(rows.imagePositions.every(p => p.sheet === 'Sheet1'));
+
+    const second = readTableAsJSON(anchorsFixture(), { valuesOnly, sheetName: 'Sheet2' });
+    assert.deepStrictEqual(corners(second.imagePositions), [[0, 0]]);
+    assert.deepStrictEqual(corners(second.imagesInRange({ firstRow: 0, lastRow: 100 })), [[0, 0]]);
+
+    // 不可枚举：不影响遍历和序列化
+    assert.deepStrictEqual(Object.keys(rows), ['0', '1']);
+    assert.deepStrictEqual(JSON.parse(JSON.stringify(rows)), [{ name: 'a', value: '1' }, { name: 'b', value: '2' }]);
+  });
+
+  test(`imagesInRange 按行列范围查询（${mode}）`, () => {
+    const rows = readTableAsJSON(anchorsFixture(), { valuesOnly });
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 0, lastRow: 5 })), [[1, 6], [2, 9]]);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 3 })), [[1, 6]]);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 4 })), []);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 12 })), [[10, 6]]);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 0, lastRow: 20, firstCol: 9, lastCol: 9 })), [[2, 9]]);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 0, lastRow: 20, firstCol: 8, lastCol: 8 })), []);
+    assert.deepStrictEqual(corners(rows.imagesInRange({ firstRow: 0, lastRow: 20, firstCol: 7 })), [[1, 6], [2, 9]]);
+  });
+
+  test(`imageCells 计算覆盖的单元格（${mode}）`, () => {
+    const rows = readTableAsJSON(anchorsFixture(), { valuesOnly });
+    const [a, b, c] = rows.imagePositions;
+    assert.deepStrictEqual(rows.imageCells(a), { firstRow: 1, firstCol: 6, lastRow: 3, lastCol: 7 });
+    assert.deepStrictEqual(rows.imageCells(b), { firstRow: 10, firstCol: 6, lastRow: 12, lastCol: 6 });
+    assert.deepStrictEqual(rows.imageCells(c), { firstRow: 2, firstCol: 9, lastRow: 2, lastCol: 9 });
+  });
+}
+
+test('与 PackedWorkbook 的查询结果相同', () => {
+  const rows = readTableAsJSON(anchorsFixture());
+  const wb = new PackedWorkbook(readPacked(anchorsFixture()));
+  for (const range of [{ firstRow: 0, lastRow: 5 }, { firstRow: 11 }, { firstRow: 0, lastRow: 3, firstCol: 9 }]) {
+    assert.deepStrictEqual(wb.imagesInRange('Sheet1', range), rows.imagesInRange(range));
+  }
+  assert.deepStrictEqual(corners(wb.imagesInRange('Sheet2', { firstRow: 1 })), [[0, 0]]);
+  assert.deepStrictEqual(wb.imagesInRange('missing', { firstRow: 0, lastRow: 100 }), []);
+});
+
+test('区间索引与逐个比较的结果相同', () => {
+  const rows = readTableAsJSON(manyFixture(), { valuesOnly: true });
+  const wb = new PackedWorkbook(readPacked(manyFixture(), { valuesOnly: true }));
+  assert.strictEqual(rows.imagePositions.length, 400);
+
+  const overlaps = (position, range) => {
+    const cells = rows.imageCells(position);
+    return cells.firstRow <= range.lastRow && cells.lastRow >= range.firstRow &&
+      cells.firstCol <= range.lastCol && cells.lastCol >= range.firstCol;
+  };
+
+  for (let i = 0; i < 300; i++) {
+    const firstRow = (i * 37) % 2100;
+    const range = { firstRow, lastRow: firstRow + (i % 50), firstCol: i % 20, lastCol: (i % 20) + (i % 5) };
+    const expected = rows.imagePositions.filter(position => overlaps(position, range));
+    assert.deepStrictEqual(rows.imagesInRange(range), expected);
+    assert.deepStrictEqual(wb.imagesInRange('Many', range), expected);
+  }
+});
@@ -0,0 +1,151 @@
+/**
+ * 解析缓存（cacheDir）：缓存键与读回结果
+ */
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { test } = require('./harness');
+const { fixture, tempDir, people, makePng, personObject } = require('./fixtures');
+const { readTableAsJSON } = require('..');
+
+const peopleWithImage = () => fixture('cache-people', () => ({
+  sheets: [{
+    name: 'People',
+    rows: people(40),
+    images: [{ png: makePng(8, 1), from: { col: 6, row: 1 }, to: { col: 8, row: 4 } }]
+  }]
+}));
+
+function entries(dir) {
+  return fs.readdirSync(dir).filter(file => file.endsWith('.bin')).sort();
+}
+
+// 行、schema 与图片位置都需与直接解析一致
+function assertSameTable(actual, expected) {
+  assert.deepStrictEqual(actual, expected);
+  assert.deepStrictEqual(actual.schema, expected.schema);
+  assert.deepStrictEqual(actual.imagePositions, expected.imagePositions);
+}
+
+for (const valuesOnly of [false, true]) {
+  test(`读回的结果与直接解析相同（valuesOnly: ${valuesOnly}）`, () => {
+    const file = peopleWithImage();
+    const cacheDir = tempDir('cache');
+    const options = { valuesOnly, schemaRows: 10, dates: 'iso' };
+
+    const direct = readTableAsJSON(file, options);
+    const first = readTableAsJSON(file, { ...options, cacheDir });
+    assert.strictEqual(entries(cacheDir).length, 1);
+    const entry = path.join(cacheDir, entries(cacheDir)[0]);
+    const written = fs.statSync(entry).mtimeMs;
+
+    const second = readTableAsJSON(file, { ...options, cacheDir });
+    assertSameTable(first, direct);
+    assertSameTable(second, direct);
+    assert.deepStrictEqual(second[4], personObject(4, true));
+
+    // 命中缓存时不重写条目
+    assert.deepStrictEqual(entries(cacheDir), [path.basename(entry)]);
+    assert.strictEqual(fs.statSync(entry).mtimeMs, written);
+  });
+}
+
+test('影响解析结果的选项各自使用独立的缓存条目', () => {
+  const file = peopleWithImage();
+  const cacheDir = tempDir('cache');
+
+  readTableAsJSON(file, { cacheDir });
+  readTableAsJSON(file, { cacheDir, valuesOnly: true });
+  readTableAsJSON(file, { cacheDir, dates: 'iso' });
+  readTableAsJSON(file, { cacheDir, schemaRows: 5 });
+  readTableAsJSON(file, { cacheDir, schemaRows: 5, headerRow: 1 });
+  readTableAsJSON(file, { cacheDir, sha256: true });
+  assert.strictEqual(entries(cacheDir).length, 6);
+
+  // 缓存键 = 内容哈希 - 选项哈希：同一文件的条目共享前半部分
+  const prefixes = new Set(entries(cacheDir).map(name => name.split('-')[0]));
+  assert.strictEqual(prefixes.size, 1);
+});
+
+test('加载后执行的选项共享同一缓存条目', () => {
+  const file = peopleWithImage();
+  const cacheDir = tempDir('cache');
+
+  const all = readTableAsJSON(file, { cacheDir });
+  const filtered = readTableAsJSON(file, { cacheDir, filter: [{ column: 'city', eq: 'Shanghai' }] });
+  const mapped = readTableAsJSON(file, { cacheDir, headerMap: { name: '姓名' }, skipRows: [1, 2] });
+  const known = readTableAsJSON(file, { cacheDir, knownHashes: ['0000000000000000'] });
+  assert.strictEqual(entries(cacheDir).length, 1);
+
+  assert.deepStrictEqual(filtered, all.filter(row => row.city === 'Shanghai'));
+  assert.strictEqual(mapped.length, all.length - 2);
+  assert.strictEqual(mapped[0]['姓名'], all[2].name);
+  assert.deepStrictEqual(known, all);
+});
+
+test('命中缓存时执行与直接解析相同的读取限制', () => {
+  const file = fixture('cache-two-images', () => ({
+    sheets: [{
+      name: 'People',
+      rows: people(10),
+      images: [1, 2].map(seed => ({ png: makePng(8, seed), from: { col: 6, row: seed }, to: { col: 7, row: seed + 1 } }))
+    }]
+  }));
+  const message = options => {
+    try {
+      readTableAsJSON(file, options);
+    } catch (err) {
+      return err.message;
+    }
+    return null;
+  };
+
+  for (const valuesOnly of [false, true]) {
+    const cacheDir = tempDir('cache');
+    readTableAsJSON(file, { valuesOnly, cacheDir });
+    assert.strictEqual(entries(cacheDir).length, 1);
+
+    for (const limits of [{ maxCells: 54 }, { maxImages: 1 }, { maxEntrySize: 64 }, { maxUncompressedSize: 1024 }]) {
+      const direct = message({ valuesOnly, limits });
+      assert.match(direct, /^Read limit exceeded: /);
+      assert.strictEqual(message({ valuesOnly, limits, cacheDir }), direct);
+    }
+    assert.strictEqual(readTableAsJSON(file, { valuesOnly, cacheDir, limits: { maxCells: 55, maxImages: 2 } }).length, 10);
+  }
+});
+
+test('文件内容变化后使用新的缓存条目', () => {
+  const cacheDir = tempDir('cache');
+  const file = path.join(cacheDir, 'changing.xlsx');
+
+  fs.copyFileSync(fixture('cache-small-a', () => ({ sheets: [{ name: 'S', rows: [['k'], ['a']] }] })), file);
+  assert.deepStrictEqual(readTableAsJSON(file, { cacheDir }), [{ k: 'a' }]);
+
+  fs.copyFileSync(fixture('cache-small-b', () => ({ sheets: [{ name: 'S', rows: [['k'], ['b']] }] })), file);
+  assert.deepStrictEqual(readTableAsJSON(file, { cacheDir }), [{ k: 'b' }]);
+  assert.strictEqual(entries(cacheDir).length, 2);
+});
+
+test('损坏的缓存条目被忽略并重新解析', () => {
+  const file = peopleWithImage();
+  const cacheDir = tempDir('cache');
+  const expected = readTableAsJSON(file, { cacheDir, schemaRows: 10 });
+  const entry = path.join(cacheDir, entries(cacheDir)[0]);
+
+  // 截断到一半：读取越界时放弃该条目
+  const bytes = fs.readFileSync(entry);
+  fs.writeFileSync(entry, bytes.subarray(0, bytes.length >> 1));
+  assertSameTable(readTableAsJSON(file, { cacheDir, schemaRows: 10 }), expected);
+
+  // 魔数不符
+  fs.writeFileSync(entry, Buffer.alloc(bytes.length, 0x5A));
+  assertSameTable(readTableAsJSON(file, { cacheDir, schemaRows: 10 }), expected);
+});
+
+test('缓存目录不可写时照常返回结果', () => {
+  const file = peopleWithImage();
+  const blocker = path.join(tempDir('cache'), 'not-a-directory');
+  fs.writeFileSync(blocker, '');
+  assert.deepStrictEqual(readTableAsJSON(file, { cacheDir: blocker }), readTableAsJSON(file));
+});
@@ -0,0 +1,152 @@
+/**
+ * 取消：AbortSignal、进度回调中取消、readMany 提前退出
+ */
+
+const assert = require('assert');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const { test } = require('./harness');
+const { fixture, people } = require('./fixtures');
+const { readTableAsJSONAsync, readMany, readSchedulerStats } = require('..');
+
+// 足够大，读取在取消生效前不会结束
+const LARGE = 150000;
+const largeFixture = () => fixture('cancel-large', () => ({ sheets: [{ name: 'People', rows: people(LARGE) }] }));
+// 每个读取耗时明显长于结果送达主线程的延迟，暂停的时机可预期
+const mediumFixture = () => fixture('cancel-medium', () => ({ sheets: [{ name: 'People', rows: people(3000) }] }));
+
+function assertAbortError(err) {
+  assert.strictEqual(err.name, 'AbortError');
+  assert.strictEqual(err.code, 'ABORT_ERR');
+  return true;
+}
+
+// 取消后原生线程应释放调度名额
+async function waitIdle() {
+  for (let i = 0; i < 200 && readSchedulerStats().running > 0; i++) {
+    await new Promise(resolve => setTimeout(resolve, 10));
+  }
+  assert.strictEqual(readSchedulerStats().running, 0);
+  assert.strictEqual(readSchedulerStats().queued, 0);
+}
+
+test('已取消的 signal 直接拒绝，不启动读取', async () => {
+  const before = readSchedulerStats().admitted;
+  const controller = new AbortController();
+  controller.abort();
+  await assert.rejects(readTableAsJSONAsync(largeFixture(), { signal: controller.signal }), assertAbortError);
+  assert.strictEqual(readSchedulerStats().admitted, before);
+});
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`读取开始后取消（${mode}）`, async () => {
+    const controller = new AbortController();
+    const promise = readTableAsJSONAsync(largeFixture(), { valuesOnly, signal: controller.signal });
+    controller.abort();
+    await assert.rejects(promise, assertAbortError);
+    await waitIdle();
+  });
+
+  test(`在首个进度回调中取消（${mode}）`, async () => {
+    const controller = new AbortController();
+    const phases = [];
+    let afterAbort = 0;
+    const promise = readTableAsJSONAsync(largeFixture(), {
+      valuesOnly,
+      signal: controller.signal,
+      onProgress: progress => {
+        if (controller.signal.aborted) {
+          afterAbort++;
+          return;
+        }
+        phases.push(progress.phase);
+        controller.abort();
+      }
+    });
+    await assert.rejects(promise, assertAbortError);
+    assert.strictEqual(phases.length, 1);
+    await waitIdle();
+    // 取消前已排队的回调仍会送达，但读取不再继续上报
+    assert.ok(afterAbort <= 3, `取消后仍收到 ${afterAbort} 次进度回调`);
+  });
+}
+
+test('取消后可以正常读取同一文件', async () => {
+  const controller = new AbortController();
+  const aborted = readTableAsJSONAsync(largeFixture(), { signal: controller.signal });
+  controller.abort();
+  await assert.rejects(aborted, assertAbortError);
+
+  const rows = await readTableAsJSONAsync(largeFixture(), { valuesOnly: true });
+  assert.strictEqual(rows.length, LARGE);
+  assert.strictEqual(rows[LARGE - 1].name, `user-${LARGE - 1}`);
+});
+
+test('readMany：signal 取消剩余文件', async () => {
+  const inputs = new Array(12).fill(largeFixture());
+  const controller = new AbortController();
+  const before = readSchedulerStats().admitted;
+  const results = [];
+  for await (const result of readMany(inputs, { concurrency: 2, valuesOnly: true, signal: controller.signal })) {
+    results.push(result);
+    controller.abort();
+  }
+  // 已在读取的文件以 AbortError 返回，未分配的文件不再读取
+  assert.ok(results.length >= 1 && results.length <= inputs.length);
+  for (const { error } of results.slice(1)) {
+    if (error) assertAbortError(error);
+  }
+  assert.ok(readSchedulerStats().admitted - before < inputs.length);
+  await waitIdle();
+});
+
+test('readMany：break 取消剩余文件并等待原生线程退出', async () => {
+  const inputs = new Array(12).fill(largeFixture());
+  const before = readSchedulerStats().admitted;
+  for await (const result of readMany(inputs, { concurrency: 2, valuesOnly: true })) {
+    assert.strictEqual(result.error, null);
+    break;
+  }
+  // return() 在原生线程结束后才 resolve
+  assert.strictEqual(readSchedulerStats().running, 0);
+  assert.ok(readSchedulerStats().admitted - before < inputs.length);
+});
+
+test('readMany：消费者停顿时暂停领取新文件', async () => {
+  const inputs = new Array(48).fill(mediumFixture());
+  const concurrency = 2;
+  const before = readSchedulerStats().admitted;
+  const iterator = readMany(inputs, { concurrency, valuesOnly: true });
+
+  // 不消费结果，等开始的读取数稳定下来（原生线程停在高水位）
+  let started = 0;
+  for (let stable = 0, i = 0; stable < 5 && i < 100; i++) {
+    await new Promise(resolve => setTimeout(resolve, 100));
+    const now = readSchedulerStats().admitted - before;
+    stable = now === started && now >= 16 ? stable + 1 : 0;
+    started = now;
+  }
+  assert.ok(started >= 16, `只开始了 ${started} 个读取`);
+  assert.ok(started <= 16 + 2 * concurrency, `停顿期间开始了 ${started} 个读取`);
+
+  // 消费后恢复，全部完成
+  const seen = new Set();
+  for await (const { index, error } of iterator) {
+    assert.strictEqual(error, null);
+    seen.add(index);
+  }
+  assert.strictEqual(seen.size, inputs.length);
+});
+
+test('readMany：停顿的迭代器不阻止进程退出', () => {
+  // 子进程不消费结果：原生线程停在高水位，tsfn 被 unref，事件循环结束后进程应正常退出
+  const script = `
+    const { readMany } = require(${JSON.stringify(path.resolve(__dirname, '..'))});
+    readMany(new Array(48).fill(${JSON.stringify(mediumFixture())}), { concurrency: 2, valuesOnly: true });
+  `;
+  const child = spawnSync(process.execPath, ['-e', script], { timeout: 60000, encoding: 'utf8' });
+  assert.strictEqual(child.signal, null, '子进程退出超时');
+  assert.strictEqual(child.status, 0, child.stderr);
+});
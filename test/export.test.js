@@ -0,0 +1,125 @@
+/**
+ * toCSV / toNDJSON：原生序列化的结果与 readTableAsJSON 的行一致，字段按 CSV 规则加引号
+ */
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { test } = require('./harness');
+const { fixture, tempDir, people, makePng } = require('./fixtures');
+const { readTableAsJSON, toCSV, toNDJSON } = require('..');
+
+const peopleFixture = () => fixture('export-people', () => ({ sheets: [{ name: 'People', rows: people(30) }] }));
+
+// 需要加引号的字段：分隔符、引号、换行；另有 JSON 需要转义的制表符与反斜杠
+const quotingFixture = () => fixture('export-quoting', () => ({
+  sheets: [{
+    name: 'Quoting',
+    rows: [
+      ['text', 'n'],
+      ['a,b', 1],
+      ['say "hi"', 2],
+      ['line1\nline2', 3],
+      ['semi;colon', 4],
+      ['tab\there \\ 中文', 5]
+    ]
+  }]
+}));
+
+const PNGS = [makePng(6, 1), makePng(9, 2)];
+const imageFixture = () => fixture('export-images', () => ({
+  sheets: [{
+    name: 'Images',
+    rows: [['name', 'picture'], ['a', null], ['b', null]],
+    images: PNGS.map((png, i) => ({ png, from: { col: 1, row: i + 1 }, to: { col: 2, row: i + 2 } }))
+  }]
+}));
+
+// 与原生层相同的加引号规则，用于由 readTableAsJSON 的结果拼出期望的 CSV
+function csvField(text, delimiter = ',') {
+  if (!/["\r\n]/.test(text) && !text.includes(delimiter)) return text;
+  return `"${text.replace(/"/g, '""')}"`;
+}
+
+function expectedCsv(rows, delimiter = ',') {
+  const keys = Object.keys(rows[0]);
+  const lines = [keys, ...rows.map(row => keys.map(key => row[key]))];
+  return lines.map(fields => fields.map(field => csvField(field, delimiter)).join(delimiter) + '\n').join('');
+}
+
+function ndjsonRows(buffer) {
+  const text = buffer.toString('utf8');
+  assert.ok(text.endsWith('\n'));
+  return text.slice(0, -1).split('\n').map(line => JSON.parse(line));
+}
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`CSV 与 readTableAsJSON 的行一致（${mode}）`, () => {
+    const options = { valuesOnly, skipRows: [3, 7], headerMap: { name: '姓名', city: '城市' } };
+    const csv = toCSV(peopleFixture(), options);
+    assert.ok(Buffer.isBuffer(csv));
+    assert.strictEqual(csv.toString('utf8'), expectedCsv(readTableAsJSON(peopleFixture(), options)));
+  });
+
+  test(`NDJSON 与 readTableAsJSON 的行一致（${mode}）`, () => {
+    for (const file of [peopleFixture(), quotingFixture()]) {
+      const options = { valuesOnly, skipRows: [2] };
+      assert.deepStrictEqual(ndjsonRows(toNDJSON(file, options)), readTableAsJSON(file, options));
+    }
+  });
+
+  test(`包含分隔符、引号与换行的字段加引号（${mode}）`, () => {
+    assert.strictEqual(toCSV(quotingFixture(), { valuesOnly }).toString('utf8'),
+      'text,n\n"a,b",1\n"say ""hi""",2\n"line1\nline2",3\nsemi;colon,4\ntab\there \\ 中文,5\n');
+    assert.strictEqual(toCSV(quotingFixture(), { valuesOnly, delimiter: ';', header: false }).toString('utf8'),
+      'a,b;1\n"say ""hi""";2\n"line1\nline2";3\n"semi;colon";4\ntab\there \\ 中文;5\n');
+    assert.strictEqual(toCSV(quotingFixture(), { valuesOnly, delimiter: '\t', header: false }).toString('utf8'),
+      'a,b\t1\n"say ""hi"""\t2\n"line1\nline2"\t3\nsemi;colon\t4\n"tab\there \\ 中文"\t5\n');
+  });
+
+  test(`图片单元格输出图片名或 base64（${mode}）`, () => {
+    const images = readTableAsJSON(imageFixture(), { valuesOnly }).map(row => row.picture);
+
+    assert.strictEqual(toCSV(imageFixture(), { valuesOnly }).toString('utf8'),
+      `name,picture\na,${images[0].name}\nb,${images[1].name}\n`);
+    assert.strictEqual(toCSV(imageFixture(), { valuesOnly, images: 'base64' }).toString('utf8'),
+      'name,picture\n' + PNGS.map((png, i) =>
+        `${'ab'[i]},"data:image/png;base64,${png.toString('base64')}"\n`).join(''));
+
+    for (const mode of ['ref', 'base64']) {
+      ndjsonRows(toNDJSON(imageFixture(), { valuesOnly, images: mode })).forEach((row, i) => {
+        const { data, ...fields } = images[i];
+        assert.ok(data.equals(PNGS[i]));
+        if (mode === 'ref') {
+          assert.deepStrictEqual(row.picture, fields);
+        } else {
+          assert.deepStrictEqual(row.picture, { ...fields, data: PNGS[i].toString('base64') });
+        }
+      });
+    }
+  });
+}
+
+test('写入文件描述符时返回写入的字节数', () => {
+  const dir = tempDir('export');
+  for (const [name, exporter] of [['people.csv', toCSV], ['people.ndjson', toNDJSON]]) {
+    const file = path.join(dir, name);
+    const fd = fs.openSync(file, 'w');
+    let written;
+    try {
+      written = exporter(peopleFixture(), { fd });
+    } finally {
+      fs.closeSync(fd);
+    }
+    const content = fs.readFileSync(file);
+    assert.strictEqual(written, content.length);
+    assert.ok(content.equals(exporter(peopleFixture())));
+  }
+});
+
+test('分隔符必须是单个字符', () => {
+  assert.throws(() => toCSV(peopleFixture(), { delimiter: ';;' }), TypeError);
+  assert.throws(() => toCSV(peopleFixture(), { delimiter: '' }), /delimiter must be a single character/);
+});
@@ -0,0 +1,189 @@
+/**
+ * 行过滤（filter）：在原生层执行，结果与在 JS 中过滤相同
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, personObject } = require('./fixtures');
+const { readTableAsJSON, readTableAsJSONAsync, readPacked, toCSV, openWorkbook, readMany } = require('..');
+
+const COUNT = 60;
+const peopleFixture = () => fixture('filter-people', () => ({ sheets: [{ name: 'People', rows: people(COUNT) }] }));
+
+// 表头在第 2 行，上方为标题行；note 列部分为空
+const titledFixture = () => fixture('filter-titled', () => ({
+  sheets: [{
+    name: 'Titled',
+    rows: [
+      ['人员名单'],
+      ['name', 'score', 'note'],
+      ['a', 10, 'x'],
+      ['b', 25, null],
+      ['c', 7, 'y'],
+      ['d', 40, null],
+      ['e', 25, 'z']
+    ]
+  }]
+}));
+
+function expected(predicate, iso = false) {
+  const rows = [];
+  for (let i = 0; i < COUNT; i++) {
+    const row = personObject(i, iso);
+    if (predicate(row)) rows.push(row);
+  }
+  return rows;
+}
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`eq / in / nonEmpty（${mode}）`, () => {
+    const file = peopleFixture();
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'city', eq: 'Hangzhou' }] }),
+      expected(row => row.city === 'Hangzhou'));
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'city', in: ['Beijing', 'Shenzhen'] }] }),
+      expected(row => row.city === 'Beijing' || row.city === 'Shenzhen'));
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'active', eq: 'false' }] }),
+      expected(row => row.active === 'false'));
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'name', nonEmpty: true }] }),
+      expected(() => true));
+  });
+
+  test(`数值区间按数值比较（${mode}）`, () => {
+    const file = peopleFixture();
+    // 按文本比较时 "9" > "40"，这里必须按数值
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'age', min: 25, max: 40 }] }),
+      expected(row => Number(row.age) >= 25 && Number(row.age) <= 40));
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, filter: [{ column: 'age', max: 21 }] }),
+      expected(row => Number(row.age) <= 21));
+  });
+
+  test(`ISO 日期按文本区间比较（${mode}）`, () => {
+    const file = peopleFixture();
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, dates: 'iso', filter: [{ column: 'joined', min: '2024-01-10', max: '2024-01-31' }] }),
+      expected(row => row.joined >= '2024-01-10' && row.joined <= '2024-01-31', true));
+  });
+
+  test(`多个条件同时满足，列可用索引或映射后的名称（${mode}）`, () => {
+    const file = peopleFixture();
+    const rows = readTableAsJSON(file, {
+      valuesOnly,
+      headerMap: { city: '城市' },
+      filter: [{ column: '城市', eq: 'Shanghai' }, { column: 4, eq: 'true' }, { column: 'age', min: 30 }]
+    });
+    const want = expected(row => row.city === 'Shanghai' && row.active === 'true' && Number(row.age) >= 30)
+      .map(({ city, ...rest }) => ({ name: rest.name, age: rest.age, '城市': city, joined: rest.joined, active: rest.active }));
+    assert.ok(want.length > 0);
+    assert.deepStrictEqual(rows, want);
+  });
+
+  test(`表头不在第一行时按原表行号处理 skipRows（${mode}）`, () => {
+    const file = titledFixture();
+    const rows = readTableAsJSON(file, {
+      valuesOnly,
+      headerRow: 1,
+      skipRows: [0, 6],
+      filter: [{ column: 'score', min: 20 }]
+    });
+    // 标题行不满足条件被过滤，第 6 行（e）被 skipRows 跳过
+    assert.deepStrictEqual(rows, [
+      { name: 'b', score: '25', note: '' },
+      { name: 'd', score: '40', note: '' }
+    ]);
+
+    assert.deepStrictEqual(
+      readTableAsJSON(file, { valuesOnly, headerRow: 1, filter: [{ column: 'note', nonEmpty: true }] })
+        .map(row => row.name),
+      ['a', 'c', 'e']);
+  });
+
+  test(`没有行满足条件时返回空数组（${mode}）`, () => {
+    assert.deepStrictEqual(
+      readTableAsJSON(peopleFixture(), { valuesOnly, filter: [{ column: 'city', eq: 'Paris' }] }), []);
+  });
+
+  test(`未知的列名报错（${mode}）`, () => {
+    assert.throws(
+      () => readTableAsJSON(peopleFixture(), { valuesOnly, filter: [{ column: 'missing', eq: 1 }] }),
+      /missing/);
+  });
+}
+
+test('条件写错时抛出 TypeError 并指出是哪一项', () => {
+  const file = peopleFixture();
+  const cases = [
+    [{ column: 'city', equals: 'Beijing' }, /filter\[0\] has unknown key "equals"/],
+    ['city', /filter\[0\] must be an object/],
+    [{ eq: 'Beijing' }, /filter\[0\]\.column must be a column index >= 0 or a header name/],
+    [{ column: -1, eq: 'Beijing' }, /filter\[0\]\.column must be/],
+    [{ column: 1.5, eq: 'Beijing' }, /filter\[0\]\.column must be/],
+    [{ column: null, eq: 'Beijing' }, /filter\[0\]\.column must be/],
+    [{ column: 'city' }, /filter\[0\] has no condition/],
+    [{ column: 'city', eq: null }, /filter\[0\]\.eq must be a string, number or boolean/],
+    [{ column: 'city', in: [] }, /filter\[0\]\.in must be a non-empty array/],
+    [{ column: 'city', in: 'Beijing' }, /filter\[0\]\.in must be a non-empty array/],
+    [{ column: 'city', in: ['Beijing', {}] }, /filter\[0\]\.in\[1\] must be a string, number or boolean/],
+    [{ column: 'age', min: [1] }, /filter\[0\]\.min must be/],
+    [{ column: 'age', max: {} }, /filter\[0\]\.max must be/],
+    [{ column: 'name', nonEmpty: 'yes' }, /filter\[0\]\.nonEmpty must be a boolean/]
+  ];
+  for (const valuesOnly of [false, true]) {
+    for (const [entry, message] of cases) {
+      assert.throws(() => readTableAsJSON(file, { valuesOnly, filter: [entry] }), err => {
+        assert.ok(err instanceof TypeError, `${JSON.stringify(entry)}: ${err}`);
+        assert.match(err.message, message);
+        return true;
+      });
+    }
+  }
+  // 出错的项按下标报告
+  assert.throws(() => readTableAsJSON(file, { filter: [{ column: 'city', eq: 'Beijing' }, { column: 'age', gte: 30 }] }),
+    /filter\[1\] has unknown key "gte"/);
+  assert.throws(() => readTableAsJSON(file, { filter: { column: 'city', eq: 'Beijing' } }), /filter must be an array/);
+});
+
+test('条件写错时其他读取接口同样报错', async () => {
+  const file = peopleFixture();
+  const filter = [{ column: 'city', equals: 'Beijing' }];
+  await assert.rejects(readTableAsJSONAsync(file, { filter }), TypeError);
+  assert.throws(() => readPacked(file, { filter }), TypeError);
+  assert.throws(() => toCSV(file, { filter }), TypeError);
+  assert.throws(() => openWorkbook(file, { filter }), TypeError);
+  assert.throws(() => readMany([file], { filter }), TypeError);
+});
+
+test('nonEmpty: false 与省略的条件相同', () => {
+  const file = peopleFixture();
+  assert.strictEqual(readTableAsJSON(file, { filter: [{ column: 'name', nonEmpty: false, eq: 'user-3' }] }).length, 1);
+  assert.strictEqual(readTableAsJSON(file, { filter: [{ column: 'name', nonEmpty: false }] }).length, COUNT);
+  assert.strictEqual(readTableAsJSON(file, { filter: [] }).length, COUNT);
+});
+
+test('异步读取使用相同的过滤', async () => {
+  const options = { filter: [{ column: 'city', eq: 'Beijing' }, { column: 'age', min: 30 }] };
+  assert.deepStrictEqual(
+    await readTableAsJSONAsync(peopleFixture(), options),
+    readTableAsJSON(peopleFixture(), options));
+});
+
+test('小数与指数形式的数字按数值比较', () => {
+  const file = fixture('filter-decimals', () => ({
+    sheets: [{ name: 'Decimals', rows: [['k', 'v'], ['a', 2.5], ['b', 1e-7], ['c', 1250.75], ['d', -3.25], ['e', 1e21]] }]
+  }));
+  for (const valuesOnly of [false, true]) {
+    const keys = filter => readTableAsJSON(file, { valuesOnly, filter }).map(row => row.k);
+    assert.deepStrictEqual(keys([{ column: 'v', min: 0, max: 3 }]), ['a', 'b']);
+    assert.deepStrictEqual(keys([{ column: 'v', max: -3.25 }]), ['d']);
+    assert.deepStrictEqual(keys([{ column: 'v', in: [1250.75, 1e21] }]), ['c', 'e']);
+    assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly }).map(row => row.v),
+      ['2.5', '1e-7', '1250.75', '-3.25', '1e+21']);
+  }
+});
@@ -0,0 +1,370 @@
+/**
+ * 测试样本：由 XML 片段直接拼装的小型 .xlsx，不依赖扩展本身的写入器。
+ * 可以构造正常工作簿无法产生的情况：任意 dimension、未转义的实体、伪造的声明大小、高压缩比条目等。
+ * 样本写入系统临时目录，每次运行按名称生成一次。
+ */
+
+const fs = require('fs');
+const path = require('path');
+const os = require('os');
+const zlib = require('zlib');
+
+const FIXTURE_DIR = path.join(os.tmpdir(), `baja-xlsx-test-fixtures-${process.pid}`);
+
+const MAIN_NS = 'http://schemas.openxmlformats.org/spreadsheetml/2006/main';
+const REL_NS = 'http://schemas.openxmlformats.org/officeDocument/2006/relationships';
+const PACKAGE_REL_NS = 'http://schemas.openxmlformats.org/package/2006/relationships';
+const XML_HEADER = '<?xml version="1.0" encoding="UTF-8" standalone="yes"?>\n';
+
+// ---------------------------------------------------------------------------
+// ZIP：存储或 deflate，可伪造中央目录和本地头中的解压后大小
+// ---------------------------------------------------------------------------
+
+const CRC_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+function crc32(buffer) {
+  let crc = 0xFFFFFFFF;
+  for (const byte of buffer) crc = CRC_TABLE[(crc ^ byte) & 0xFF] ^ (crc >>> 8);
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+/**
+ * @param {Array<{name: string, data: Buffer|string, store?: boolean, declaredSize?: number}>} entries
+ *   declaredSize 替换头部记录的解压后大小（用于伪造大小的用例）
+ * @returns {Buffer}
+ */
+function writeZip(entries) {
+  const locals = [];
+  const centrals = [];
+  let offset = 0;
+
+  for (const entry of entries) {
+    const name = Buffer.from(entry.name, 'utf8');
+    const data = Buffer.isBuffer(entry.data) ? entry.data : Buffer.from(entry.data, 'utf8');
+    const body = entry.store ? data : zlib.deflateRawSync(data, { level: 9 });
+    const method = entry.store ? 0 : 8;
+    const crc = crc32(data);
+    const size = entry.declaredSize === undefined ? data.length : entry.declaredSize;
+
+    const local = Buffer.alloc(30);
+    local.writeUInt32LE(0x04034B50, 0);
+    local.writeUInt16LE(20, 4);
+    local.writeUInt16LE(0x0800, 6);          // 文件名为 UTF-8
+    local.writeUInt16LE(method, 8);
+    local.writeUInt32LE(crc, 14);
+    local.writeUInt32LE(body.length, 18);
+    local.writeUInt32LE(size, 22);
+    local.writeUInt16LE(name.length, 26);
+    locals.push(local, name, body);
+
+    const central = Buffer.alloc(46);
+    central.writeUInt32LE(0x02014B50, 0);
+    central.writeUInt16LE(20, 4);
+    central.writeUInt16LE(20, 6);
+    central.writeUInt16LE(0x0800, 8);
+    central.writeUInt16LE(method, 10);
+    central.writeUInt32LE(crc, 16);
+    central.writeUInt32LE(body.length, 20);
+    central.writeUInt32LE(size, 24);
+    central.writeUInt16LE(name.length, 28);
+    central.writeUInt32LE(offset, 42);
+    centrals.push(central, name);
+
+    offset += local.length + name.length + body.length;
+  }
+
+  const directory = Buffer.concat(centrals);
+  const end = Buffer.alloc(22);
+  end.writeUInt32LE(0x06054B50, 0);
+  end.writeUInt16LE(entries.length, 8);
+  end.writeUInt16LE(entries.length, 10);
+  end.writeUInt32LE(directory.length, 12);
+  end.writeUInt32LE(offset, 16);
+  return Buffer.concat([...locals, directory, end]);
+}
+
+// ---------------------------------------------------------------------------
+// PNG：size x size 的 RGB 图片，像素由 seed 决定
+// ---------------------------------------------------------------------------
+
+function pngChunk(type, data) {
+  const length = Buffer.alloc(4);
+  length.writeUInt32BE(data.length);
+  const body = Buffer.concat([Buffer.from(type, 'ascii'), data]);
+  const crc = Buffer.alloc(4);
+  crc.writeUInt32BE(crc32(body));
+  return Buffer.concat([length, body, crc]);
+}
+
+function makePng(size, seed) {
+  let state = seed >>> 0;
+  const raw = Buffer.alloc((size * 3 + 1) * size);
+  for (let y = 0; y < size; y++) {
+    const row = y * (size * 3 + 1);
+    for (let x = 0; x < size * 3; x++) {
+      state = (Math.imul(state, 1664525) + 1013904223) >>> 0;
+      raw[row + 1 + x] = state >>> 24;
+    }
+  }
+  const header = Buffer.alloc(13);
+  header.writeUInt32BE(size, 0);
+  header.writeUInt32BE(size, 4);
+  header[8] = 8;   // bit depth
+  header[9] = 2;   // RGB
+  return Buffer.concat([
+    Buffer.from([0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A]),
+    pngChunk('IHDR', header),
+    pngChunk('IDAT', zlib.deflateSync(raw)),
+    pngChunk('IEND', Buffer.alloc(0))
+  ]);
+}
+
+// ---------------------------------------------------------------------------
+// 工作簿
+// ---------------------------------------------------------------------------
+
+function escapeXml(text) {
+  return String(text).replace(/&/g, '&amp;').replace(/</g, '&lt;').replace(/>/g, '&gt;').replace(/"/g, '&quot;');
+}
+
+// "A", "B", ..., "Z", "AA", ... 对应从0开始的列号
+function columnName(col) {
+  let name = '';
+  for (let n = col + 1; n > 0; n = Math.floor((n - 1) / 26)) {
+    name = String.fromCharCode(65 + (n - 1) % 26) + name;
+  }
+  return name;
+}
+
+/**
+ * 单元格取值：
+ *   string → 共享字符串；number；boolean；null/undefined → 空单元格
+ *   { date: serial } → 日期格式（numFmtId 14）的数字
+ *   { xml: '...' } → 原样写入共享字符串的 <t> 内容（用于未转义的实体）
+ */
+function cellXml(ref, value, strings) {
+  if (value === null || value === undefined) return '';
+  const r = ref ? ` r="${ref}"` : '';
+  if (typeof value === 'number') return `<c${r}><v>${value}</v></c>`;
+  if (typeof value === 'boolean') return `<c${r} t="b"><v>${value ? 1 : 0}</v></c>`;
+  if (typeof value === 'object' && 'date' in value) return `<c${r} s="1"><v>${value.date}</v></c>`;
+  const text = typeof value === 'object' ? value.xml : escapeXml(value);
+  let index = strings.get(text);
+  if (index === undefined) {
+    index = strings.size;
+    strings.set(text, index);
+  }
+  return `<c${r} t="s"><v>${index}</v></c>`;
+}
+
+/**
+ * 拼装 .xlsx
+ * @param {Object} spec
+ * @param {Array<Object>} spec.sheets - 每项 { name, rows, startRow?, startCol?, dimension?, nameXml?, omitRefs?, images? }：
+ *   rows 为二维数组，从第 startRow 行（默认1）、第 startCol 列（从0开始，默认0）写起；nameXml 原样写入 workbook.xml 的 name 属性；
+ *   omitRefs 为 true 时 <row> 与 <c> 不写 r 属性，行列号由位置决定（此时不能有空单元格）；
+ *   images 为 [{ png, from: {col, row, colOff?, rowOff?}, to: {...} }]（行列从0开始）
+ * @param {Object<string, number>} [spec.declaredSizes] - 按条目名伪造解压后大小
+ * @param {Array<{name: string, data: Buffer|string}>} [spec.extraEntries] - 额外条目
+ * @returns {Buffer}
+ */
+function buildWorkbook(spec) {
+  const strings = new Map();
+  const entries = [];
+  const media = [];
+  const contentTypes = [];
+  const workbookSheets = [];
+  const workbookRels = [];
+
+  spec.sheets.forEach((sheet, index) => {
+    const n = index + 1;
+    const startRow = sheet.startRow || 1;
+    let xml = `${XML_HEADER}<worksheet xmlns="${MAIN_NS}" xmlns:r="${REL_NS}">`;
+    if (sheet.dimension) xml += `<dimension ref="${sheet.dimension}"/>`;
+    xml += '<sheetData>';
+    sheet.rows.forEach((row, r) => {
+      const rowNumber = startRow + r;
+      xml += sheet.omitRefs ? '<row>' : `<row r="${rowNumber}">`;
+      row.forEach((value, c) => {
+        xml += cellXml(sheet.omitRefs ? null : `${columnName((sheet.startCol || 0) + c)}${rowNumber}`, value, strings);
+      });
+      xml += '</row>';
+    });
+    xml += '</sheetData>';
+
+    const images = sheet.images || [];
+    if (images.length > 0) {
+      xml += '<drawing r:id="rId1"/>';
+      let drawing = `${XML_HEADER}<xdr:wsDr xmlns:xdr="http://schemas.openxmlformats.org/drawingml/2006/spreadsheetDrawing"` +
+        ` xmlns:a="http://schemas.openxmlformats.org/drawingml/2006/main" xmlns:r="${REL_NS}">`;
+      let drawingRels = `${XML_HEADER}<Relationships xmlns="${PACKAGE_REL_NS}">`;
+      images.forEach((image, i) => {
+        media.push(image.png);
+        const marker = (tag, at) => `<xdr:${tag}><xdr:col>${at.col}</xdr:col><xdr:colOff>${at.colOff || 0}</xdr:colOff>` +
+          `<xdr:row>${at.row}</xdr:row><xdr:rowOff>${at.rowOff || 0}</xdr:rowOff></xdr:${tag}>`;
+        drawing += '<xdr:twoCellAnchor editAs="oneCell">' + marker('from', image.from) + marker('to', image.to) +
+          `<xdr:pic><xdr:nvPicPr><xdr:cNvPr id="${i + 2}" name="Picture ${i + 1}"/><xdr:cNvPicPr/></xdr:nvPicPr>` +
+          `<xdr:blipFill><a:blip r:embed="rId${i + 1}"/><a:stretch><a:fillRect/></a:stretch></xdr:blipFill>` +
+          '<xdr:spPr><a:prstGeom prst="rect"><a:avLst/></a:prstGeom></xdr:spPr></xdr:pic><xdr:clientData/></xdr:twoCellAnchor>';
+        drawingRels += `<Relationship Id="rId${i + 1}" Type="${REL_NS}/image" Target="../media/image${media.length}.png"/>`;
+      });
+      drawing += '</xdr:wsDr>';
+      drawingRels += '</Relationships>';
+      entries.push(
+        { name: `xl/worksheets/_rels/sheet${n}.xml.rels`, data: `${XML_HEADER}<Relationships xmlns="${PACKAGE_REL_NS}">` +
+          `<Relationship Id="rId1" Type="${REL_NS}/drawing" Target="../drawings/drawing${n}.xml"/></Relationships>` },
+        { name: `xl/drawings/drawing${n}.xml`, data: drawing },
+        { name: `xl/drawings/_rels/drawing${n}.xml.rels`, data: drawingRels }
+      );
+      contentTypes.push(`<Override PartName="/xl/drawings/drawing${n}.xml" ContentType="application/vnd.openxmlformats-officedocument.drawing+xml"/>`);
+    }
+    xml += '</worksheet>';
+
+    entries.push({ name: `xl/worksheets/sheet${n}.xml`, data: xml });
+    contentTypes.push(`<Override PartName="/xl/worksheets/sheet${n}.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"/>`);
+    workbookSheets.push(`<sheet name="${sheet.nameXml || escapeXml(sheet.name)}" sheetId="${n}" r:id="rId${n}"/>`);
+    workbookRels.push(`<Relationship Id="rId${n}" Type="${REL_NS}/worksheet" Target="worksheets/sheet${n}.xml"/>`);
+  });
+
+  const count = spec.sheets.length;
+  workbookRels.push(
+    `<Relationship Id="rId${count + 1}" Type="${REL_NS}/styles" Target="styles.xml"/>`,
+    `<Relationship Id="rId${count + 2}" Type="${REL_NS}/sharedStrings" Target="sharedStrings.xml"/>`
+  );
+
+  let sharedStrings = `${XML_HEADER}<sst xmlns="${MAIN_NS}" count="${strings.size}" uniqueCount="${strings.size}">`;
+  for (const text of strings.keys()) sharedStrings += `<si><t xml:space="preserve">${text}</t></si>`;
+  sharedStrings += '</sst>';
+
+  // 样式 0 为常规，样式 1 为日期（内置 numFmtId 14）
+  const styles = `${XML_HEADER}<styleSheet xmlns="${MAIN_NS}">` +
+    '<fonts count="1"><font><sz val="11"/><name val="Calibri"/></font></fonts>' +
+    '<fills count="2"><fill><patternFill patternType="none"/></fill><fill><patternFill patternType="gray125"/></fill></fills>' +
+    '<borders count="1"><border><left/><right/><top/><bottom/><diagonal/></border></borders>' +
+    '<cellStyleXfs count="1"><xf numFmtId="0" fontId="0" fillId="0" borderId="0"/></cellStyleXfs>' +
+    '<cellXfs count="2"><xf numFmtId="0" fontId="0" fillId="0" borderId="0" xfId="0"/>' +
+    '<xf numFmtId="14" fontId="0" fillId="0" borderId="0" xfId="0" applyNumberFormat="1"/></cellXfs>' +
+    '<cellStyles count="1"><cellStyle name="Normal" xfId="0" builtinId="0"/></cellStyles>' +
+    '</styleSheet>';
+
+  const head = [
+    { name: '[Content_Types].xml', data: `${XML_HEADER}<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">` +
+      '<Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>' +
+      '<Default Extension="xml" ContentType="application/xml"/>' +
+      '<Default Extension="png" ContentType="image/png"/>' +
+      '<Override PartName="/xl/workbook.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"/>' +
+      '<Override PartName="/xl/styles.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml"/>' +
+      '<Override PartName="/xl/sharedStrings.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml"/>' +
+      contentTypes.join('') + '</Types>' },
+    { name: '_rels/.rels', data: `${XML_HEADER}<Relationships xmlns="${PACKAGE_REL_NS}">` +
+      `<Relationship Id="rId1" Type="${REL_NS}/officeDocument" Target="xl/workbook.xml"/></Relationships>` },
+    { name: 'xl/workbook.xml', data: `${XML_HEADER}<workbook xmlns="${MAIN_NS}" xmlns:r="${REL_NS}"><sheets>` +
+      workbookSheets.join('') + '</sheets></workbook>' },
+    { name: 'xl/_rels/workbook.xml.rels', data: `${XML_HEADER}<Relationships xmlns="${PACKAGE_REL_NS}">` +
+      workbookRels.join('') + '</Relationships>' },
+    { name: 'xl/styles.xml', data: styles },
+    { name: 'xl/sharedStrings.xml', data: sharedStrings }
+  ];
+
+  // 图片已经是压缩格式，按存储写入
+  const mediaEntries = media.map((png, i) => ({ name: `xl/media/image${i + 1}.png`, data: png, store: true }));
+
+  const all = [...head, ...entries, ...mediaEntries, ...(spec.extraEntries || [])];
+  const declared = spec.declaredSizes || {};
+  for (const entry of all) {
+    if (entry.name in declared) entry.declaredSize = declared[entry.name];
+  }
+  return writeZip(all);
+}
+
+const written = new Map();
+
+/**
+ * 生成（或复用本次运行已生成的）样本文件
+ * @param {string} name - 样本名称
+ * @param {function(): Object} spec - 返回 buildWorkbook 的参数
+ * @returns {string} 文件路径
+ */
+function fixture(name, spec) {
+  if (!written.has(name)) {
+    fs.mkdirSync(FIXTURE_DIR, { recursive: true });
+    const file = path.join(FIXTURE_DIR, `${name}.xlsx`);
+    fs.writeFileSync(file, buildWorkbook(spec()));
+    written.set(name, file);
+  }
+  return written.get(name);
+}
+
+/** 删除本次运行生成的样本 */
+function removeFixtures() {
+  fs.rmSync(FIXTURE_DIR, { recursive: true, force: true });
+  written.clear();
+}
+
+/** 每次调用返回一个新的空临时目录（缓存目录等） */
+function tempDir(prefix) {
+  fs.mkdirSync(FIXTURE_DIR, { recursive: true });
+  return fs.mkdtempSync(path.join(FIXTURE_DIR, `${prefix}-`));
+}
+
+// ---------------------------------------------------------------------------
+// 常用样本
+// ---------------------------------------------------------------------------
+
+const PEOPLE_HEADER = ['name', 'age', 'city', 'joined', 'active'];
+const CITIES = ['Beijing', 'Shanghai', 'Shenzhen', 'Hangzhou'];
+
+/** 第 i 个人（i 从0开始），joined 为 2024-01-01 起的日期序列号 */
+function person(i) {
+  return [`user-${i}`, 20 + (i % 30), CITIES[i % CITIES.length], { date: 45292 + i }, i % 3 !== 0];
+}
+
+/** 表头加 count 行人员数据 */
+function people(count) {
+  const rows = [PEOPLE_HEADER];
+  for (let i = 0; i < count; i++) rows.push(person(i));
+  return rows;
+}
+
+/** 45292 + i 对应的 ISO 日期 */
+function isoDate(i) {
+  return new Date(Date.UTC(2024, 0, 1 + i)).toISOString().slice(0, 10);
+}
+
+/** 第 i 个人读取后的单元格文本；iso 为 true 时日期为 ISO 字符串（dates: 'iso'） */
+function personText(i, iso = false) {
+  const [name, age, city, joined, active] = person(i);
+  return [name, String(age), city, iso ? isoDate(i) : String(joined.date), String(active)];
+}
+
+/** person(i) 转换为 readTableAsJSON 的行对象 */
+function personObject(i, iso = false) {
+  const text = personText(i, iso);
+  return Object.fromEntries(PEOPLE_HEADER.map((key, col) => [key, text[col]]));
+}
+
+module.exports = {
+  FIXTURE_DIR,
+  writeZip,
+  makePng,
+  columnName,
+  buildWorkbook,
+  fixture,
+  removeFixtures,
+  tempDir,
+  PEOPLE_HEADER,
+  CITIES,
+  person,
+  people,
+  isoDate,
+  personText,
+  personObject
+};
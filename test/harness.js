@@ -0,0 +1,22 @@
+/**
+ * 极简测试注册：各 *.test.js 通过 test(name, fn) 注册用例，由 test/test.js 依次运行。
+ * 不依赖 node:test（engines 要求 Node >= 16）
+ */
+
+const cases = [];
+let currentFile = null;
+
+/**
+ * 注册一个用例，fn 可以返回 Promise
+ * @param {string} name
+ * @param {function(): (void|Promise<void>)} fn
+ */
+function test(name, fn) {
+  cases.push({ file: currentFile, name, fn });
+}
+
+function setCurrentFile(file) {
+  currentFile = file;
+}
+
+module.exports = { test, cases, setCurrentFile };
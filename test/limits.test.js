@@ -0,0 +1,113 @@
+/**
+ * 资源限制（limits）：解压前按 ZIP 目录拒绝，读取时不按声明大小分配
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, makePng } = require('./fixtures');
+const { readTableAsJSON, readTableAsJSONAsync, readPacked, openWorkbook, toCSV } = require('..');
+
+const LIMIT_ERROR = /^Read limit exceeded: /;
+
+// 11 行 x 5 列 = 55 个单元格，3 张图片
+const smallFixture = () => fixture('limits-small', () => ({
+  sheets: [{
+    name: 'People',
+    rows: people(10),
+    images: [0, 1, 2].map(i => ({ png: makePng(8, 20 + i), from: { col: 6, row: i * 3 }, to: { col: 7, row: i * 3 + 2 } }))
+  }]
+}));
+
+// 额外条目为 4 MB 的 0，压缩比远超 100:1
+const bombFixture = () => fixture('limits-bomb', () => ({
+  sheets: [{ name: 'People', rows: people(10) }],
+  extraEntries: [{ name: 'xl/padding.bin', data: Buffer.alloc(4 * 1024 * 1024) }]
+}));
+
+// 图片条目声明解压后为 4 GB（实际只有几十字节）
+const forgedFixture = () => fixture('limits-forged', () => ({
+  sheets: [{
+    name: 'People',
+    rows: people(10),
+    images: [{ png: makePng(4, 30), from: { col: 6, row: 0 }, to: { col: 7, row: 2 } }]
+  }],
+  declaredSizes: { 'xl/media/image1.png': 0xFFFFFFF0 }
+}));
+
+// 所有读取接口对同一限制给出相同的错误
+const READERS = {
+  readTableAsJSON: (file, options) => readTableAsJSON(file, options),
+  'readTableAsJSON(valuesOnly)': (file, options) => readTableAsJSON(file, { ...options, valuesOnly: true }),
+  readPacked: (file, options) => readPacked(file, options),
+  toCSV: (file, options) => toCSV(file, options),
+  openWorkbook: (file, options) => {
+    const wb = openWorkbook(file, options);
+    try {
+      return wb.readRows(null, 0, 100);
+    } finally {
+      wb.close();
+    }
+  }
+};
+
+for (const [name, read] of Object.entries(READERS)) {
+  test(`maxCells（${name}）`, () => {
+    assert.throws(() => read(smallFixture(), { limits: { maxCells: 54 } }), err => {
+      assert.match(err.message, LIMIT_ERROR);
+      assert.match(err.message, /maxCells 54/);
+      return true;
+    });
+    read(smallFixture(), { limits: { maxCells: 55 } });
+  });
+
+  test(`maxEntrySize 与 maxUncompressedSize（${name}）`, () => {
+    assert.throws(() => read(smallFixture(), { limits: { maxEntrySize: 1024 } }), /^Error: Read limit exceeded: .* \(maxEntrySize 1024\)/);
+    assert.throws(() => read(smallFixture(), { limits: { maxUncompressedSize: 4096 } }), /^Error: Read limit exceeded: .*maxUncompressedSize/);
+    read(smallFixture(), { limits: { maxEntrySize: 1024 * 1024, maxUncompressedSize: 1024 * 1024 } });
+  });
+
+  test(`maxCompressionRatio（${name}）`, () => {
+    assert.throws(() => read(bombFixture(), { limits: { maxCompressionRatio: 100 } }),
+      /^Error: Read limit exceeded: xl\/padding\.bin has compression ratio/);
+    read(bombFixture(), {});
+  });
+}
+
+test('maxImages', () => {
+  assert.throws(() => readTableAsJSON(smallFixture(), { limits: { maxImages: 2 } }), /^Error: Read limit exceeded: more than 2 images/);
+  assert.strictEqual(readTableAsJSON(smallFixture(), { limits: { maxImages: 3 } }).imagePositions.length, 3);
+});
+
+test('异步读取以相同的错误拒绝', async () => {
+  await assert.rejects(readTableAsJSONAsync(smallFixture(), { limits: { maxCells: 10 } }), err => {
+    assert.match(err.message, LIMIT_ERROR);
+    assert.notStrictEqual(err.name, 'AbortError');
+    return true;
+  });
+});
+
+test('伪造的声明大小按限制拒绝', () => {
+  assert.throws(() => readTableAsJSON(forgedFixture(), { limits: { maxEntrySize: 64 * 1024 * 1024 } }),
+    /^Error: Read limit exceeded: xl\/media\/image1\.png inflates to 4294967280 bytes/);
+  assert.throws(() => readTableAsJSON(forgedFixture(), { limits: { maxUncompressedSize: 1024 * 1024 * 1024 } }),
+    /^Error: Read limit exceeded: archive inflates to more than/);
+});
+
+test('没有限制时不按伪造的声明大小分配内存', () => {
+  const before = process.memoryUsage().rss;
+  // 声明大小与实际数据不符：读取失败或跳过该图片都可以，但不能预留 4 GB。
+  // valuesOnly 时图片由本扩展自己的 ZIP 读取代码解压，不经过 xlnt
+  try {
+    readTableAsJSON(forgedFixture(), { valuesOnly: true });
+  } catch (err) {
+    assert.ok(err instanceof Error);
+  }
+  const grown = process.memoryUsage().rss - before;
+  assert.ok(grown < 512 * 1024 * 1024, `RSS 增长了 ${grown} 字节`);
+});
+
+test('默认不限制', () => {
+  assert.strictEqual(readTableAsJSON(smallFixture()).length, 10);
+  assert.strictEqual(readTableAsJSON(smallFixture(), { limits: {} }).length, 10);
+  assert.strictEqual(readTableAsJSON(smallFixture(), { limits: { maxCells: 0, maxImages: 0 } }).length, 10);
+});
@@ -0,0 +1,155 @@
+/**
+ * 图片数据：解压时计算的 XXH64 / SHA-256、文件头识别的格式与尺寸、knownHashes
+ */
+
+const assert = require('assert');
+const crypto = require('crypto');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const { test } = require('./harness');
+const { fixture, makePng } = require('./fixtures');
+const { readTableAsJSON, readPacked, PackedWorkbook } = require('..');
+
+// XXH64（seed 0）的 JS 参考实现，用于核对原生层的结果
+const MASK = (1n << 64n) - 1n;
+const P1 = 0x9E3779B185EBCA87n;
+const P2 = 0xC2B2AE3D27D4EB4Fn;
+const P3 = 0x165667B19E3779F9n;
+const P4 = 0x85EBCA77C2B2AE63n;
+const P5 = 0x27D4EB2F165667C5n;
+const rotl = (x, r) => ((x << BigInt(r)) | (x >> BigInt(64 - r))) & MASK;
+const round = (acc, lane) => (rotl((acc + lane * P2) & MASK, 31) * P1) & MASK;
+
+function xxh64(bytes) {
+  let p = 0;
+  let h = P5;
+  if (bytes.length >= 32) {
+    const v = [(P1 + P2) & MASK, P2, 0n, (0n - P1) & MASK];
+    for (; p + 32 <= bytes.length; p += 32) {
+      for (let k = 0; k < 4; k++) v[k] = round(v[k], bytes.readBigUInt64LE(p + k * 8));
+    }
+    h = (rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18)) & MASK;
+    for (const lane of v) h = (((h ^ round(0n, lane)) * P1) + P4) & MASK;
+  }
+  h = (h + BigInt(bytes.length)) & MASK;
+  for (; p + 8 <= bytes.length; p += 8) {
+    h = ((rotl(h ^ round(0n, bytes.readBigUInt64LE(p)), 27) * P1) + P4) & MASK;
+  }
+  if (p + 4 <= bytes.length) {
+    h = ((rotl(h ^ ((BigInt(bytes.readUInt32LE(p)) * P1) & MASK), 23) * P2) + P3) & MASK;
+    p += 4;
+  }
+  for (; p < bytes.length; p++) {
+    h = (rotl(h ^ ((BigInt(bytes[p]) * P5) & MASK), 11) * P1) & MASK;
+  }
+  h = ((h ^ (h >> 33n)) * P2) & MASK;
+  h = ((h ^ (h >> 29n)) * P3) & MASK;
+  return (h ^ (h >> 32n)).toString(16).padStart(16, '0');
+}
+
+const sha256 = bytes => crypto.createHash('sha256').update(bytes).digest('hex');
+
+// 12 张大小不同的图片：超过 4 张时原生层按多线程解压
+const PNGS = Array.from({ length: 12 }, (_, i) => makePng(2 + i * 3, 40 + i));
+const mediaFixture = () => fixture('media', () => ({
+  sheets: [{
+    name: 'Media',
+    rows: [['name', 'picture'], ...PNGS.map((_, i) => [`p${i}`, null])],
+    images: PNGS.map((png, i) => ({ png, from: { col: 1, row: i + 1 }, to: { col: 2, row: i + 2 } }))
+  }]
+}));
+
+function imagesByName(file, options) {
+  const wb = new PackedWorkbook(readPacked(file, options));
+  return new Map(wb.images.map(image => [image.name, image]));
+}
+
+test('XXH64 参考实现与已知值一致', () => {
+  assert.strictEqual(xxh64(Buffer.alloc(0)), 'ef46db3751d8e999');
+  assert.strictEqual(xxh64(Buffer.from('abc')), '44bc2cf5ad770999');
+});
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`哈希、格式与尺寸（${mode}）`, () => {
+    const images = imagesByName(mediaFixture(), { valuesOnly });
+    assert.strictEqual(images.size, PNGS.length);
+    PNGS.forEach((png, i) => {
+      const image = images.get(`image${i + 1}.png`);
+      assert.ok(image.data.equals(png));
+      assert.strictEqual(image.hash, xxh64(png));
+      assert.strictEqual(image.sha256, undefined);
+      assert.strictEqual(image.type, 'image/png');
+      assert.strictEqual(image.width, 2 + i * 3);
+      assert.strictEqual(image.height, 2 + i * 3);
+    });
+  });
+
+  test(`sha256: true 时另算 SHA-256（${mode}）`, () => {
+    const images = imagesByName(mediaFixture(), { valuesOnly, sha256: true });
+    PNGS.forEach((png, i) => {
+      const image = images.get(`image${i + 1}.png`);
+      assert.strictEqual(image.hash, xxh64(png));
+      assert.strictEqual(image.sha256, sha256(png));
+    });
+  });
+
+  test(`单元格中的图片对象带有相同的哈希（${mode}）`, () => {
+    const rows = readTableAsJSON(mediaFixture(), { valuesOnly, sha256: true });
+    rows.forEach((row, i) => {
+      assert.strictEqual(row.picture.hash, xxh64(PNGS[i]));
+      assert.strictEqual(row.picture.sha256, sha256(PNGS[i]));
+    });
+  });
+
+  test(`knownHashes 中的图片不返回数据（${mode}）`, () => {
+    const known = [xxh64(PNGS[0]), xxh64(PNGS[5]), 'ffffffffffffffff'];
+    const rows = readTableAsJSON(mediaFixture(), { valuesOnly, knownHashes: known });
+    rows.forEach((row, i) => {
+      if (i === 0 || i === 5) {
+        assert.strictEqual(row.picture.known, true);
+        assert.strictEqual(row.picture.data, null);
+        assert.strictEqual(row.picture.hash, xxh64(PNGS[i]));
+      } else {
+        assert.strictEqual(row.picture.known, undefined);
+        assert.ok(row.picture.data.equals(PNGS[i]));
+      }
+    });
+  });
+}
+
+// 依赖 sh 的 ulimit
+if (process.platform !== 'win32') {
+  test('文件描述符不足时不丢失图片', () => {
+    // 子进程先占满文件描述符，再逐个释放：读取要么因打不开文件而失败，
+    // 要么返回全部图片（解压线程打不开自己的句柄时由调用线程补读）
+    const script = `
+      const fs = require('fs');
+      const { readPacked, PackedWorkbook } = require(${JSON.stringify(path.resolve(__dirname, '..'))});
+      const held = [];
+      try {
+        for (;;) held.push(fs.openSync(${JSON.stringify(__filename)}, 'r'));
+      } catch (err) {}
+      const counts = [];
+      for (let free = 0; free < 16 && held.length > 0; free++) {
+        fs.closeSync(held.pop());
+        try {
+          counts.push(new PackedWorkbook(readPacked(${JSON.stringify(mediaFixture())})).images.length);
+        } catch (err) {
+          counts.push(null);
+        }
+      }
+      held.forEach(fd => fs.closeSync(fd));
+      console.log(JSON.stringify(counts));
+    `;
+    const child = spawnSync('sh', ['-c', 'ulimit -n 256 && exec "$0" -e "$1"', process.execPath, script],
+      { timeout: 60000, encoding: 'utf8' });
+    assert.strictEqual(child.status, 0, child.stderr);
+    const counts = JSON.parse(child.stdout);
+    assert.ok(counts.some(count => count !== null), `读取全部失败：${child.stdout}`);
+    for (const count of counts) {
+      if (count !== null) assert.strictEqual(count, PNGS.length);
+    }
+  });
+}
@@ -0,0 +1,58 @@
+/**
+ * 数字单元格的文本：最短且能读回原值，与 JavaScript 的 String(number) 相同
+ */
+
+const assert = require('assert');
+const path = require('path');
+const { test } = require('./harness');
+const { fixture, tempDir } = require('./fixtures');
+const { readTableAsJSON, readPacked, PackedWorkbook, toCSV, createWriter } = require('..');
+
+const VALUES = [
+  0, -0, 1, -25, 2 ** 53, 2 ** 53 + 2, -(2 ** 53) - 2, 123456789012, 1e20, 123456789012345680000, 1e21,
+  0.1, 0.30000000000000004, 1 / 3, -2 / 3, 123456.789, 1.5, 100.25,
+  0.000001, 0.0000015, 1e-7, -1.5e-7, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 1.2345e25
+];
+
+const numbersFixture = () => fixture('numbers', () => ({
+  sheets: [{ name: 'Numbers', rows: [['v'], ...VALUES.map(value => [value])] }]
+}));
+
+const EXPECTED = VALUES.map(value => String(value));
+
+test('期望文本就是 JavaScript 的 String(number)', () => {
+  assert.deepStrictEqual(EXPECTED.slice(0, 3), ['0', '0', '1']);
+  assert.ok(EXPECTED.includes('1e+21') && EXPECTED.includes('1e-7') && EXPECTED.includes('0.000001'));
+  EXPECTED.forEach((text, i) => assert.strictEqual(Number(text), VALUES[i] === 0 ? 0 : VALUES[i]));
+});
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`读取的数字文本最短且可读回（${mode}）`, () => {
+    assert.deepStrictEqual(readTableAsJSON(numbersFixture(), { valuesOnly }).map(row => row.v), EXPECTED);
+  });
+
+  test(`列类型推断时数字文本不变（${mode}）`, () => {
+    const rows = readTableAsJSON(numbersFixture(), { valuesOnly, schemaRows: VALUES.length });
+    assert.strictEqual(rows.schema[0].type, 'number');
+    assert.deepStrictEqual(rows.map(row => row.v), EXPECTED);
+  });
+
+  test(`readPacked 与 toCSV 使用相同的文本（${mode}）`, () => {
+    const sheet = new PackedWorkbook(readPacked(numbersFixture(), { valuesOnly })).sheet();
+    assert.deepStrictEqual(VALUES.map((_, i) => sheet.cell(i + 1, 0)), EXPECTED);
+    assert.strictEqual(toCSV(numbersFixture(), { valuesOnly }).toString('utf8'), ['v', ...EXPECTED].join('\n') + '\n');
+  });
+}
+
+test('写入的数字读回为相同的文本', () => {
+  const file = path.join(tempDir('numbers'), 'written.xlsx');
+  const writer = createWriter(file);
+  writer.writeRow(['v']);
+  for (const value of VALUES) writer.writeRow([value]);
+  writer.close();
+  for (const valuesOnly of [false, true]) {
+    assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly }).map(row => row.v), EXPECTED);
+  }
+});
@@ -0,0 +1,152 @@
+/**
+ * readPacked / PackedWorkbook：打包布局与读取视图
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, makePng, personText, PEOPLE_HEADER } = require('./fixtures');
+const { readPacked, readTableAsJSON, PackedWorkbook } = require('..');
+
+const LOGO = makePng(16, 7);
+
+const packedFixture = () => fixture('packed', () => ({
+  sheets: [
+    {
+      name: 'People',
+      rows: people(30),
+      images: [{ png: LOGO, from: { col: 6, row: 2 }, to: { col: 8, row: 5 } }]
+    },
+    { name: '第二页', rows: [['a', 'b'], [1, 2], ['x', null, 'wide']] }
+  ]
+}));
+
+test('头部：魔数、版本与各段偏移', () => {
+  const buffer = readPacked(packedFixture(), { valuesOnly: true });
+  assert.ok(buffer instanceof ArrayBuffer);
+
+  const header = new DataView(buffer, 0, 32);
+  const field = index => header.getUint32(index * 4, true);
+  assert.strictEqual(field(0), 0x4B505842);
+  assert.strictEqual(field(1), 1);
+
+  const [metaOffset, metaLength, cellsOffset, textOffset, mediaOffset, totalLength] =
+    [field(2), field(3), field(4), field(5), field(6), field(7)];
+  assert.ok(metaOffset >= 32);
+  assert.ok(metaOffset + metaLength <= cellsOffset);
+  assert.strictEqual(cellsOffset % 4, 0);
+  assert.strictEqual((textOffset - cellsOffset) % 4, 0);
+  assert.ok(textOffset <= mediaOffset);
+  assert.ok(mediaOffset + LOGO.length <= totalLength);
+  assert.strictEqual(totalLength, buffer.byteLength);
+
+  // 元数据为 JSON
+  const meta = JSON.parse(Buffer.from(buffer, metaOffset, metaLength).toString('utf8'));
+  assert.deepStrictEqual(meta.sheets.map(sheet => sheet.name), ['People', '第二页']);
+});
+
+for (const valuesOnly of [false, true]) {
+  test(`单元格与 readTableAsJSON 一致（valuesOnly: ${valuesOnly}）`, () => {
+    const file = packedFixture();
+    const wb = new PackedWorkbook(readPacked(file, { valuesOnly, dates: 'iso' }));
+    assert.deepStrictEqual(wb.sheetNames(), ['People', '第二页']);
+
+    const sheet = wb.sheet('People');
+    assert.strictEqual(sheet.rowCount, 31);
+    assert.ok(sheet.columnCount >= PEOPLE_HEADER.length);
+    assert.deepStrictEqual(sheet.row(0).slice(0, 5), PEOPLE_HEADER);
+    for (let i = 0; i < 30; i++) {
+      assert.deepStrictEqual(sheet.row(i + 1).slice(0, 5), personText(i, true));
+    }
+
+    const table = readTableAsJSON(file, { valuesOnly, dates: 'iso' });
+    table.forEach((row, i) => {
+      PEOPLE_HEADER.forEach((key, col) => assert.strictEqual(sheet.cell(i + 1, col), row[key]));
+    });
+
+    // 每行按最宽的行补齐，越界访问返回空字符串
+    const second = wb.sheet('第二页');
+    assert.strictEqual(second.columnCount, 3);
+    assert.deepStrictEqual(second.row(1), ['1', '2', '']);
+    assert.deepStrictEqual(second.row(2), ['x', '', 'wide']);
+    assert.strictEqual(second.cell(3, 0), '');
+    assert.strictEqual(second.cell(0, 3), '');
+    assert.strictEqual(second.cell(-1, 0), '');
+  });
+}
+
+test('图片数据是 buffer 内的视图', () => {
+  const buffer = readPacked(packedFixture());
+  const wb = new PackedWorkbook(buffer);
+
+  assert.strictEqual(wb.images.length, 1);
+  const image = wb.images[0];
+  assert.ok(image.data.equals(LOGO));
+  assert.strictEqual(image.data.buffer, buffer);
+  assert.strictEqual(image.width, 16);
+  assert.strictEqual(image.height, 16);
+
+  assert.strictEqual(wb.imagePositions.length, 1);
+  const position = wb.imagePositions[0];
+  assert.strictEqual(position.sheet, 'People');
+  assert.strictEqual(position.image, image.name);
+  assert.deepStrictEqual(wb.imageCells(position), { firstRow: 2, firstCol: 6, lastRow: 4, lastCol: 7 });
+});
+
+test('从非对齐的 Uint8Array 视图读取', () => {
+  const buffer = readPacked(packedFixture(), { valuesOnly: true });
+  const expected = new PackedWorkbook(buffer);
+
+  // 偏移 3 字节：单元格偏移表不再 4 字节对齐，需要复制
+  const shifted = new Uint8Array(buffer.byteLength + 3);
+  shifted.set(new Uint8Array(buffer), 3);
+  const wb = new PackedWorkbook(shifted.subarray(3));
+
+  for (const name of expected.sheetNames()) {
+    const a = expected.sheet(name);
+    const b = wb.sheet(name);
+    assert.strictEqual(b.rowCount, a.rowCount);
+    for (let r = 0; r < a.rowCount; r++) assert.deepStrictEqual(b.row(r), a.row(r));
+  }
+  assert.ok(wb.images[0].data.equals(LOGO));
+});
+
+test('过滤后的行号与列类型推断', () => {
+  const wb = new PackedWorkbook(readPacked(packedFixture(), {
+    valuesOnly: true,
+    schemaRows: 10,
+    filter: [{ column: 'city', eq: 'Shenzhen' }]
+  }));
+  const sheet = wb.sheet('People');
+
+  // 表头始终保留
+  const expectedRows = [0];
+  for (let i = 0; i < 30; i++) if (personText(i)[2] === 'Shenzhen') expectedRows.push(i + 1);
+  assert.deepStrictEqual(sheet.rowIndex, expectedRows);
+  assert.strictEqual(sheet.rowCount, expectedRows.length);
+  for (let r = 1; r < sheet.rowCount; r++) {
+    assert.strictEqual(sheet.originalRow(r), expectedRows[r]);
+    assert.deepStrictEqual(sheet.row(r).slice(0, 5), personText(expectedRows[r] - 1));
+  }
+
+  assert.strictEqual(sheet.schema.length, sheet.columnCount);
+  assert.deepStrictEqual(sheet.schema.slice(0, 5).map(column => column.type),
+    ['string', 'number', 'string', 'number', 'boolean']);
+
+  // 未过滤的 Sheet 没有 rowIndex
+  assert.strictEqual(wb.sheet('第二页').rowIndex, null);
+  assert.strictEqual(wb.sheet('第二页').originalRow(2), 2);
+});
+
+test('拒绝不是 readPacked 结果的数据', () => {
+  assert.throws(() => new PackedWorkbook(new ArrayBuffer(64)), /Not a packed Excel result/);
+
+  const buffer = readPacked(packedFixture(), { valuesOnly: true });
+  new DataView(buffer).setUint32(4, 2, true);
+  assert.throws(() => new PackedWorkbook(buffer), /Not a packed Excel result/);
+});
+
+test('不存在的 Sheet', () => {
+  const wb = new PackedWorkbook(readPacked(packedFixture(), { valuesOnly: true }));
+  assert.throws(() => wb.sheet('missing'), /missing/);
+  assert.strictEqual(wb.sheet().name, 'People');
+});
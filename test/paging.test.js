@@ -0,0 +1,107 @@
+/**
+ * openWorkbook：按页读取大表
+ */
+
+const assert = require('assert');
+const fs = require('fs');
+const { test } = require('./harness');
+const { fixture, people, personText, PEOPLE_HEADER } = require('./fixtures');
+const { openWorkbook, readPacked, PackedWorkbook } = require('..');
+
+const COUNT = 500;
+
+const pagingFixture = () => fixture('paging', () => ({
+  sheets: [
+    { name: 'People', rows: people(COUNT) },
+    { name: 'Sparse', rows: [['a', null, 'c'], [null, null, null], [1, 2], [null, null, null, 'd']] }
+  ]
+}));
+
+function expectedRow(row, iso = false) {
+  return row === 0 ? PEOPLE_HEADER : personText(row - 1, iso);
+}
+
+function withWorkbook(input, options, fn) {
+  const wb = openWorkbook(input, options);
+  try {
+    return fn(wb);
+  } finally {
+    wb.close();
+  }
+}
+
+test('Sheet 名称与尺寸', () => {
+  withWorkbook(pagingFixture(), {}, wb => {
+    assert.deepStrictEqual(wb.sheetNames(), ['People', 'Sparse']);
+    assert.deepStrictEqual(wb.sheetSize('People'), { rows: COUNT + 1, columns: 5 });
+    assert.deepStrictEqual(wb.sheetSize(), { rows: COUNT + 1, columns: 5 });
+    assert.deepStrictEqual(wb.sheetSize('Sparse'), { rows: 4, columns: 4 });
+  });
+});
+
+test('逐页读取与整表相同', () => {
+  withWorkbook(pagingFixture(), {}, wb => {
+    const rows = [];
+    for (let start = 0; start < COUNT + 1; start += 64) {
+      rows.push(...wb.readRows('People', start, 64));
+    }
+    assert.strictEqual(rows.length, COUNT + 1);
+    rows.forEach((row, r) => assert.deepStrictEqual(row, expectedRow(r)));
+  });
+});
+
+test('任意顺序访问页', () => {
+  withWorkbook(pagingFixture(), {}, wb => {
+    for (const start of [400, 3, 499, 0, 250, 250, 1]) {
+      const page = wb.readRows('People', start, 2);
+      assert.deepStrictEqual(page, [expectedRow(start), expectedRow(start + 1)]);
+    }
+  });
+});
+
+test('超出末尾的范围', () => {
+  withWorkbook(pagingFixture(), {}, wb => {
+    const tail = wb.readRows('People', COUNT - 1, 10);
+    assert.deepStrictEqual(tail, [expectedRow(COUNT - 1), expectedRow(COUNT)]);
+    assert.deepStrictEqual(wb.readRows('People', COUNT + 1, 10), []);
+    assert.deepStrictEqual(wb.readRows('People', 10 ** 9, 10), []);
+    assert.deepStrictEqual(wb.readRows('People', 5, 0), []);
+    assert.throws(() => wb.readRows('People', -1, 10), RangeError);
+  });
+});
+
+test('按最宽的列补齐，与 valuesOnly 读取的行相同', () => {
+  const file = pagingFixture();
+  const packed = new PackedWorkbook(readPacked(file, { valuesOnly: true })).sheet('Sparse');
+  withWorkbook(file, {}, wb => {
+    const rows = wb.readRows('Sparse', 0, 10);
+    assert.deepStrictEqual(rows, [
+      ['a', '', 'c', ''],
+      ['', '', '', ''],
+      ['1', '2', '', ''],
+      ['', '', '', 'd']
+    ]);
+    rows.forEach((row, r) => assert.deepStrictEqual(row, packed.row(r)));
+  });
+});
+
+test('dates: iso', () => {
+  withWorkbook(pagingFixture(), { dates: 'iso' }, wb => {
+    assert.deepStrictEqual(wb.readRows(null, 100, 3), [expectedRow(100, true), expectedRow(101, true), expectedRow(102, true)]);
+  });
+});
+
+test('从 Buffer 打开，关闭后不能再读取', () => {
+  const wb = openWorkbook(fs.readFileSync(pagingFixture()));
+  assert.deepStrictEqual(wb.readRows('People', 7, 1), [expectedRow(7)]);
+  wb.close();
+  wb.close();
+  assert.throws(() => wb.readRows('People', 0, 1));
+});
+
+test('不存在的 Sheet', () => {
+  withWorkbook(pagingFixture(), {}, wb => {
+    assert.throws(() => wb.readRows('missing', 0, 1), /missing/);
+    assert.throws(() => wb.sheetSize('missing'), /missing/);
+  });
+});
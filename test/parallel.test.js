@@ -0,0 +1,59 @@
+/**
+ * 大 Sheet 按行切分并行解析（parseThreads）：结果与单线程解析相同
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, personObject } = require('./fixtures');
+const { readTableAsJSON, readPacked, PackedWorkbook, probe } = require('..');
+
+// Sheet XML 超过 4 MB 时才切分；5 万行约 6 MB（不写 r 属性时）到 9 MB
+const COUNT = 50000;
+const SPLIT_BYTES = 4 * 1024 * 1024;
+
+const bigFixture = () => fixture('parallel-big', () => ({ sheets: [{ name: 'People', rows: people(COUNT) }] }));
+
+// 行列号全部由位置决定：每段从相对行号开始，拼接时接上前一段的行号
+const noRefsFixture = () => fixture('parallel-norefs', () => ({
+  sheets: [{ name: 'People', rows: people(COUNT), omitRefs: true }]
+}));
+
+function expected(iso = false) {
+  return Array.from({ length: COUNT }, (_, i) => personObject(i, iso));
+}
+
+test('样本 Sheet 大到会被切分', () => {
+  for (const file of [bigFixture(), noRefsFixture()]) {
+    assert.ok(probe(file).sheets[0].uncompressedSize >= SPLIT_BYTES);
+  }
+});
+
+for (const [name, file] of [['带 r 属性', bigFixture], ['不带 r 属性', noRefsFixture]]) {
+  test(`多线程与单线程解析结果相同（${name}）`, () => {
+    const single = readTableAsJSON(file(), { valuesOnly: true, parseThreads: 1 });
+    assert.deepStrictEqual(single, expected());
+    for (const parseThreads of [2, 4, 7, 0]) {
+      assert.deepStrictEqual(readTableAsJSON(file(), { valuesOnly: true, parseThreads }), single, `parseThreads: ${parseThreads}`);
+    }
+  });
+
+  test(`多线程解析时日期转换、列类型推断与过滤不变（${name}）`, () => {
+    const options = { valuesOnly: true, dates: 'iso', schemaRows: 100 };
+    const rows = readTableAsJSON(file(), { ...options, parseThreads: 4 });
+    assert.deepStrictEqual(rows, expected(true));
+    assert.deepStrictEqual(rows.schema, readTableAsJSON(file(), { ...options, parseThreads: 1 }).schema);
+
+    const filter = [{ column: 'city', eq: 'Beijing' }, { column: 'age', min: 40 }];
+    assert.deepStrictEqual(
+      readTableAsJSON(file(), { valuesOnly: true, parseThreads: 4, filter }),
+      expected().filter(row => row.city === 'Beijing' && Number(row.age) >= 40));
+  });
+}
+
+test('readPacked 使用相同的切分', () => {
+  const packed = options => {
+    const sheet = new PackedWorkbook(readPacked(bigFixture(), options)).sheet();
+    return [sheet.rowCount, sheet.row(0), sheet.row(COUNT)];
+  };
+  assert.deepStrictEqual(packed({ valuesOnly: true, parseThreads: 4 }), packed({ valuesOnly: true, parseThreads: 1 }));
+});
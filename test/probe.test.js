@@ -0,0 +1,73 @@
+/**
+ * probe：dimension 跨度与字符引用解码
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, makePng } = require('./fixtures');
+const { probe, readTableAsJSON } = require('..');
+
+const probeFixture = () => fixture('probe', () => ({
+  sheets: [
+    // 数据从 C5 开始：跨度为 5 行 4 列，而不是 9 行 6 列
+    { name: 'Offset', rows: [[1, 2, 3, 4], [5, 6, 7, 8], [1, 2, 3, 4], [5, 6, 7, 8], [9, 9, 9, 9]], startRow: 5, startCol: 2, dimension: 'C5:F9' },
+    { name: 'Single', rows: [['x']], dimension: 'A1' },
+    { name: 'NoDimension', rows: [['x']] },
+    // 合法的字符引用解码，空的、无效的和超出范围的按原样保留
+    { name: 'ignored', nameXml: 'R&amp;D &#65;&#x42; &#; &#x; &#xZZ; &#1114112; &#0;', rows: [['x']], dimension: 'B2:A1' },
+    {
+      name: 'People',
+      rows: people(3),
+      dimension: 'A1:E4',
+      images: [{ png: makePng(4, 1), from: { col: 6, row: 0 }, to: { col: 7, row: 2 } }]
+    }
+  ]
+}));
+
+test('行列数为 dimension 的跨度', () => {
+  const info = probe(probeFixture());
+  const byName = Object.fromEntries(info.sheets.map(sheet => [sheet.name, sheet]));
+
+  assert.strictEqual(byName.Offset.dimension, 'C5:F9');
+  assert.strictEqual(byName.Offset.rowCount, 5);
+  assert.strictEqual(byName.Offset.columnCount, 4);
+
+  assert.strictEqual(byName.Single.rowCount, 1);
+  assert.strictEqual(byName.Single.columnCount, 1);
+
+  assert.strictEqual(byName.NoDimension.dimension, '');
+  assert.strictEqual(byName.NoDimension.rowCount, 0);
+  assert.strictEqual(byName.NoDimension.columnCount, 0);
+
+  assert.strictEqual(byName.People.rowCount, 4);
+  assert.strictEqual(byName.People.columnCount, 5);
+  assert.strictEqual(byName.People.imageCount, 1);
+});
+
+test('倒置的 dimension 视为未知', () => {
+  const sheet = probe(probeFixture()).sheets[3];
+  assert.strictEqual(sheet.rowCount, 0);
+  assert.strictEqual(sheet.columnCount, 0);
+});
+
+test('Sheet 名称中的字符引用', () => {
+  const sheet = probe(probeFixture()).sheets[3];
+  assert.strictEqual(sheet.name, 'R&D AB &#; &#x; &#xZZ; &#1114112; &#0;');
+});
+
+test('工作簿汇总', () => {
+  const info = probe(probeFixture());
+  assert.strictEqual(info.sheets.length, 5);
+  assert.strictEqual(info.imageCount, 1);
+  assert.strictEqual(info.cellImageCount, 0);
+  assert.ok(info.entryCount >= 5 + 6);
+  assert.ok(info.mediaSize > 0);
+  assert.ok(info.uncompressedSize >= info.sheets.reduce((sum, sheet) => sum + sheet.uncompressedSize, 0));
+});
+
+test('valuesOnly 读取共享字符串时保留无效的字符引用', () => {
+  const file = fixture('probe-entities', () => ({
+    sheets: [{ name: 'S', rows: [['text'], [{ xml: 'a &#; b &#x; c &#x41;&#66; &amp;' }]] }]
+  }));
+  assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly: true }), [{ text: 'a &#; b &#x; c AB &' }]);
+});
@@ -0,0 +1,138 @@
+/**
+ * 进程级读取调度器：并发与内存预算、排队计数、排队中的读取可取消
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people } = require('./fixtures');
+const { readTableAsJSON, readTableAsJSONAsync, configureReadScheduler, readSchedulerStats } = require('..');
+
+// 每个读取耗时足够长，同时发起的读取必然排队
+const mediumFixture = () => fixture('scheduler-medium', () => ({ sheets: [{ name: 'People', rows: people(20000) }] }));
+// 完整模式（xlnt）读取需要数秒，期间可以观察并操作排队中的读取
+const SLOW = 50000;
+const slowFixture = () => fixture('scheduler-slow', () => ({ sheets: [{ name: 'People', rows: people(SLOW) }] }));
+
+const sleep = ms => new Promise(resolve => setTimeout(resolve, ms));
+
+// 调度器是进程级的，每个用例结束后恢复为不限制
+async function withScheduler(options, fn) {
+  configureReadScheduler(options);
+  try {
+    await fn();
+  } finally {
+    configureReadScheduler({ maxConcurrent: 0, memoryBudget: 0 });
+  }
+}
+
+async function waitFor(predicate) {
+  for (let i = 0; i < 500 && !predicate(readSchedulerStats()); i++) {
+    await sleep(10);
+  }
+  assert.ok(predicate(readSchedulerStats()), JSON.stringify(readSchedulerStats()));
+}
+
+test('配置返回当前状态，省略的键保持原值', () => {
+  try {
+    let stats = configureReadScheduler({ maxConcurrent: 3, memoryBudget: 64 * 1024 * 1024 });
+    assert.strictEqual(stats.maxConcurrent, 3);
+    assert.strictEqual(stats.memoryBudget, 64 * 1024 * 1024);
+    for (const key of ['running', 'queued', 'reservedBytes', 'admitted', 'waited', 'totalWaitMs', 'maxWaitMs', 'peakQueued']) {
+      assert.strictEqual(typeof stats[key], 'number', key);
+    }
+
+    stats = configureReadScheduler({ maxConcurrent: 2 });
+    assert.strictEqual(stats.maxConcurrent, 2);
+    assert.strictEqual(stats.memoryBudget, 64 * 1024 * 1024);
+    assert.deepStrictEqual(readSchedulerStats(), configureReadScheduler({}));
+
+    stats = configureReadScheduler({ maxConcurrent: -1, memoryBudget: 0 });
+    assert.strictEqual(stats.maxConcurrent, 0);
+    assert.strictEqual(stats.memoryBudget, 0);
+  } finally {
+    configureReadScheduler({ maxConcurrent: 0, memoryBudget: 0 });
+  }
+  assert.throws(() => configureReadScheduler(null), TypeError);
+});
+
+test('同步读取计入 admitted，结束后释放预留', () => {
+  const before = readSchedulerStats();
+  readTableAsJSON(mediumFixture(), { valuesOnly: true });
+  const after = readSchedulerStats();
+  assert.strictEqual(after.admitted, before.admitted + 1);
+  assert.strictEqual(after.running, 0);
+  assert.strictEqual(after.reservedBytes, 0);
+});
+
+test('maxConcurrent 限制同时解析的读取，其余排队', async () => {
+  await withScheduler({ maxConcurrent: 1 }, async () => {
+    const before = readSchedulerStats();
+    let maxRunning = 0;
+    let done = false;
+    const reads = Promise.all(Array.from({ length: 6 }, () => readTableAsJSONAsync(mediumFixture(), { valuesOnly: true })))
+      .finally(() => { done = true; });
+    while (!done) {
+      maxRunning = Math.max(maxRunning, readSchedulerStats().running);
+      await sleep(1);
+    }
+
+    for (const rows of await reads) assert.strictEqual(rows.length, 20000);
+    const after = readSchedulerStats();
+    assert.ok(maxRunning <= 1, `running 达到 ${maxRunning}`);
+    assert.strictEqual(after.admitted, before.admitted + 6);
+    assert.ok(after.waited > before.waited, '同时发起的读取应有排队');
+    assert.ok(after.peakQueued >= 1);
+    assert.ok(after.maxWaitMs <= after.totalWaitMs);
+    assert.strictEqual(after.running, 0);
+    assert.strictEqual(after.queued, 0);
+    assert.strictEqual(after.reservedBytes, 0);
+  });
+});
+
+test('内存预算：预留不超过预算，单个超出预算的读取在空闲时运行', async () => {
+  // 每个读取的估算都大于 1 字节：只能一个一个运行，但不会永远排队
+  await withScheduler({ memoryBudget: 1 }, async () => {
+    let running = 0;
+    let done = false;
+    const reads = Promise.all([0, 1, 2].map(() => readTableAsJSONAsync(mediumFixture(), { valuesOnly: true })))
+      .finally(() => { done = true; });
+    while (!done) {
+      running = Math.max(running, readSchedulerStats().running);
+      await sleep(1);
+    }
+    assert.strictEqual((await reads).length, 3);
+    assert.ok(running <= 1, `running 达到 ${running}`);
+    assert.strictEqual(readSchedulerStats().reservedBytes, 0);
+  });
+});
+
+test('排队中的读取可以取消，不影响正在运行的读取', async () => {
+  await withScheduler({ maxConcurrent: 1 }, async () => {
+    const running = readTableAsJSONAsync(slowFixture());
+    await waitFor(stats => stats.running === 1);
+
+    const controller = new AbortController();
+    const queued = readTableAsJSONAsync(mediumFixture(), { valuesOnly: true, signal: controller.signal });
+    await waitFor(stats => stats.queued === 1);
+    controller.abort();
+    await assert.rejects(queued, err => err.name === 'AbortError');
+    assert.strictEqual(readSchedulerStats().queued, 0);
+
+    assert.strictEqual((await running).length, SLOW);
+    await waitFor(stats => stats.running === 0);
+  });
+});
+
+test('放宽预算后排队的读取立即开始', async () => {
+  await withScheduler({ maxConcurrent: 1 }, async () => {
+    const first = readTableAsJSONAsync(slowFixture());
+    await waitFor(stats => stats.running === 1);
+    const second = readTableAsJSONAsync(mediumFixture(), { valuesOnly: true });
+    await waitFor(stats => stats.queued === 1);
+
+    // 放宽时在调度器内直接放行，返回的状态中已没有排队
+    assert.strictEqual(configureReadScheduler({ maxConcurrent: 2 }).queued, 0);
+    assert.strictEqual((await second).length, 20000);
+    assert.strictEqual((await first).length, SLOW);
+  });
+});
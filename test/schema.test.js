@@ -0,0 +1,102 @@
+/**
+ * 列类型推断（schemaRows）：两种读取模式给出相同的 schema 和相同的文本
+ */
+
+const assert = require('assert');
+const { test } = require('./harness');
+const { fixture, people, personObject } = require('./fixtures');
+const { readTableAsJSON, readPacked, PackedWorkbook } = require('..');
+
+const COUNT = 50;
+const peopleFixture = () => fixture('schema-people', () => ({ sheets: [{ name: 'People', rows: people(COUNT) }] }));
+
+// 取样范围（前 5 行）之后出现不符合列类型的单元格，以及只在取样范围之后出现的列
+const driftFixture = () => fixture('schema-drift', () => ({
+  sheets: [{
+    name: 'Drift',
+    rows: [
+      ['id', 'amount', 'flag', 'mixed'],
+      [1, 10.5, true, 'a'],
+      [2, 11, false, 1],
+      [3, 12, true, 'b'],
+      [4, 13, false, 2],
+      [5, 14, true, 'c'],
+      [6, 'n/a', 'yes', 'd'],
+      [7, 16, 1, 3, 'late'],
+      ['eight', null, null, null]
+    ]
+  }]
+}));
+
+function types(schema) {
+  return schema.map(column => [column.key, column.type]);
+}
+
+for (const valuesOnly of [false, true]) {
+  const mode = `valuesOnly: ${valuesOnly}`;
+
+  test(`推断各列类型（${mode}）`, () => {
+    const rows = readTableAsJSON(peopleFixture(), { valuesOnly, schemaRows: 10 });
+    assert.deepStrictEqual(types(rows.schema), [
+      ['name', 'string'], ['age', 'number'], ['city', 'string'], ['joined', 'number'], ['active', 'boolean']
+    ]);
+    for (const column of rows.schema) {
+      assert.strictEqual(column.samples, 10);
+      assert.strictEqual(column.fallbacks, 0);
+    }
+    // schema 不可枚举，文本与不推断时相同
+    assert.ok(!Object.keys(rows).includes('schema'));
+    assert.deepStrictEqual(rows, readTableAsJSON(peopleFixture(), { valuesOnly }));
+  });
+
+  test(`dates: iso 时区分日期列（${mode}）`, () => {
+    const rows = readTableAsJSON(peopleFixture(), { valuesOnly, schemaRows: 10, dates: 'iso' });
+    assert.strictEqual(rows.schema[3].type, 'date');
+    assert.deepStrictEqual(rows[COUNT - 1], personObject(COUNT - 1, true));
+  });
+
+  test(`取样范围之后不符合类型的单元格回退到通用解码（${mode}）`, () => {
+    const rows = readTableAsJSON(driftFixture(), { valuesOnly, schemaRows: 5 });
+    assert.deepStrictEqual(rows.schema.map(column => [column.key, column.type, column.samples, column.fallbacks]), [
+      ['id', 'number', 5, 1],
+      ['amount', 'number', 5, 1],
+      ['flag', 'boolean', 5, 2],
+      ['mixed', 'mixed', 5, 0]
+    ]);
+    // 回退的单元格文本与不推断时相同
+    assert.deepStrictEqual(rows, readTableAsJSON(driftFixture(), { valuesOnly }));
+    assert.deepStrictEqual(rows[5], { id: '6', amount: 'n/a', flag: 'yes', mixed: 'd' });
+    assert.deepStrictEqual(rows[6], { id: '7', amount: '16', flag: '1', mixed: '3' });
+    assert.deepStrictEqual(rows[7], { id: 'eight', amount: '', flag: '', mixed: '' });
+  });
+
+  test(`表头不在第一行时从表头下一行开始取样（${mode}）`, () => {
+    const rows = readTableAsJSON(driftFixture(), { valuesOnly, schemaRows: 3, headerRow: 1 });
+    // 表头为第 1 行的数据：1, 10.5, true, a；取样第 2-4 行
+    assert.deepStrictEqual(rows.schema.map(column => [column.type, column.samples]), [
+      ['number', 3], ['number', 3], ['boolean', 3], ['mixed', 3]
+    ]);
+    // 表头之上的第 0 行不计入回退
+    assert.deepStrictEqual(rows.schema.map(column => column.fallbacks), [1, 1, 2, 0]);
+  });
+}
+
+test('两种读取模式的 schema 相同，宽度为补齐后的列数', () => {
+  const results = [false, true].map(valuesOnly =>
+    new PackedWorkbook(readPacked(driftFixture(), { valuesOnly, schemaRows: 5 })).sheet('Drift'));
+  for (const sheet of results) {
+    // 第 7 行有第 5 列，所有行补齐到 5 列，schema 也有 5 项
+    assert.strictEqual(sheet.columnCount, 5);
+    assert.strictEqual(sheet.schema.length, 5);
+    assert.deepStrictEqual(sheet.schema[4], { type: 'empty', samples: 0, fallbacks: 0 });
+  }
+  assert.deepStrictEqual(results[0].schema, results[1].schema);
+  for (let r = 0; r < results[0].rowCount; r++) {
+    assert.deepStrictEqual(results[0].row(r), results[1].row(r));
+  }
+});
+
+test('没有 schemaRows 时不附加 schema', () => {
+  assert.strictEqual(readTableAsJSON(peopleFixture()).schema, undefined);
+  assert.strictEqual(new PackedWorkbook(readPacked(peopleFixture())).sheet().schema, null);
+});
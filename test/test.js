@@ -0,0 +1,65 @@
+/**
+ * 回归测试入口（npm test）
+ * 依次运行 test/ 下的 *.test.js，样本由 test/fixtures.js 在临时目录中生成，结束后删除。
+ *
+ * 用法：
+ *   node test/test.js              运行全部用例
+ *   node test/test.js cache paging 只运行文件名包含指定关键字的测试文件
+ *
+ * 需要已编译的扩展（npm run build）
+ */
+
+const fs = require('fs');
+const path = require('path');
+const harness = require('./harness');
+const { removeFixtures } = require('./fixtures');
+
+async function main() {
+  const filters = process.argv.slice(2);
+  const files = fs.readdirSync(__dirname)
+    .filter(file => file.endsWith('.test.js'))
+    .filter(file => filters.length === 0 || filters.some(filter => file.includes(filter)))
+    .sort();
+
+  for (const file of files) {
+    harness.setCurrentFile(file);
+    require(path.join(__dirname, file));
+  }
+
+  let passed = 0;
+  const failures = [];
+  let lastFile = null;
+
+  for (const testCase of harness.cases) {
+    if (testCase.file !== lastFile) {
+      lastFile = testCase.file;
+      console.log(`\n📄 ${testCase.file}`);
+    }
+    const start = process.hrtime.bigint();
+    try {
+      await testCase.fn();
+      const ms = Number(process.hrtime.bigint() - start) / 1e6;
+      console.log(`  ✓ ${testCase.name} (${ms.toFixed(0)}ms)`);
+      passed++;
+    } catch (err) {
+      console.log(`  ✗ ${testCase.name}`);
+      failures.push({ testCase, err });
+    }
+  }
+
+  removeFixtures();
+
+  for (const { testCase, err } of failures) {
+    console.log(`\n❌ ${testCase.file} › ${testCase.name}`);
+    console.log(err && err.stack ? err.stack : err);
+  }
+
+  console.log(`\n${failures.length === 0 ? '✅' : '❌'} 通过 ${passed} 个，失败 ${failures.length} 个`);
+  process.exitCode = failures.length === 0 ? 0 : 1;
+}
+
+main().catch(err => {
+  console.error(err);
+  removeFixtures();
+  process.exitCode = 1;
+});
@@ -0,0 +1,108 @@
+/**
+ * 流式写入（createWriter）：写出的文件可被读回，超出 Excel 限制的数据在写入时报错
+ */
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { test } = require('./harness');
+const { tempDir, makePng } = require('./fixtures');
+const { createWriter, readTableAsJSON, probe } = require('..');
+
+function outputPath(name) {
+  return path.join(tempDir('writer'), name);
+}
+
+test('写入的行可被两种模式读回', () => {
+  const file = outputPath('rows.xlsx');
+  const writer = createWriter(file);
+  writer.addSheet('数据');
+  writer.writeRow(['text', 'number', 'flag', 'note']);
+  writer.writeRow(['a & <b> "c"', 0.1, true, null]);
+  writer.writeRow(['中文', -1.5e-7, false, '']);
+  writer.writeRow(['重复', 123456789012, true, '重复']);
+  writer.addSheet('Second');
+  writer.writeRow(['k']);
+  writer.writeRow([42]);
+  writer.close();
+
+  for (const valuesOnly of [false, true]) {
+    assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly }), [
+      { text: 'a & <b> "c"', number: '0.1', flag: 'true', note: '' },
+      { text: '中文', number: '-1.5e-7', flag: 'false', note: '' },
+      { text: '重复', number: '123456789012', flag: 'true', note: '重复' }
+    ]);
+    assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly, sheetName: 'Second' }), [{ k: '42' }]);
+  }
+  assert.deepStrictEqual(probe(file).sheets.map(sheet => sheet.name), ['数据', 'Second']);
+});
+
+test('单元格图片与浮动图片', () => {
+  const file = outputPath('images.xlsx');
+  const photo = makePng(8, 11);
+  const logo = makePng(16, 12);
+  const writer = createWriter(file);
+  writer.writeRow(['name', 'photo']);
+  writer.writeRow(['a', photo]);
+  writer.writeRow(['b', { data: photo }]);
+  writer.addImage(logo, { col: 3, row: 0, toCol: 5, toRow: 2 });
+  writer.close();
+
+  const rows = readTableAsJSON(file);
+  assert.strictEqual(rows[0].photo.type, 'image/png');
+  assert.ok(rows[0].photo.data.equals(photo));
+  assert.ok(rows[1].photo.data.equals(photo));
+  assert.deepStrictEqual(rows.imagePositions.map(p => [p.from.row, p.from.col]), [[1, 1], [2, 1], [0, 3]]);
+  assert.deepStrictEqual(rows.imageCells(rows.imagePositions[2]), { firstRow: 0, firstCol: 3, lastRow: 1, lastCol: 4 });
+});
+
+test('非有限数字在写入时报错，该行不写入', () => {
+  const file = outputPath('finite.xlsx');
+  const writer = createWriter(file);
+  writer.writeRow(['n']);
+  assert.throws(() => writer.writeRow([NaN]), /^Error: Cell A2: NaN is not a finite number$/);
+  assert.throws(() => writer.writeRow([Infinity]), /Cell A2: Infinity is not a finite number/);
+  assert.throws(() => writer.writeRow(['x', -Infinity]), /Cell B2: -Infinity is not a finite number/);
+  writer.writeRow([1]);
+  writer.close();
+  assert.deepStrictEqual(readTableAsJSON(file, { valuesOnly: true }), [{ n: '1' }]);
+});
+
+test('列数与图片位置不能超出 Sheet 范围', () => {
+  const writer = createWriter(outputPath('columns.xlsx'));
+  assert.throws(() => writer.writeRow(new Array(16385).fill(1)), /Row has 16385 cells: Excel allows at most 16384 columns/);
+  writer.writeRow(new Array(16384).fill(1));
+  assert.throws(() => writer.addImage(makePng(4, 1), { col: 16384, row: 0 }), /Image anchor is outside the sheet/);
+  assert.throws(() => writer.addImage(makePng(4, 1), { col: 0, row: 1048576 }), /Image anchor is outside the sheet/);
+  writer.addImage(makePng(4, 1), { col: 16383, row: 1048575 });
+  writer.close();
+});
+
+test('行数不能超过 1048576', () => {
+  const file = outputPath('rows-limit.xlsx');
+  const writer = createWriter(file);
+  writer.addSheet('Full');
+  for (let i = 0; i < 1048576; i++) writer.writeRow([]);
+  assert.throws(() => writer.writeRow(['x']), /Sheet Full is full: Excel allows at most 1048576 rows/);
+
+  // 新的 Sheet 重新计数
+  writer.addSheet('Next');
+  writer.writeRow(['ok']);
+  writer.close();
+  assert.ok(fs.statSync(file).size > 0);
+});
+
+test('Sheet 名称不合法或重复时报错', () => {
+  const writer = createWriter(outputPath('names.xlsx'));
+  assert.throws(() => writer.addSheet('a/b'), /Invalid sheet name: a\/b/);
+  assert.throws(() => writer.addSheet('x'.repeat(32)), /Invalid sheet name/);
+  writer.addSheet('S');
+  assert.throws(() => writer.addSheet('S'), /Duplicate sheet name: S/);
+  writer.close();
+});
+
+test('不支持的图片格式报错', () => {
+  const writer = createWriter(outputPath('bad-image.xlsx'));
+  assert.throws(() => writer.writeRow(['a', Buffer.from('not an image')]), /Unsupported image format/);
+  writer.close();
+});